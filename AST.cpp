@@ -123,6 +123,7 @@ ACCEPT_METHOD_IMPL(ValofExpression)
 
 // Statements
 ACCEPT_METHOD_IMPL(ConditionalBranchStatement)
+ACCEPT_METHOD_IMPL(PrefetchStatement)
 ACCEPT_METHOD_IMPL(AssignmentStatement)
 ACCEPT_METHOD_IMPL(RoutineCallStatement)
 ACCEPT_METHOD_IMPL(IfStatement)
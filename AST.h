@@ -38,6 +38,7 @@ class Expression;
 class Statement;
 class LabelTargetStatement;
 class ConditionalBranchStatement;
+class PrefetchStatement;
 class CaseStatement;
 class DefaultStatement;
 class TableExpression;
@@ -64,7 +65,7 @@ public:
         AssignmentStmt, RoutineCallStmt, IfStmt, UnlessStmt, TestStmt, WhileStmt, UntilStmt,
         RepeatStmt, ForStmt, ForEachStmt, SwitchonStmt, GotoStmt, ReturnStmt, FinishStmt, BreakStmt,
         LoopStmt, EndcaseStmt, ResultisStmt, CompoundStmt, BlockStmt, StringStmt, FreeStmt,
-        CaseStmt, DefaultStmt, BrkStatement, LabelTargetStmt, ConditionalBranchStmt
+        CaseStmt, DefaultStmt, BrkStatement, LabelTargetStmt, ConditionalBranchStmt, PrefetchStmt
     };
 
     ASTNode(NodeType type) : type_(type) {}
@@ -1001,4 +1002,19 @@ public:
     ASTNodePtr clone() const override;
 };
 
+// Lowering-only hint: starts loading the memory at address_expr into the
+// cache ahead of a later read. It never faults, so the address may point
+// past the end of the data.
+class PrefetchStatement : public Statement {
+public:
+    ExprPtr address_expr;
+
+    PrefetchStatement(ExprPtr address)
+        : Statement(NodeType::PrefetchStmt), address_expr(std::move(address)) {}
+
+    void accept(ASTVisitor& visitor) override;
+    ASTNode::NodeType getType() const override { return ASTNode::NodeType::PrefetchStmt; }
+    ASTNodePtr clone() const override;
+};
+
 #endif // AST_H
@@ -58,6 +58,7 @@ class FreeStatement;
 class BrkStatement;
 class LabelTargetStatement;
 class ConditionalBranchStatement;
+class PrefetchStatement;
 
 
 // Base class for all AST visitors.
@@ -129,4 +130,5 @@ public:
     virtual void visit(BrkStatement& node) {}
     virtual void visit(LabelTargetStatement& node) {}
     virtual void visit(ConditionalBranchStatement& node) {}
+    virtual void visit(PrefetchStatement&) {}
 };
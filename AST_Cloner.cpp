@@ -213,6 +213,10 @@ ASTNodePtr ConditionalBranchStatement::clone() const {
     return std::make_unique<ConditionalBranchStatement>(condition, targetLabel, std::move(cond_expr_clone));
 }
 
+ASTNodePtr PrefetchStatement::clone() const {
+    return std::make_unique<PrefetchStatement>(clone_unique_ptr(address_expr));
+}
+
 ASTNodePtr DefaultStatement::clone() const { //
     return std::make_unique<DefaultStatement>(clone_unique_ptr(command)); //
 }
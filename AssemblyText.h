@@ -0,0 +1,50 @@
+#ifndef ASSEMBLY_TEXT_H
+#define ASSEMBLY_TEXT_H
+
+#include "InternedString.h"
+#include "Register.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+// Builds an instruction's assembly text in a stack buffer and interns it.
+// Text that is already pooled (the common case for a hot encoder) costs a
+// hash lookup and no heap allocation. Text that outgrows the buffer moves
+// to a std::string.
+class AssemblyText {
+public:
+    AssemblyText& operator<<(const char* text) { return append(text, std::strlen(text)); }
+    AssemblyText& operator<<(const std::string& text) { return append(text.data(), text.size()); }
+    AssemblyText& operator<<(Reg reg) { return *this << reg.name(); }
+    AssemblyText& operator<<(long long value) {
+        char digits[24];
+        int length = std::snprintf(digits, sizeof(digits), "%lld", value);
+        return append(digits, static_cast<size_t>(length));
+    }
+    AssemblyText& operator<<(int value) { return *this << static_cast<long long>(value); }
+
+    std::string_view view() const {
+        return overflow_.empty() ? std::string_view(buffer_, length_) : std::string_view(overflow_);
+    }
+    bool contains(const std::string& needle) const { return view().find(needle) != std::string_view::npos; }
+    InternedString intern() const { return InternedString(view()); }
+
+private:
+    AssemblyText& append(const char* text, size_t length) {
+        if (overflow_.empty() && length_ + length <= sizeof(buffer_)) {
+            std::memcpy(buffer_ + length_, text, length);
+            length_ += length;
+        } else {
+            if (overflow_.empty()) overflow_.assign(buffer_, length_);
+            overflow_.append(text, length);
+        }
+        return *this;
+    }
+
+    char buffer_[96];
+    size_t length_ = 0;
+    std::string overflow_;
+};
+
+#endif // ASSEMBLY_TEXT_H
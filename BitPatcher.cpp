@@ -42,6 +42,7 @@ void BitPatcher::patch(uint32_t value_to_patch, int start_bit, int num_bits) {
         throw std::out_of_range("BitPatcher::patch - start_bit + num_bits cannot exceed 32.");
     }
 
+#if defined(__aarch64__)
     // --- ARM64 Inline Assembly ---
     uint32_t temp_mask;
 
@@ -81,5 +82,11 @@ void BitPatcher::patch(uint32_t value_to_patch, int start_bit, int num_bits) {
           [num_bits] "r" (num_bits)
         : "w1", "w2", "cc" // Clobbered registers and condition codes.
     );
+#else
+    // Same operation for hosts that only build the encoder (benchmarks, tests).
+    uint32_t mask = (num_bits == 32) ? 0xFFFFFFFFu : ((1u << num_bits) - 1u);
+    mask <<= start_bit;
+    this->data = (this->data & ~mask) | ((value_to_patch << start_bit) & mask);
+#endif
 }
 
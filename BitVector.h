@@ -0,0 +1,104 @@
+#ifndef BIT_VECTOR_H
+#define BIT_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A growable set of small integers stored one bit per element.
+// Union, difference and comparison work a 64-bit word at a time, which is
+// what the data-flow passes need for their per-block sets.
+class BitVector {
+public:
+    BitVector() = default;
+    explicit BitVector(size_t size) : words_((size + 63) / 64, 0) {}
+
+    // Makes room for indices below size. Never shrinks.
+    void reserve_bits(size_t size) {
+        size_t words = (size + 63) / 64;
+        if (words > words_.size()) words_.resize(words, 0);
+    }
+
+    void set(size_t index) {
+        reserve_bits(index + 1);
+        words_[index / 64] |= uint64_t(1) << (index % 64);
+    }
+
+    void reset(size_t index) {
+        if (index / 64 < words_.size()) words_[index / 64] &= ~(uint64_t(1) << (index % 64));
+    }
+
+    bool test(size_t index) const {
+        return index / 64 < words_.size() && (words_[index / 64] >> (index % 64)) & 1;
+    }
+
+    void clear() {
+        for (uint64_t& word : words_) word = 0;
+    }
+
+    bool empty() const {
+        for (uint64_t word : words_) {
+            if (word) return false;
+        }
+        return true;
+    }
+
+    size_t count() const {
+        size_t total = 0;
+        for (uint64_t word : words_) total += static_cast<size_t>(__builtin_popcountll(word));
+        return total;
+    }
+
+    // this |= other. Returns true if any bit was added.
+    bool union_with(const BitVector& other) {
+        reserve_bits(other.words_.size() * 64);
+        uint64_t added = 0;
+        for (size_t i = 0; i < other.words_.size(); ++i) {
+            added |= other.words_[i] & ~words_[i];
+            words_[i] |= other.words_[i];
+        }
+        return added != 0;
+    }
+
+    // this = gen | (through & ~kill). Returns true if the result changed.
+    bool assign_transfer(const BitVector& gen, const BitVector& through, const BitVector& kill) {
+        size_t words = std::max(std::max(gen.words_.size(), through.words_.size()), words_.size());
+        reserve_bits(words * 64);
+        uint64_t changed = 0;
+        for (size_t i = 0; i < words; ++i) {
+            uint64_t value = gen.word(i) | (through.word(i) & ~kill.word(i));
+            changed |= value ^ words_[i];
+            words_[i] = value;
+        }
+        return changed != 0;
+    }
+
+    // Calls fn(index) for each set bit in increasing order.
+    template <typename Fn>
+    void for_each(Fn fn) const {
+        for (size_t i = 0; i < words_.size(); ++i) {
+            uint64_t word = words_[i];
+            while (word) {
+                fn(i * 64 + static_cast<size_t>(__builtin_ctzll(word)));
+                word &= word - 1;
+            }
+        }
+    }
+
+    friend bool operator==(const BitVector& a, const BitVector& b) {
+        size_t words = std::max(a.words_.size(), b.words_.size());
+        for (size_t i = 0; i < words; ++i) {
+            if (a.word(i) != b.word(i)) return false;
+        }
+        return true;
+    }
+    friend bool operator!=(const BitVector& a, const BitVector& b) { return !(a == b); }
+
+private:
+    uint64_t word(size_t i) const { return i < words_.size() ? words_[i] : 0; }
+
+    std::vector<uint64_t> words_;
+};
+
+#endif // BIT_VECTOR_H
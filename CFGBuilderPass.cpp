@@ -5,6 +5,7 @@
 #include <vector>
 #include <memory>
 #include "analysis/ASTAnalyzer.h"
+#include "runtime/ListDataTypes.h" // For LIST_FLAG_CONTIGUOUS, LIST_FOREACH_PREFETCH_ATOMS, ListAtom
 
 // Helper function to clone a unique_ptr, assuming it's available from AST_Cloner.cpp
 template <typename T>
@@ -796,16 +797,32 @@ void CFGBuilderPass::build_vector_foreach_cfg(ForEachStatement& node) {
 
 void CFGBuilderPass::build_list_foreach_cfg(ForEachStatement& node) {
     // --- Pre-header: Initialization ---
-    // 1. Create unique name for our iterator
-    std::string cursor_name = "_forEach_cursor_" + std::to_string(block_id_counter++);
-
-    // --- Register the cursor variable with ASTAnalyzer ---
+    // 1. Create unique names for the list, cursor, contiguity and run-left temporaries
+    std::string suffix = std::to_string(block_id_counter++);
+    std::string list_name = "_forEach_list_" + suffix;
+    std::string cursor_name = "_forEach_cursor_" + suffix;
+    std::string contig_name = "_forEach_contig_" + suffix;
+    std::string left_name = "_forEach_left_" + suffix;
+
+    // --- Register the temporaries with ASTAnalyzer ---
     auto& analyzer = ASTAnalyzer::getInstance();
+    VarType list_type = analyzer.infer_expression_type(node.collection_expression.get());
     auto& metrics = analyzer.get_function_metrics_mut().at(current_cfg->function_name);
+    metrics.variable_types[list_name] = list_type;
     metrics.variable_types[cursor_name] = VarType::POINTER_TO_LIST_NODE;
-    metrics.num_variables++;
+    metrics.variable_types[contig_name] = VarType::INTEGER;
+    metrics.variable_types[left_name] = VarType::INTEGER;
+    metrics.num_variables += 4;
+
+    // 2. Evaluate the collection once: LET _list = L
+    std::vector<ExprPtr> list_rhs;
+    list_rhs.push_back(clone_unique_ptr(node.collection_expression));
+    current_basic_block->add_statement(std::make_unique<LetDeclaration>(
+        std::vector<std::string>{list_name},
+        std::move(list_rhs)
+    ));
 
-    // 2. Initialize the cursor to the first node of the list: LET _cursor = *(&L + 16)
+    // 3. Initialize the cursor to the first node of the list: LET _cursor = *(_list + 16)
     std::vector<ExprPtr> cursor_rhs;
     // Correct: Initialize cursor to the first node (header->head) using indirection at offset 16.
     cursor_rhs.push_back(
@@ -813,7 +830,7 @@ void CFGBuilderPass::build_list_foreach_cfg(ForEachStatement& node) {
             UnaryOp::Operator::Indirection,
             std::make_unique<BinaryOp>(
                 BinaryOp::Operator::Add,
-                clone_unique_ptr(node.collection_expression),
+                std::make_unique<VariableAccess>(list_name),
                 std::make_unique<NumberLiteral>(static_cast<int64_t>(16))
             )
         )
@@ -824,8 +841,32 @@ void CFGBuilderPass::build_list_foreach_cfg(ForEachStatement& node) {
     );
     current_basic_block->add_statement(std::move(init_cursor_stmt));
 
+    // 4. Note whether the runtime has flagged the atoms as laid out in runs.
+    //    The flags word sits in the upper half of the header's first 8 bytes.
+    //    LET _contig = (*_list >> 32) & LIST_FLAG_CONTIGUOUS
+    std::vector<ExprPtr> contig_rhs;
+    contig_rhs.push_back(
+        std::make_unique<BinaryOp>(
+            BinaryOp::Operator::BitwiseAnd,
+            std::make_unique<BinaryOp>(
+                BinaryOp::Operator::RightShift,
+                std::make_unique<UnaryOp>(
+                    UnaryOp::Operator::Indirection,
+                    std::make_unique<VariableAccess>(list_name)
+                ),
+                std::make_unique<NumberLiteral>(static_cast<int64_t>(32))
+            ),
+            std::make_unique<NumberLiteral>(static_cast<int64_t>(LIST_FLAG_CONTIGUOUS))
+        )
+    );
+    current_basic_block->add_statement(std::make_unique<LetDeclaration>(
+        std::vector<std::string>{contig_name},
+        std::move(contig_rhs)
+    ));
+
     // --- Loop Header: Condition Check ---
     BasicBlock* header_block = create_new_basic_block("ForEachHeader_");
+    BasicBlock* run_start_block = create_new_basic_block("ForEachRunStart_");
     BasicBlock* body_block = create_new_basic_block("ForEachBody_");
     BasicBlock* exit_block = create_new_basic_block("ForEachExit_");
 
@@ -841,8 +882,34 @@ void CFGBuilderPass::build_list_foreach_cfg(ForEachStatement& node) {
     header_block->add_statement(std::move(condition_check));
 
     // Add the control flow edges from the header
-    current_cfg->add_edge(header_block, body_block);   // If condition fails (cursor is not 0), go to body.
-    current_cfg->add_edge(header_block, exit_block);   // If condition succeeds (cursor is 0), go to exit.
+    current_cfg->add_edge(header_block, run_start_block); // If condition fails (cursor is not 0), start a run.
+    current_cfg->add_edge(header_block, exit_block);      // If condition succeeds (cursor is 0), go to exit.
+
+    // --- Run Start: how many atoms follow the cursor at the next addresses ---
+    // A run's first atom records its length in the upper half of its first
+    // 8 bytes (ListAtom.pad). Without the flag the count is forced to 0 and
+    // every step follows 'next'.
+    // _left = (*_cursor >> 32) * _contig
+    std::vector<ExprPtr> left_lhs;
+    left_lhs.push_back(std::make_unique<VariableAccess>(left_name));
+    std::vector<ExprPtr> left_rhs;
+    left_rhs.push_back(std::make_unique<BinaryOp>(
+        BinaryOp::Operator::Multiply,
+        std::make_unique<BinaryOp>(
+            BinaryOp::Operator::RightShift,
+            std::make_unique<UnaryOp>(
+                UnaryOp::Operator::Indirection,
+                std::make_unique<VariableAccess>(cursor_name)
+            ),
+            std::make_unique<NumberLiteral>(static_cast<int64_t>(32))
+        ),
+        std::make_unique<VariableAccess>(contig_name)
+    ));
+    run_start_block->add_statement(std::make_unique<AssignmentStatement>(
+        std::move(left_lhs),
+        std::move(left_rhs)
+    ));
+    current_cfg->add_edge(run_start_block, body_block);
 
     // --- Loop Body: Assign Value and Execute User Code ---
     current_basic_block = body_block;
@@ -914,7 +981,65 @@ void CFGBuilderPass::build_list_foreach_cfg(ForEachStatement& node) {
     }
 
     // --- STEP 4: In the new block, advance the cursor and loop back ---
+    // Inside a run the cursor steps by sizeof(ListAtom) without loading
+    // 'next', so the next iteration's loads no longer wait on this one's,
+    // and the atoms a few iterations ahead are prefetched. At the end of a
+    // run (or on a list without the flag) the chase block follows 'next'.
     current_basic_block = advance_block;
+    BasicBlock* step_block = create_new_basic_block("ForEachStep_");
+    BasicBlock* chase_block = create_new_basic_block("ForEachChase_");
+
+    // IF _left = 0 GOTO chase_block
+    current_basic_block->add_statement(std::make_unique<ConditionalBranchStatement>(
+        "EQ",
+        chase_block->id,
+        std::make_unique<VariableAccess>(left_name)
+    ));
+    current_cfg->add_edge(current_basic_block, step_block);  // Still inside the run.
+    current_cfg->add_edge(current_basic_block, chase_block); // Run finished: follow the next pointer.
+
+    current_basic_block = step_block;
+
+    // _left = _left - 1
+    std::vector<ExprPtr> dec_lhs;
+    dec_lhs.push_back(std::make_unique<VariableAccess>(left_name));
+    std::vector<ExprPtr> dec_rhs;
+    dec_rhs.push_back(std::make_unique<BinaryOp>(
+        BinaryOp::Operator::Subtract,
+        std::make_unique<VariableAccess>(left_name),
+        std::make_unique<NumberLiteral>(static_cast<int64_t>(1))
+    ));
+    current_basic_block->add_statement(std::make_unique<AssignmentStatement>(
+        std::move(dec_lhs),
+        std::move(dec_rhs)
+    ));
+
+    // _cursor = _cursor + sizeof(ListAtom)
+    std::vector<ExprPtr> step_lhs;
+    step_lhs.push_back(std::make_unique<VariableAccess>(cursor_name));
+    std::vector<ExprPtr> step_rhs;
+    step_rhs.push_back(std::make_unique<BinaryOp>(
+        BinaryOp::Operator::Add,
+        std::make_unique<VariableAccess>(cursor_name),
+        std::make_unique<NumberLiteral>(static_cast<int64_t>(sizeof(ListAtom)))
+    ));
+    current_basic_block->add_statement(std::make_unique<AssignmentStatement>(
+        std::move(step_lhs),
+        std::move(step_rhs)
+    ));
+
+    // PREFETCH _cursor + LIST_FOREACH_PREFETCH_ATOMS * sizeof(ListAtom)
+    current_basic_block->add_statement(std::make_unique<PrefetchStatement>(
+        std::make_unique<BinaryOp>(
+            BinaryOp::Operator::Add,
+            std::make_unique<VariableAccess>(cursor_name),
+            std::make_unique<NumberLiteral>(static_cast<int64_t>(LIST_FOREACH_PREFETCH_ATOMS * sizeof(ListAtom)))
+        )
+    ));
+    current_cfg->add_edge(current_basic_block, body_block);
+
+    // _cursor = REST(_cursor)
+    current_basic_block = chase_block;
     std::vector<ExprPtr> lhs2;
     lhs2.push_back(std::make_unique<VariableAccess>(cursor_name));
     std::vector<ExprPtr> rhs2;
@@ -65,6 +65,7 @@ size_t CallFrameManager::get_size_for_type(VarType type) const {
         case VarType::POINTER_TO_LIST_NODE:
         case VarType::POINTER_TO_STRING:
         case VarType::POINTER_TO_TABLE:
+        case VarType::POINTER_TO_MAP:
         case VarType::POINTER_TO_FLOAT:
         case VarType::POINTER_TO_INT:
             return 8;
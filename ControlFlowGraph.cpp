@@ -65,6 +65,7 @@ std::string to_string(ASTNode::NodeType type) {
         case ASTNode::NodeType::SysCallExpr: return "SysCallExpr";
         case ASTNode::NodeType::LabelTargetStmt: return "LabelTargetStmt";
         case ASTNode::NodeType::ConditionalBranchStmt: return "ConditionalBranchStmt";
+        case ASTNode::NodeType::PrefetchStmt: return "PrefetchStmt";
         case ASTNode::NodeType::EndcaseStmt: return "EndcaseStmt";
         case ASTNode::NodeType::ResultisStmt: return "ResultisStmt";
         case ASTNode::NodeType::CompoundStmt: return "CompoundStmt";
@@ -111,17 +112,27 @@ std::vector<BasicBlock*> ControlFlowGraph::get_blocks_in_rpo() const {
     std::vector<BasicBlock*> post_order;
     std::unordered_set<BasicBlock*> visited;
 
-    // Recursive DFS helper
-    std::function<void(BasicBlock*)> dfs = [&](BasicBlock* block) {
-        if (!block || visited.count(block)) return;
-        visited.insert(block);
-        for (BasicBlock* succ : block->successors) {
-            dfs(succ);
+    // Iterative DFS; each stack entry is a block and the index of the next
+    // successor to visit, so deep CFGs cannot overflow the call stack.
+    std::vector<std::pair<BasicBlock*, size_t>> stack;
+    if (entry_block) {
+        stack.emplace_back(entry_block, 0);
+        visited.insert(entry_block);
+    }
+    while (!stack.empty()) {
+        BasicBlock* block = stack.back().first;
+        size_t& next = stack.back().second;
+        if (next < block->successors.size()) {
+            BasicBlock* succ = block->successors[next++];
+            if (succ && visited.insert(succ).second) {
+                stack.emplace_back(succ, 0);
+            }
+        } else {
+            post_order.push_back(block);
+            stack.pop_back();
         }
-        post_order.push_back(block);
-    };
+    }
 
-    dfs(entry_block);
     std::reverse(post_order.begin(), post_order.end());
     return post_order;
 }
@@ -26,6 +26,9 @@ public:
     // Retrieves a block by its ID
     BasicBlock* get_block(const std::string& id) const;
 
+    // Blocks reachable from the entry block, in reverse postorder
+    std::vector<BasicBlock*> get_blocks_in_rpo() const;
+
     // Debugging: Print the CFG structure
     void print_cfg() const;
 
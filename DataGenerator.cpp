@@ -11,6 +11,7 @@
 #include <iomanip>
 #include "AST.h"
 #include "runtime/ListDataTypes.h" // For ATOM_SENTINEL
+#include "runtime/runtime.h" // For the string length tags
 
 // --- Helper: Emit 64-bit absolute relocatable pointer as two instructions ---
 static void emit_absolute_pointer(InstructionStream& stream, const std::string& label, SegmentType segment) {
@@ -102,9 +103,11 @@ std::string DataGenerator::add_string_literal(const std::string& value) {
     std::string label = "L_str" + std::to_string(next_string_id_++);
     string_literal_map_[value] = label;
     std::u32string u32_value = utf8_to_utf32(value);
+    bool compact = compact_strings_ &&
+                   std::all_of(u32_value.begin(), u32_value.end(), [](char32_t ch) { return ch <= 0xFF; });
     u32_value.push_back(U'\0');
     u32_value.push_back(U'\0');
-    string_literals_.push_back({label, u32_value});
+    string_literals_.push_back({label, u32_value, compact});
     return label;
 }
 
@@ -236,9 +239,23 @@ void DataGenerator::generate_rodata_section(InstructionStream& stream) {
     // Emit String Literals (no changes)
     for (const auto& info : string_literals_) {
         stream.add(Instruction::as_label(info.label, SegmentType::RODATA));
-        stream.add_data64(info.value.length() - 2, "", SegmentType::RODATA);
-        for (char32_t ch : info.value) {
-            stream.add_data32(static_cast<uint32_t>(ch), "", SegmentType::RODATA);
+        if (info.compact) {
+            // Latin-1 bytes and a zero terminator, packed little-endian
+            // into words.
+            size_t length = info.value.length() - 2;
+            stream.add_data64(length | BCPL_STRING_COMPACT, "", SegmentType::RODATA);
+            for (size_t i = 0; i <= length; i += 4) {
+                uint32_t word = 0;
+                for (size_t j = 0; j < 4 && i + j < length; ++j) {
+                    word |= static_cast<uint32_t>(info.value[i + j]) << (8 * j);
+                }
+                stream.add_data32(word, "", SegmentType::RODATA);
+            }
+        } else {
+            stream.add_data64((info.value.length() - 2) | BCPL_STRING_TRUSTED, "", SegmentType::RODATA);
+            for (char32_t ch : info.value) {
+                stream.add_data32(static_cast<uint32_t>(ch), "", SegmentType::RODATA);
+            }
         }
         stream.add_data_padding(8);
     }
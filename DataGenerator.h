@@ -29,6 +29,7 @@ public:
     struct StringLiteralInfo {
         std::string label;
         std::u32string value;
+        bool compact = false; // Emitted as Latin-1 bytes (--compact-strings)
     };
 
     struct FloatLiteralInfo {
@@ -66,6 +67,10 @@ public:
 
     void set_symbol_table(SymbolTable* table) { symbol_table_ = table; }
 
+    // Emit string literals whose code points all fit in one byte as compact
+    // Latin-1 strings, flagged in their length word.
+    void set_compact_strings(bool enabled) { compact_strings_ = enabled; }
+
     // --- Public Methods for Adding Data ---
 
     std::string add_string_literal(const std::string& value);
@@ -98,6 +103,7 @@ public:
 private:
     SymbolTable* symbol_table_ = nullptr;
     bool enable_tracing_;
+    bool compact_strings_ = false;
 
     // --- Member Variables for Storing Literals ---
 
@@ -26,6 +26,7 @@ enum class VarType : int64_t {
     VEC          = 1 << 8,  // 256
     LIST         = 1 << 9,  // 512
     TABLE        = 1 << 10, // 1024
+    MAP          = 1 << 11, // 2048
 
     // Type Modifiers
     POINTER_TO   = 1 << 12, // 4096
@@ -48,7 +49,8 @@ enum class VarType : int64_t {
     POINTER_TO_TABLE        = POINTER_TO | TABLE,
     POINTER_TO_FLOAT        = POINTER_TO | FLOAT,
     POINTER_TO_INT          = POINTER_TO | INTEGER,
-    POINTER_TO_LIST_NODE    = POINTER_TO | LIST
+    POINTER_TO_LIST_NODE    = POINTER_TO | LIST,
+    POINTER_TO_MAP          = POINTER_TO | MAP
 };
 
 // Helper function to check for const list types
@@ -73,6 +75,7 @@ inline std::string vartype_to_string(VarType t) {
     if (v & static_cast<int64_t>(VarType::LIST)) result += "LIST|";
     if (v & static_cast<int64_t>(VarType::VEC)) result += "VEC|";
     if (v & static_cast<int64_t>(VarType::TABLE)) result += "TABLE|";
+    if (v & static_cast<int64_t>(VarType::MAP)) result += "MAP|";
     if (v & static_cast<int64_t>(VarType::INTEGER)) result += "INTEGER|";
     if (v & static_cast<int64_t>(VarType::FLOAT)) result += "FLOAT|";
     if (v & static_cast<int64_t>(VarType::STRING)) result += "STRING|";
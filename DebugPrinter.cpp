@@ -79,6 +79,11 @@ void DebugPrinter::visit(ConditionalBranchStatement& node) {
     std::cout << "ConditionalBranchStatement: condition=" << node.condition << ", targetLabel=" << node.targetLabel << std::endl;
 }
 
+void DebugPrinter::visit(PrefetchStatement& node) {
+    print_line("PrefetchStatement:");
+    print_child(node.address_expr);
+}
+
 void DebugPrinter::visit(FreeStatement& node) {
     print_line("FreeStatement:");
     print_child(node.list_expr);
@@ -79,6 +79,7 @@ public:
     void visit(StringStatement& node) override;
     void visit(LabelTargetStatement& node) override;
     void visit(ConditionalBranchStatement& node) override;
+    void visit(PrefetchStatement& node) override;
     void visit(GlobalVariableDeclaration& node) override;
 
 private:
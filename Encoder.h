@@ -23,6 +23,9 @@ enum class JITAttribute {
 #include <string>
 #include <vector>
 #include "OpType.h" // Correctly include the top-level header
+#include "InternedString.h"
+#include "Register.h"
+#include <type_traits>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -58,9 +61,12 @@ enum class RelocationType {
 // Represents a single encoded instruction along with its metadata
 enum class SegmentType { CODE, RODATA, DATA };
 
+// Instruction is a fixed-size record: its text and symbol fields are
+// InternedString handles, so the many copies made by InstructionStream,
+// the peephole optimizer, the Linker and CodeBuffer are plain memcpys.
 struct Instruction {
   uint32_t encoding = 0;
-  std::string assembly_text;
+  InternedString assembly_text;
   size_t address = 0;
   RelocationType relocation = RelocationType::NONE;
 
@@ -82,17 +88,17 @@ struct Instruction {
       instr.encoding = 0; // The Linker will patch this with the final address.
       return instr;
   }
-  std::string target_label;
+  InternedString target_label;
   bool is_data_value = false;
   bool is_label_definition = false;
   bool relocation_applied = false;
-  std::string resolved_symbol_name;
+  InternedString resolved_symbol_name;
   size_t resolved_target_address = 0;
   SegmentType segment = SegmentType::CODE; // Default to CODE
 
   // --- For peephole branch and label patterns ---
-  std::string branch_target;
-  std::string label;
+  InternedString branch_target;
+  InternedString label;
 
   // --- NEW SEMANTIC FIELDS ---
   InstructionDecoder::OpType opcode = InstructionDecoder::OpType::UNKNOWN; // Now fully defined
@@ -114,17 +120,17 @@ JITAttribute jit_attribute = JITAttribute::None;
 
   Instruction() = default;
 
-  Instruction(uint32_t enc, std::string text) {
+  Instruction(uint32_t enc, const std::string& text) {
     encoding = enc;
-    assembly_text = std::move(text);
+    assembly_text = text;
     jit_attribute = JITAttribute::None;
   }
 
-  Instruction(uint32_t enc, std::string text, RelocationType rel,
+  Instruction(uint32_t enc, const std::string& text, RelocationType rel,
               const std::string &target, bool is_data,
               bool reloc_applied = false) {
     encoding = enc;
-    assembly_text = std::move(text);
+    assembly_text = text;
     relocation = rel;
     target_label = target;
     is_data_value = is_data;
@@ -134,9 +140,14 @@ JITAttribute jit_attribute = JITAttribute::None;
 
 };
 
+static_assert(std::is_trivially_copyable<Instruction>::value,
+              "Instruction must stay a plain record; use InternedString for text fields");
+
 
 class Encoder {
 public:
+  // The hot encoders also take typed Reg operands. Their std::string
+  // overloads parse the names once and forward to the typed versions.
  
     
 
@@ -250,6 +261,8 @@ public:
   static Instruction create_str_imm(const std::string &xt,
                                     const std::string &xn, int immediate,
                                     const std::string &variable_name = "");
+  static Instruction create_str_imm(Reg xt, Reg xn, int immediate,
+                                    const std::string &variable_name = "");
 
   /**
    * @brief Creates an LDR (Load Register) instruction. Loads one 64-bit
@@ -258,6 +271,17 @@ public:
   static Instruction create_ldr_imm(const std::string &xt,
                                     const std::string &xn, int immediate,
                                     const std::string &variable_name = "");
+  static Instruction create_ldr_imm(Reg xt, Reg xn, int immediate,
+                                    const std::string &variable_name = "");
+
+  /**
+   * @brief Creates a PRFM PLDL1KEEP (prefetch for load) hint.
+   * @param xn The base address register.
+   * @param immediate An unsigned byte offset, a multiple of 8 in [0, 32760].
+   * @return A complete Instruction object.
+   */
+  static Instruction create_prfm_imm(const std::string &xn, int immediate);
+  static Instruction create_prfm_imm(Reg xn, int immediate);
 
   /**
    * @brief Creates an LDRB (Load Register Byte) instruction. Loads one byte
@@ -300,6 +324,15 @@ public:
    */
   static Instruction create_str_word_imm(const std::string& wt, const std::string& xn, int immediate);
 
+  /**
+   * @brief Creates an STRB (Store Register Byte) instruction. Stores the low byte of a W register.
+   * @param wt The source register (must be W register).
+   * @param xn The base address register (must be X register or SP).
+   * @param immediate An unsigned 12-bit immediate byte offset [0, 4095].
+   * @return A complete Instruction object.
+   */
+  static Instruction create_strb_imm(const std::string& wt, const std::string& xn, int immediate);
+
 
   /**
    * @brief Creates an LDP (Load Pair) instruction with post-increment
@@ -342,6 +375,7 @@ public:
   static Instruction create_add_reg(const std::string &xd,
                                     const std::string &xn,
                                     const std::string &xm);
+  static Instruction create_add_reg(Reg xd, Reg xn, Reg xm);
 
   /**
    * @brief Creates a SUB instruction with a register operand. (Xd = Xn - Xm)
@@ -353,6 +387,7 @@ public:
   static Instruction create_sub_reg(const std::string &xd,
                                     const std::string &xn,
                                     const std::string &xm);
+  static Instruction create_sub_reg(Reg xd, Reg xn, Reg xm);
 
   /**
    * @brief Creates a MUL instruction. (Xd = Xn * Xm)
@@ -364,6 +399,7 @@ public:
   static Instruction create_mul_reg(const std::string &xd,
                                     const std::string &xn,
                                     const std::string &xm);
+  static Instruction create_mul_reg(Reg xd, Reg xn, Reg xm);
 
   /**
    * @brief Creates an ADD instruction with an immediate operand. (Xd = Xn +
@@ -383,12 +419,14 @@ public:
    */
   static Instruction create_add_imm(const std::string &xd,
                                     const std::string &xn, int immediate);
+  static Instruction create_add_imm(Reg xd, Reg xn, int immediate);
 
   /**
    * @return A complete Instruction object.
    */
   static Instruction create_sub_imm(const std::string &xd,
                                     const std::string &xn, int immediate);
+  static Instruction create_sub_imm(Reg xd, Reg xn, int immediate);
 
   /**
    * @brief Creates an AND instruction with a register operand. (Xd = Xn & Xm)
@@ -433,6 +471,7 @@ public:
    */
   static Instruction create_mov_reg(const std::string &xd,
                                     const std::string &xs);
+  static Instruction create_mov_reg(Reg xd, Reg xs);
 
   // FMOV for D registers (float argument passing)
   static Instruction create_fmov_reg(const std::string &dd,
@@ -473,6 +512,7 @@ public:
                                      int shift = 0,
                                      RelocationType rel = RelocationType::NONE,
                                      const std::string &target = "");
+  static Instruction create_movz_imm(Reg xd, uint16_t immediate, int shift = 0);
 
   /**
    * @brief Creates a MOVK instruction to move a 16-bit immediate into a
@@ -513,6 +553,7 @@ public:
    */
   static Instruction create_cmp_reg(const std::string &xn,
                                     const std::string &xm);
+  static Instruction create_cmp_reg(Reg xn, Reg xm);
 
   // FSQRT (Floating-point Square Root) instruction for D registers
   static Instruction create_fsqrt_reg(const std::string& dd, const std::string& dn);
@@ -572,6 +613,7 @@ public:
    * @return A complete Instruction object.
    */
   static Instruction create_cmp_imm(const std::string &xn, int immediate);
+  static Instruction create_cmp_imm(Reg xn, int immediate);
 
   /**
    * @brief Creates an LSL (Logical Shift Left) instruction. (Xd = Xn << Xm)
@@ -594,6 +636,7 @@ public:
    */
   static Instruction create_lsl_imm(const std::string &xd,
                                     const std::string &xn, int shift_amount);
+  static Instruction create_lsl_imm(Reg xd, Reg xn, int shift_amount);
 
   /**
    * @brief Creates an LSR (Logical Shift Right) instruction. (Xd = Xn >> Xm)
@@ -954,6 +997,10 @@ private:
 
   // Helper function to get the integer encoding of a register name
   static uint32_t get_reg_encoding(const std::string &reg);
+  // Parses a register name for the string overloads; throws if it is not one.
+  static Reg parse_register(const std::string &reg);
+  // Throws unless reg is a general-purpose (W, X, WSP or SP) register.
+  static void check_general(Reg reg, const char *mnemonic);
   static uint32_t get_cond_encoding(const std::string &cond);
 };
 
@@ -21,7 +21,14 @@ HeapManager::HeapManager()
       totalStringsAllocated(0),
       totalVectorsFreed(0),
       totalStringsFreed(0),
-      heapIndex(0), traceEnabled(false) {}
+      totalStringsResized(0),
+      arenaTop(nullptr),
+      arenaRegionsPushed(0),
+      arenaBlocksAllocated(0),
+      arenaBytesAllocated(0),
+      arenaBytesReserved(0),
+      arenaPeakBytesReserved(0),
+      traceEnabled(false) {}
 
 // Private trace log helper
 void HeapManager::traceLog(const char* format, ...) {
@@ -17,7 +17,21 @@ private:
     size_t totalStringsAllocated;
     size_t totalVectorsFreed;
     size_t totalStringsFreed;
-    size_t heapIndex; // Current index for allocation tracking
+    size_t totalStringsResized;
+
+    // Region (arena) allocation state. While a region is pushed, VEC and
+    // STRING blocks are bump-allocated from its chunks and are released
+    // together when the region is popped. Region blocks are not tracked:
+    // freeing one individually is a no-op, and resizing one moves it to a
+    // tracked heap block outside every region, which the caller must free.
+    struct ArenaChunk;
+    struct ArenaRegion;
+    ArenaRegion* arenaTop;          // Innermost active region, or nullptr
+    size_t arenaRegionsPushed;
+    size_t arenaBlocksAllocated;
+    size_t arenaBytesAllocated;
+    size_t arenaBytesReserved;      // Chunk bytes currently held by regions
+    size_t arenaPeakBytesReserved;
 
     // Trace flag
     bool traceEnabled; // Controls whether trace messages are printed
@@ -33,20 +47,39 @@ private:
     // Static instance for singleton
     static HeapManager* instance;
 
+    // Region helpers
+    void* arenaAlloc(size_t totalSize);
+    bool arenaOwns(const void* address) const;
+    void* arenaRelocate(const void* address, size_t oldTotalSize, size_t newTotalSize, AllocType type);
+
 public:
     // Singleton access
     static HeapManager& getInstance();
 
     // Allocation functions
     void* allocVec(size_t numElements);
+    // Changes a vector's length to numElements, keeping its contents.
+    // The vector may move.
+    void* resizeVec(void* payload, size_t newNumElements);
 
     // Setter for traceEnabled
     void setTraceEnabled(bool enabled);
     void* allocString(size_t numChars);
+    // Changes a string's capacity to numChars characters, keeping its
+    // contents. The length prefix becomes numChars. The string may move.
+    void* resizeString(void* payload, size_t newNumChars);
+    // Allocates a Latin-1 string of numChars bytes; see BCPL_STRING_COMPACT.
+    void* allocCompactString(size_t numChars);
 
     // Deallocation function
     void free(void* payload);
 
+    // Region allocation: push opens a region, pop releases everything
+    // allocated since the matching push in one step.
+    void arenaPush();
+    void arenaPop();
+    bool arenaActive() const { return arenaTop != nullptr; }
+
     // Debugging and metrics
     void dumpHeap() const;
     void dumpHeapSignalSafe(); // Must be truly signal-safe
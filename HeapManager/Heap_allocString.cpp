@@ -1,27 +1,35 @@
 #include "HeapManager.h"
-#include "heap_manager_defs.h" // For AllocType, HeapBlock, MAX_HEAP_BLOCKS
+#include "heap_manager_defs.h" // For AllocType, HeapBlock, heap_table_insert
 #include "../SignalSafeUtils.h" // For safe_print
+#include "../runtime/runtime.h" // For the string length tags
 #include <cstdlib>
 #include <cstring>
 
 void* HeapManager::allocString(size_t numChars) {
     size_t totalSize = sizeof(uint64_t) + (numChars + 1) * sizeof(uint32_t);
-    void* ptr;
-    if (posix_memalign(&ptr, ALIGNMENT, totalSize) != 0) {
+    void* ptr = arenaTop ? arenaAlloc(totalSize) : heap_block_alloc(totalSize);
+    if (!ptr) {
         safe_print("Error: String allocation failed\n");
         return nullptr;
     }
 
     // Initialize string metadata
     uint64_t* str = static_cast<uint64_t*>(ptr);
-    str[0] = numChars; // Store length
+    str[0] = numChars | BCPL_STRING_TRUSTED; // Tagged length
     uint32_t* payload = reinterpret_cast<uint32_t*>(str + 1);
     payload[numChars] = 0; // Null terminator
 
+    // Region blocks are released by arenaPop and are not tracked individually
+    if (arenaTop) {
+        traceLog("Allocated arena string: Address=%p, Size=%zu\n", ptr, totalSize);
+        return static_cast<void*>(payload);
+    }
+
     // Track allocation
-    g_heap_blocks_array[heapIndex % MAX_HEAP_BLOCKS] = {ALLOC_STRING, ptr, totalSize, nullptr, nullptr};
-    heapIndex = (heapIndex + 1) % MAX_HEAP_BLOCKS; // Ensure circular buffer logic
-    g_heap_blocks_index = heapIndex; // Update global index as well for metrics tracking
+    if (!heap_table_insert(ALLOC_STRING, ptr, totalSize)) {
+        heap_block_release(ptr, totalSize);
+        return nullptr;
+    }
 
     // Trace log
     traceLog("Allocated string: Address=%p, Size=%zu, Characters=%zu\n", ptr, totalSize, numChars);
@@ -34,4 +42,36 @@ void* HeapManager::allocString(size_t numChars) {
     update_alloc_metrics(totalSize, ALLOC_STRING);
 
     return static_cast<void*>(payload); // Return pointer to the payload
-}
\ No newline at end of file
+}
+void* HeapManager::allocCompactString(size_t numChars) {
+    size_t totalSize = sizeof(uint64_t) + numChars + 1;
+    void* ptr = arenaTop ? arenaAlloc(totalSize) : heap_block_alloc(totalSize);
+    if (!ptr) {
+        safe_print("Error: Compact string allocation failed\n");
+        return nullptr;
+    }
+
+    // Length word carries the compact tag; characters are one byte each
+    uint64_t* str = static_cast<uint64_t*>(ptr);
+    str[0] = numChars | BCPL_STRING_COMPACT;
+    uint8_t* payload = reinterpret_cast<uint8_t*>(str + 1);
+    payload[numChars] = 0; // Null terminator
+
+    if (arenaTop) {
+        traceLog("Allocated arena compact string: Address=%p, Size=%zu\n", ptr, totalSize);
+        return static_cast<void*>(payload);
+    }
+
+    if (!heap_table_insert(ALLOC_STRING, ptr, totalSize)) {
+        heap_block_release(ptr, totalSize);
+        return nullptr;
+    }
+
+    traceLog("Allocated compact string: Address=%p, Size=%zu, Characters=%zu\n", ptr, totalSize, numChars);
+
+    totalBytesAllocated += totalSize;
+    totalStringsAllocated++;
+    update_alloc_metrics(totalSize, ALLOC_STRING);
+
+    return static_cast<void*>(payload);
+}
@@ -8,8 +8,8 @@
 
 void* HeapManager::allocVec(size_t numElements) {
     size_t totalSize = sizeof(uint64_t) + numElements * sizeof(uint64_t);
-    void* ptr;
-    if (posix_memalign(&ptr, ALIGNMENT, totalSize) != 0) {
+    void* ptr = arenaTop ? arenaAlloc(totalSize) : heap_block_alloc(totalSize);
+    if (!ptr) {
         safe_print("Error: Vector allocation failed\n");
         return nullptr;
     }
@@ -18,11 +18,17 @@ void* HeapManager::allocVec(size_t numElements) {
     uint64_t* vec = static_cast<uint64_t*>(ptr);
     vec[0] = numElements; // Store length
 
+    // Region blocks are released by arenaPop and are not tracked individually
+    if (arenaTop) {
+        traceLog("Allocated arena vector: Address=%p, Size=%zu\n", ptr, totalSize);
+        return static_cast<void*>(vec + 1);
+    }
+
     // Track allocation
-    g_heap_blocks_array[heapIndex % MAX_HEAP_BLOCKS] = {ALLOC_VEC, ptr, totalSize, nullptr, nullptr};
-    heapIndex = (heapIndex + 1) % MAX_HEAP_BLOCKS;
-    // Update global index as well for metrics tracking
-    g_heap_blocks_index = heapIndex;
+    if (!heap_table_insert(ALLOC_VEC, ptr, totalSize)) {
+        heap_block_release(ptr, totalSize);
+        return nullptr;
+    }
 
     // Trace log
     traceLog("Allocated vector: Address=%p, Size=%zu, Elements=%zu\n", ptr, totalSize, numElements);
@@ -0,0 +1,126 @@
+#include "HeapManager.h"
+#include "heap_manager_defs.h" // For ALIGNMENT, heap_block_alloc, heap_table_insert
+#include "../SignalSafeUtils.h" // For safe_print
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <algorithm> // For std::min
+
+#define ARENA_CHUNK_BYTES (64 * 1024) // Default chunk size for region allocation
+
+// Chunk header; the usable space follows it, rounded up to ALIGNMENT.
+struct HeapManager::ArenaChunk {
+    ArenaChunk* next;
+    size_t capacity; // Usable bytes after the header
+    size_t used;
+    size_t pad;      // Keeps the header a multiple of ALIGNMENT
+};
+
+struct HeapManager::ArenaRegion {
+    ArenaRegion* prev;
+    ArenaChunk* chunks; // Most recent chunk first
+};
+
+void HeapManager::arenaPush() {
+    ArenaRegion* region = static_cast<ArenaRegion*>(std::malloc(sizeof(ArenaRegion)));
+    if (!region) {
+        safe_print("Error: Arena region allocation failed\n");
+        return;
+    }
+    region->prev = arenaTop;
+    region->chunks = nullptr;
+    arenaTop = region;
+    arenaRegionsPushed++;
+    traceLog("Arena pushed: Region=%p\n", (void*)region);
+}
+
+void HeapManager::arenaPop() {
+    ArenaRegion* region = arenaTop;
+    if (!region) {
+        safe_print("Error: ARENA_POP without matching ARENA_PUSH\n");
+        return;
+    }
+
+    ArenaChunk* chunk = region->chunks;
+    while (chunk) {
+        ArenaChunk* next = chunk->next;
+        arenaBytesReserved -= sizeof(ArenaChunk) + chunk->capacity;
+        std::free(chunk);
+        chunk = next;
+    }
+
+    arenaTop = region->prev;
+    traceLog("Arena popped: Region=%p\n", (void*)region);
+    std::free(region);
+}
+
+void* HeapManager::arenaAlloc(size_t totalSize) {
+    static_assert(sizeof(ArenaChunk) % ALIGNMENT == 0, "Arena chunk header must preserve alignment");
+    size_t size = (totalSize + ALIGNMENT - 1) & ~static_cast<size_t>(ALIGNMENT - 1);
+    ArenaChunk* chunk = arenaTop->chunks;
+
+    if (!chunk || chunk->capacity - chunk->used < size) {
+        // Oversized requests get a dedicated chunk of exactly the right size.
+        size_t capacity = size > ARENA_CHUNK_BYTES ? size : ARENA_CHUNK_BYTES;
+        void* mem;
+        if (posix_memalign(&mem, ALIGNMENT, sizeof(ArenaChunk) + capacity) != 0) {
+            return nullptr;
+        }
+        chunk = static_cast<ArenaChunk*>(mem);
+        chunk->next = arenaTop->chunks;
+        chunk->capacity = capacity;
+        chunk->used = 0;
+        arenaTop->chunks = chunk;
+
+        arenaBytesReserved += sizeof(ArenaChunk) + capacity;
+        if (arenaBytesReserved > arenaPeakBytesReserved) {
+            arenaPeakBytesReserved = arenaBytesReserved;
+        }
+    }
+
+    void* ptr = reinterpret_cast<uint8_t*>(chunk + 1) + chunk->used;
+    chunk->used += size;
+    arenaBlocksAllocated++;
+    arenaBytesAllocated += totalSize;
+    return ptr;
+}
+
+bool HeapManager::arenaOwns(const void* address) const {
+    const uint8_t* p = static_cast<const uint8_t*>(address);
+    for (const ArenaRegion* region = arenaTop; region; region = region->prev) {
+        for (const ArenaChunk* chunk = region->chunks; chunk; chunk = chunk->next) {
+            const uint8_t* start = reinterpret_cast<const uint8_t*>(chunk + 1);
+            if (p >= start && p < start + chunk->used) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Region blocks cannot grow in place and are not tracked. Resizing one
+// copies it to a tracked heap block outside every region; the copy
+// survives arenaPop and is freed like any other block, while the original
+// stays in its region until the region is popped.
+void* HeapManager::arenaRelocate(const void* address, size_t oldTotalSize, size_t newTotalSize, AllocType type) {
+    void* ptr = heap_block_alloc(newTotalSize);
+    if (!ptr) {
+        return nullptr;
+    }
+    if (!heap_table_insert(type, ptr, newTotalSize)) {
+        heap_block_release(ptr, newTotalSize);
+        return nullptr;
+    }
+    std::memcpy(ptr, address, std::min(oldTotalSize, newTotalSize));
+
+    totalBytesAllocated += newTotalSize;
+    if (type == ALLOC_VEC) {
+        totalVectorsAllocated++;
+    } else if (type == ALLOC_STRING) {
+        totalStringsAllocated++;
+    }
+    update_alloc_metrics(newTotalSize, type);
+
+    traceLog("Moved arena block out of region: Address=%p -> %p, Size=%zu\n", address, ptr, newTotalSize);
+    return ptr;
+}
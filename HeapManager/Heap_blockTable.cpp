@@ -0,0 +1,113 @@
+#include "heap_manager_defs.h"
+#include "../SignalSafeUtils.h" // For safe_print
+#include <cstdlib>
+#include <cstdint>
+
+// Slots are located by multiplicative hashing of the block address and
+// linear probing. Blocks are ALIGNMENT-aligned, so the low bits carry no
+// information and are shifted out before hashing.
+static inline size_t slot_for(const void* address, size_t capacity) {
+    uint64_t key = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(address)) >> 4;
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 32) & (capacity - 1);
+}
+
+static HeapBlockTable* allocate_table(size_t capacity) {
+    size_t bytes = sizeof(HeapBlockTable) + (capacity - 1) * sizeof(HeapBlock);
+    HeapBlockTable* table = static_cast<HeapBlockTable*>(std::calloc(1, bytes));
+    if (!table) {
+        return nullptr;
+    }
+    table->capacity = capacity;
+    return table;
+}
+
+// Rebuilds the table with 'capacity' slots, dropping erased entries.
+// The new table is fully populated before it is published, so a signal
+// handler always sees either the old or the new table in a consistent state.
+static bool rehash(size_t capacity) {
+    HeapBlockTable* old_table = g_heap_table;
+    HeapBlockTable* new_table = allocate_table(capacity);
+    if (!new_table) {
+        safe_print("Error: Heap block table allocation failed\n");
+        return false;
+    }
+
+    if (old_table) {
+        for (size_t i = 0; i < old_table->capacity; ++i) {
+            const HeapBlock& block = old_table->slots[i];
+            if (!block.address) continue;
+            size_t slot = slot_for(block.address, capacity);
+            while (new_table->slots[slot].address) {
+                slot = (slot + 1) & (capacity - 1);
+            }
+            new_table->slots[slot] = block;
+            new_table->live++;
+        }
+    }
+
+    g_heap_table = new_table;
+    std::free(old_table);
+    return true;
+}
+
+HeapBlock* heap_table_insert(AllocType type, void* address, size_t size) {
+    HeapBlockTable* table = g_heap_table;
+    if (!table) {
+        if (!rehash(HEAP_TABLE_INITIAL_CAPACITY)) return nullptr;
+        table = g_heap_table;
+    } else if ((table->live + table->erased + 1) * 2 > table->capacity) {
+        // Keep the load factor (including erased slots) at or below one half.
+        // Grow only when live blocks alone justify it; otherwise just sweep
+        // out the erased slots at the current size.
+        size_t capacity = table->capacity;
+        if ((table->live + 1) * 4 > capacity) capacity *= 2;
+        if (!rehash(capacity)) return nullptr;
+        table = g_heap_table;
+    }
+
+    size_t mask = table->capacity - 1;
+    size_t slot = slot_for(address, table->capacity);
+    while (table->slots[slot].address) {
+        slot = (slot + 1) & mask;
+    }
+
+    HeapBlock& block = table->slots[slot];
+    if (block.type == ALLOC_FREE) {
+        table->erased--;
+    }
+    block = {type, address, size, nullptr, nullptr};
+    table->live++;
+    return &block;
+}
+
+HeapBlock* heap_table_find(const void* address) {
+    HeapBlockTable* table = g_heap_table;
+    if (!table || !address) return nullptr;
+
+    size_t mask = table->capacity - 1;
+    size_t slot = slot_for(address, table->capacity);
+    for (size_t probes = 0; probes < table->capacity; ++probes) {
+        HeapBlock& block = table->slots[slot];
+        if (block.address == address) {
+            return &block;
+        }
+        if (!block.address && block.type != ALLOC_FREE) {
+            return nullptr; // Empty slot terminates the probe chain
+        }
+        slot = (slot + 1) & mask;
+    }
+    return nullptr;
+}
+
+void heap_table_erase(HeapBlock* block) {
+    HeapBlockTable* table = g_heap_table;
+    if (!table || !block || !block->address) return;
+
+    block->type = ALLOC_FREE;
+    block->address = nullptr;
+    block->size = 0;
+    block->function_name = nullptr;
+    block->variable_name = nullptr;
+    table->live--;
+    table->erased++;
+}
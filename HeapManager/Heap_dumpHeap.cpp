@@ -1,13 +1,16 @@
 #include "HeapManager.h"
-#include "heap_manager_defs.h" // For AllocType, HeapBlock, MAX_HEAP_BLOCKS
+#include "heap_manager_defs.h" // For AllocType, HeapBlock, HeapBlockTable
 #include "../SignalSafeUtils.h" // For safe_print, u64_to_hex, int_to_dec
 #include <algorithm> // For std::min
 
 void HeapManager::dumpHeap() const {
+    const HeapBlockTable* table = g_heap_table;
+    const size_t capacity = table ? table->capacity : 0;
+
     safe_print("\n=== Debug: Heap Blocks ===\n");
     char addr_buf[20], size_buf[20], type_buf[20];
-    for (size_t i = 0; i < MAX_HEAP_BLOCKS; ++i) {
-        const auto& block = g_heap_blocks_array[i];
+    for (size_t i = 0; i < capacity; ++i) {
+        const auto& block = table->slots[i];
         if (block.type != ALLOC_FREE && block.address != nullptr) {
             safe_print("Block ");
             int_to_dec((int)i, type_buf);
@@ -28,9 +31,9 @@ void HeapManager::dumpHeap() const {
     safe_print("\n=== Heap Dump ===\n");
     char elem_buf[20];
     size_t count = 0;
-    for (size_t i = 0; i < MAX_HEAP_BLOCKS; ++i) {
-        const auto& block = g_heap_blocks_array[i];
-        if (block.type != ALLOC_FREE) {
+    for (size_t i = 0; i < capacity; ++i) {
+        const auto& block = table->slots[i];
+        if (block.address != nullptr) {
             safe_print("Block ");
             int_to_dec((int)i, type_buf);
             safe_print(type_buf);
@@ -3,6 +3,7 @@
 #include "../SignalSafeUtils.h"
 #include <algorithm>
 #include <cstdint>
+#include <cstring>  // For strncat, strlen
 #include <unistd.h> // For write()
 
 //
@@ -27,8 +28,12 @@ void HeapManager::dumpHeapSignalSafe() {
     char line_buf[256]; // A single, large buffer for formatting lines
     int active_blocks = 0;
 
-    for (size_t i = 0; i < MAX_HEAP_BLOCKS; ++i) {
-        const auto& block = g_heap_blocks_array[i];
+    // Read the table pointer once; capacity and slots travel together.
+    const HeapBlockTable* table = g_heap_table;
+    const size_t capacity = table ? table->capacity : 0;
+
+    for (size_t i = 0; i < capacity; ++i) {
+        const auto& block = table->slots[i];
 
         if (block.type != ALLOC_VEC && block.type != ALLOC_STRING) {
             continue;
@@ -1,5 +1,5 @@
 #include "HeapManager.h"
-#include "heap_manager_defs.h" // For AllocType, HeapBlock, MAX_HEAP_BLOCKS
+#include "heap_manager_defs.h" // For g_heap_table, slab class stats
 #include "../SignalSafeUtils.h" // For safe_print and int_to_dec
 
 void HeapManager::printMetrics() const {
@@ -23,5 +23,50 @@ void HeapManager::printMetrics() const {
     safe_print("\nTotal Strings Freed: ");
     int_to_dec((int64_t)totalStringsFreed, buf);
     safe_print(buf);
+    safe_print("\nTotal Strings Resized: ");
+    int_to_dec((int64_t)totalStringsResized, buf);
+    safe_print(buf);
+    safe_print("\nLive Blocks Tracked: ");
+    int_to_dec((int64_t)(g_heap_table ? g_heap_table->live : 0), buf);
+    safe_print(buf);
+    safe_print("\nBlock Table Capacity: ");
+    int_to_dec((int64_t)(g_heap_table ? g_heap_table->capacity : 0), buf);
+    safe_print(buf);
+    safe_print("\nSlab Bytes Reserved: ");
+    int_to_dec((int64_t)heap_slab_bytes_reserved(), buf);
+    safe_print(buf);
+    safe_print("\nLarge Allocations: ");
+    int_to_dec((int64_t)heap_large_alloc_count(), buf);
+    safe_print(buf);
+    safe_print("\nSlab Classes (block size: hits/misses):\n");
+    for (size_t cls = 0; cls < HEAP_SLAB_CLASS_COUNT; ++cls) {
+        size_t block_size, hits, misses;
+        heap_slab_class_stats(cls, &block_size, &hits, &misses);
+        safe_print("  ");
+        int_to_dec((int64_t)block_size, buf);
+        safe_print(buf);
+        safe_print(": ");
+        int_to_dec((int64_t)hits, buf);
+        safe_print(buf);
+        safe_print("/");
+        int_to_dec((int64_t)misses, buf);
+        safe_print(buf);
+        safe_print("\n");
+    }
+    safe_print("Arena Regions Pushed: ");
+    int_to_dec((int64_t)arenaRegionsPushed, buf);
+    safe_print(buf);
+    safe_print("\nArena Blocks Allocated: ");
+    int_to_dec((int64_t)arenaBlocksAllocated, buf);
+    safe_print(buf);
+    safe_print("\nArena Bytes Allocated: ");
+    int_to_dec((int64_t)arenaBytesAllocated, buf);
+    safe_print(buf);
+    safe_print("\nArena Bytes Reserved: ");
+    int_to_dec((int64_t)arenaBytesReserved, buf);
+    safe_print(buf);
+    safe_print("\nArena Peak Bytes Reserved: ");
+    int_to_dec((int64_t)arenaPeakBytesReserved, buf);
+    safe_print(buf);
     safe_print("\n");
 }
\ No newline at end of file
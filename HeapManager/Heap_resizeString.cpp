@@ -1,52 +1,66 @@
-#include <cstdlib>
-#include <stdexcept>
 #include <algorithm> // For std::min
+#include <cstring>
 #include "HeapManager.h" // Include HeapManager class definition
-#include "heap_manager_defs.h" // For AllocType, HeapBlock, MAX_HEAP_BLOCKS
+#include "heap_manager_defs.h" // For AllocType, HeapBlock, heap_table_find
 #include "../SignalSafeUtils.h" // For safe_print, u64_to_hex, int_to_dec
+#include "../runtime/runtime.h" // For the string length tags
 
-// Function is defined in SignalSafeUtils.h
-extern void safe_print(const char*); // Declaration of safe_print utility
+void* HeapManager::resizeString(void* payload, size_t newNumChars) {
+    if (!payload) return allocString(newNumChars);
 
-void* resizeString(void* payload, size_t newNumChars) {
-    if (!payload) {
-        safe_print("Error: Cannot resize a NULL string\n");
-        return nullptr;
-    }
-
-    for (auto& block : g_heap_blocks_array) {
-        if (block.address && static_cast<uint8_t*>(block.address) + sizeof(uint64_t) == payload) {
-            if (block.type != ALLOC_STRING) {
-                safe_print("Error: Attempt to resize a non-string block\n");
-                return nullptr;
-            }
-
-            // Calculate new size
-            size_t newTotalSize = sizeof(uint64_t) + (newNumChars + 1) * sizeof(uint32_t);
-
-            // Resize the memory block
-            void* newPtr = realloc(block.address, newTotalSize);
-            if (!newPtr) {
-                safe_print("Error: String resize failed\n");
-                return nullptr;
-            }
+    void* address = static_cast<uint8_t*>(payload) - sizeof(uint64_t);
+    size_t newTotalSize = sizeof(uint64_t) + (newNumChars + 1) * sizeof(uint32_t);
+    HeapBlock* block = heap_table_find(address);
+    void* newPtr;
+    if (block) {
+        if (block->type != ALLOC_STRING) {
+            safe_print("Error: Attempt to resize a non-string block\n");
+            return nullptr;
+        }
 
-            // Update metadata
-            block.address = newPtr;
-            block.size = newTotalSize;
+        // Resize the memory block
+        size_t oldTotalSize = block->size;
+        newPtr = heap_block_realloc(block->address, oldTotalSize, newTotalSize);
+        if (!newPtr) {
+            safe_print("Error: String resize failed\n");
+            return nullptr;
+        }
 
-            // Update the length field in the string
-            uint64_t* str = static_cast<uint64_t*>(newPtr);
-            str[0] = newNumChars;
+        // Re-key the tracking entry, since realloc may have moved the block
+        heap_table_erase(block);
+        if (!heap_table_insert(ALLOC_STRING, newPtr, newTotalSize)) {
+            safe_print("Error: Resized string could not be tracked\n");
+        }
 
-            // Ensure null terminator
-            uint32_t* payload = reinterpret_cast<uint32_t*>(str + 1);
-            payload[newNumChars] = 0;
+        traceLog("Resized string: Address=%p, Size=%zu -> %zu\n", newPtr, oldTotalSize, newTotalSize);
 
-            return static_cast<void*>(payload); // Return pointer to the payload
+        // A resize counts as freeing the old block and allocating the new one.
+        totalBytesAllocated += newTotalSize;
+        totalBytesFreed += oldTotalSize;
+        totalStringsResized++;
+        update_free_metrics(oldTotalSize);
+        update_alloc_metrics(newTotalSize, ALLOC_STRING);
+    } else if (arenaOwns(address)) {
+        // The length is the lower half of the word, below its tag.
+        size_t oldNumChars = static_cast<size_t>(*static_cast<uint64_t*>(address) & BCPL_STRING_LENGTH_MASK);
+        size_t oldTotalSize = sizeof(uint64_t) + (oldNumChars + 1) * sizeof(uint32_t);
+        newPtr = arenaRelocate(address, oldTotalSize, newTotalSize, ALLOC_STRING);
+        if (!newPtr) {
+            safe_print("Error: String resize failed\n");
+            return nullptr;
         }
+    } else {
+        safe_print("Error: String not found in heap tracking\n");
+        return nullptr;
     }
 
-    safe_print("Error: String not found in heap tracking\n");
-    return nullptr;
-}
\ No newline at end of file
+    // Update the length field in the string
+    uint64_t* str = static_cast<uint64_t*>(newPtr);
+    str[0] = newNumChars | BCPL_STRING_TRUSTED;
+
+    // Ensure null terminator
+    uint32_t* newPayload = reinterpret_cast<uint32_t*>(str + 1);
+    newPayload[newNumChars] = 0;
+
+    return static_cast<void*>(newPayload); // Return pointer to the payload
+}
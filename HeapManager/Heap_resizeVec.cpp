@@ -1,5 +1,5 @@
 #include "HeapManager.h"
-#include "heap_manager_defs.h" // For AllocType, HeapBlock, MAX_HEAP_BLOCKS
+#include "heap_manager_defs.h" // For AllocType, HeapBlock, heap_table_find
 #include "../SignalSafeUtils.h" // For safe_print, int_to_dec
 #include <cstdlib>
 #include <stdexcept>
@@ -7,41 +7,60 @@
 #include <cstdint>
 
 // Resize a vector
-void* resizeVec(void* payload, size_t newNumElements) {
+void* HeapManager::resizeVec(void* payload, size_t newNumElements) {
     if (!payload) {
         safe_print("Error: Cannot resize a NULL vector\n");
         return nullptr;
     }
 
-    for (auto& block : g_heap_blocks_array) {
-        if (block.address && static_cast<uint8_t*>(block.address) + sizeof(uint64_t) == payload) {
-            if (block.type != ALLOC_VEC) {
-                safe_print("Error: Attempt to resize a non-vector block\n");
-                return nullptr;
-            }
-
-            // Calculate new size
-            size_t newTotalSize = sizeof(uint64_t) + newNumElements * sizeof(uint64_t);
+    void* address = static_cast<uint8_t*>(payload) - sizeof(uint64_t);
+    size_t newTotalSize = sizeof(uint64_t) + newNumElements * sizeof(uint64_t);
+    HeapBlock* block = heap_table_find(address);
+    void* newPtr;
+    if (block) {
+        if (block->type != ALLOC_VEC) {
+            safe_print("Error: Attempt to resize a non-vector block\n");
+            return nullptr;
+        }
 
-            // Resize the memory block
-            void* newPtr = realloc(block.address, newTotalSize);
-            if (!newPtr) {
-                safe_print("Error: Vector resize failed\n");
-                return nullptr;
-            }
+        // Resize the memory block
+        size_t oldTotalSize = block->size;
+        newPtr = heap_block_realloc(block->address, oldTotalSize, newTotalSize);
+        if (!newPtr) {
+            safe_print("Error: Vector resize failed\n");
+            return nullptr;
+        }
 
-            // Update metadata
-            block.address = newPtr;
-            block.size = newTotalSize;
+        // Re-key the tracking entry, since realloc may have moved the block
+        heap_table_erase(block);
+        if (!heap_table_insert(ALLOC_VEC, newPtr, newTotalSize)) {
+            safe_print("Error: Resized vector could not be tracked\n");
+        }
 
-            // Update the length field in the vector
-            uint64_t* vec = static_cast<uint64_t*>(newPtr);
-            vec[0] = newNumElements;
+        traceLog("Resized vector: Address=%p, Size=%zu -> %zu\n", newPtr, oldTotalSize, newTotalSize);
 
-            return static_cast<void*>(vec + 1); // Return pointer to the payload
+        // A resize counts as freeing the old block and allocating the new
+        // one, so freeing the new block later balances the totals.
+        totalBytesAllocated += newTotalSize;
+        totalBytesFreed += oldTotalSize;
+        update_free_metrics(oldTotalSize);
+        update_alloc_metrics(newTotalSize, ALLOC_VEC);
+    } else if (arenaOwns(address)) {
+        size_t oldNumElements = static_cast<size_t>(*static_cast<uint64_t*>(address));
+        size_t oldTotalSize = sizeof(uint64_t) + oldNumElements * sizeof(uint64_t);
+        newPtr = arenaRelocate(address, oldTotalSize, newTotalSize, ALLOC_VEC);
+        if (!newPtr) {
+            safe_print("Error: Vector resize failed\n");
+            return nullptr;
         }
+    } else {
+        safe_print("Error: Vector not found in heap tracking\n");
+        return nullptr;
     }
 
-    safe_print("Error: Vector not found in heap tracking\n");
-    return nullptr;
+    // Update the length field in the vector
+    uint64_t* vec = static_cast<uint64_t*>(newPtr);
+    vec[0] = newNumElements;
+
+    return static_cast<void*>(vec + 1); // Return pointer to the payload
 }
@@ -0,0 +1,159 @@
+#include "heap_manager_defs.h"
+#include "../SignalSafeUtils.h" // For safe_print
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <algorithm> // For std::min
+
+// Block sizes (length word + payload) served from slabs. All are multiples
+// of ALIGNMENT, so every block carved from an aligned slab stays aligned.
+static const size_t kSlabClassSizes[HEAP_SLAB_CLASS_COUNT] = {
+    32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024
+};
+
+#define HEAP_SLAB_BYTES (64 * 1024) // Bytes carved per slab refill
+
+// A free block stores the link to the next free block in its first word.
+struct SlabFreeBlock {
+    SlabFreeBlock* next;
+};
+
+// Free lists handed back by threads that have exited. A thread adopts a
+// whole list from here before it carves a new slab.
+static std::mutex g_orphan_mutex;
+static SlabFreeBlock* g_orphan_lists[HEAP_SLAB_CLASS_COUNT] = {};
+
+// Each thread owns its free lists, so the hot path needs no locking.
+// Blocks freed on another thread simply join that thread's lists; slabs
+// are never returned to the system, so a block may move between threads.
+// When a thread exits its lists go to the orphan lists instead of leaking.
+struct SlabThreadCache {
+    SlabFreeBlock* lists[HEAP_SLAB_CLASS_COUNT] = {};
+
+    ~SlabThreadCache() {
+        std::lock_guard<std::mutex> lock(g_orphan_mutex);
+        for (int cls = 0; cls < HEAP_SLAB_CLASS_COUNT; ++cls) {
+            SlabFreeBlock* head = lists[cls];
+            if (!head) continue;
+            SlabFreeBlock* tail = head;
+            while (tail->next) tail = tail->next;
+            tail->next = g_orphan_lists[cls];
+            g_orphan_lists[cls] = head;
+            lists[cls] = nullptr;
+        }
+    }
+};
+
+static thread_local SlabThreadCache t_cache;
+
+// Counters are shared by all threads and only ever incremented.
+static std::atomic<size_t> g_slab_hits[HEAP_SLAB_CLASS_COUNT];
+static std::atomic<size_t> g_slab_misses[HEAP_SLAB_CLASS_COUNT];
+static std::atomic<size_t> g_slab_bytes_reserved(0);
+static std::atomic<size_t> g_large_allocs(0);
+
+static int slab_class_for(size_t size) {
+    if (size > kSlabClassSizes[HEAP_SLAB_CLASS_COUNT - 1]) return -1;
+    int cls = 0;
+    while (kSlabClassSizes[cls] < size) ++cls;
+    return cls;
+}
+
+// Adopts a list left by an exited thread, or carves a fresh slab into
+// blocks of the given class and threads them onto this thread's free list.
+// Slabs are retained for the life of the process.
+static bool refill_class(int cls) {
+    {
+        std::lock_guard<std::mutex> lock(g_orphan_mutex);
+        if (g_orphan_lists[cls]) {
+            t_cache.lists[cls] = g_orphan_lists[cls];
+            g_orphan_lists[cls] = nullptr;
+            return true;
+        }
+    }
+
+    void* slab;
+    if (posix_memalign(&slab, ALIGNMENT, HEAP_SLAB_BYTES) != 0) {
+        return false;
+    }
+    g_slab_bytes_reserved.fetch_add(HEAP_SLAB_BYTES, std::memory_order_relaxed);
+
+    size_t block_size = kSlabClassSizes[cls];
+    size_t count = HEAP_SLAB_BYTES / block_size;
+    uint8_t* base = static_cast<uint8_t*>(slab);
+    SlabFreeBlock* head = t_cache.lists[cls];
+    for (size_t i = count; i > 0; --i) {
+        SlabFreeBlock* block = reinterpret_cast<SlabFreeBlock*>(base + (i - 1) * block_size);
+        block->next = head;
+        head = block;
+    }
+    t_cache.lists[cls] = head;
+    return true;
+}
+
+void* heap_block_alloc(size_t size) {
+    int cls = slab_class_for(size);
+    if (cls < 0) {
+        void* ptr;
+        if (posix_memalign(&ptr, ALIGNMENT, size) != 0) {
+            return nullptr;
+        }
+        g_large_allocs.fetch_add(1, std::memory_order_relaxed);
+        return ptr;
+    }
+
+    if (t_cache.lists[cls]) {
+        g_slab_hits[cls].fetch_add(1, std::memory_order_relaxed);
+    } else {
+        g_slab_misses[cls].fetch_add(1, std::memory_order_relaxed);
+        if (!refill_class(cls)) return nullptr;
+    }
+
+    SlabFreeBlock* block = t_cache.lists[cls];
+    t_cache.lists[cls] = block->next;
+    return block;
+}
+
+void heap_block_release(void* address, size_t size) {
+    if (!address) return;
+    int cls = slab_class_for(size);
+    if (cls < 0) {
+        std::free(address);
+        return;
+    }
+    SlabFreeBlock* block = static_cast<SlabFreeBlock*>(address);
+    block->next = t_cache.lists[cls];
+    t_cache.lists[cls] = block;
+}
+
+void* heap_block_realloc(void* address, size_t old_size, size_t new_size) {
+    // Large-to-large resizes can stay in place.
+    if (slab_class_for(old_size) < 0 && slab_class_for(new_size) < 0) {
+        return realloc(address, new_size);
+    }
+    // Same class: the existing block already has room.
+    if (slab_class_for(old_size) == slab_class_for(new_size)) {
+        return address;
+    }
+
+    void* new_address = heap_block_alloc(new_size);
+    if (!new_address) return nullptr;
+    std::memcpy(new_address, address, std::min(old_size, new_size));
+    heap_block_release(address, old_size);
+    return new_address;
+}
+
+void heap_slab_class_stats(size_t cls, size_t* block_size, size_t* hits, size_t* misses) {
+    *block_size = kSlabClassSizes[cls];
+    *hits = g_slab_hits[cls].load(std::memory_order_relaxed);
+    *misses = g_slab_misses[cls].load(std::memory_order_relaxed);
+}
+
+size_t heap_slab_bytes_reserved(void) {
+    return g_slab_bytes_reserved.load(std::memory_order_relaxed);
+}
+
+size_t heap_large_alloc_count(void) {
+    return g_large_allocs.load(std::memory_order_relaxed);
+}
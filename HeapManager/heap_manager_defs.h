@@ -23,18 +23,50 @@ typedef struct {
     const char* variable_name; // Name of the variable being allocated
 } HeapBlock;
 
+// Open-addressed table of live heap blocks, keyed by block address.
+// Slots with a null address are either empty (ALLOC_UNKNOWN) or erased
+// (ALLOC_FREE); erased slots keep probe chains intact until the next rehash.
+// Capacity and slots live in one allocation so a signal handler can walk
+// the table through a single pointer read.
+typedef struct {
+    size_t capacity;           // Number of slots (always a power of two)
+    size_t live;               // Slots holding a live block
+    size_t erased;             // Slots marked ALLOC_FREE
+    HeapBlock slots[1];        // Actually 'capacity' entries
+} HeapBlockTable;
+
 // Constants for heap management
-#define MAX_HEAP_BLOCKS 128    // Maximum number of tracked heap blocks
+#define HEAP_TABLE_INITIAL_CAPACITY 1024 // Initial number of block table slots
 #define ALIGNMENT 16           // Memory alignment for allocations
+#define HEAP_SLAB_CLASS_COUNT 11 // Size classes served from slabs (32..1024 bytes)
 
 // External declarations for globals
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-// Global heap tracking array
-extern HeapBlock g_heap_blocks_array[MAX_HEAP_BLOCKS];
-extern size_t g_heap_blocks_index; // Rolling index for circular buffer
+// Global heap tracking table
+extern HeapBlockTable* g_heap_table;
+
+// Block table operations (O(1) expected). Addresses are block addresses,
+// i.e. the pointer returned by the system allocator, not the payload.
+HeapBlock* heap_table_insert(AllocType type, void* address, size_t size);
+HeapBlock* heap_table_find(const void* address);
+void heap_table_erase(HeapBlock* block);
+
+// Block storage. Blocks of up to 1 KB come from per-thread size-class
+// free lists backed by slabs; larger blocks go to the system allocator.
+// A thread's lists pass to the next thread that runs short when it exits.
+// 'size' must be the same total size the block was allocated with.
+void* heap_block_alloc(size_t size);
+void heap_block_release(void* address, size_t size);
+void* heap_block_realloc(void* address, size_t old_size, size_t new_size);
+
+// Slab metrics: a hit is served from the thread's free list, a miss takes
+// an exited thread's list or a new slab.
+void heap_slab_class_stats(size_t cls, size_t* block_size, size_t* hits, size_t* misses);
+size_t heap_slab_bytes_reserved(void);
+size_t heap_large_alloc_count(void);
 
 // Functions to update metrics (for internal use)
 void update_alloc_metrics(size_t bytes, AllocType type);
@@ -43,6 +75,11 @@ void update_free_metrics(size_t bytes);
 // Metrics tracking function
 void print_runtime_metrics(void);
 
+// Layers built on the heap (the list runtime) register a reporter to add
+// their own lines to print_runtime_metrics. Passing NULL removes it.
+typedef void (*RuntimeMetricsReporter)(void);
+void register_runtime_metrics_reporter(RuntimeMetricsReporter reporter);
+
 #ifdef __cplusplus
 }
 #endif
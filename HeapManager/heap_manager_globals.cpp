@@ -1,9 +1,14 @@
 #include "heap_manager_defs.h"
 #include <stdio.h>
+#include <sys/resource.h>
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#else
+#include <unistd.h>
+#endif
 
-// Global heap tracking array for all allocations
-HeapBlock g_heap_blocks_array[MAX_HEAP_BLOCKS] = {};
-size_t g_heap_blocks_index = 0;  // Rolling index for circular buffer
+// Global heap tracking table for all allocations (created on first insert)
+HeapBlockTable* g_heap_table = nullptr;
 
 // Runtime metrics tracking
 static size_t g_total_bytes_allocated = 0;
@@ -12,6 +17,11 @@ static size_t g_total_allocs = 0;
 static size_t g_total_frees = 0;
 static size_t g_vec_allocs = 0;
 static size_t g_string_allocs = 0;
+static RuntimeMetricsReporter g_metrics_reporter = nullptr;
+
+void register_runtime_metrics_reporter(RuntimeMetricsReporter reporter) {
+    g_metrics_reporter = reporter;
+}
 
 // Functions to update metrics (for internal use)
 void update_alloc_metrics(size_t bytes, AllocType type) {
@@ -30,6 +40,36 @@ void update_free_metrics(size_t bytes) {
     g_total_frees++;
 }
 
+// Resident set size of the process in bytes, or 0 if unavailable.
+static size_t current_rss_bytes(void) {
+#if defined(__APPLE__)
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) {
+        return 0;
+    }
+    return (size_t)info.resident_size;
+#else
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (!statm) return 0;
+    unsigned long pages = 0, resident = 0;
+    int fields = fscanf(statm, "%lu %lu", &pages, &resident);
+    fclose(statm);
+    return fields == 2 ? (size_t)resident * (size_t)sysconf(_SC_PAGESIZE) : 0;
+#endif
+}
+
+// Peak resident set size in bytes (ru_maxrss is bytes on macOS, KB elsewhere).
+static size_t peak_rss_bytes(void) {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+    return (size_t)usage.ru_maxrss;
+#else
+    return (size_t)usage.ru_maxrss * 1024;
+#endif
+}
+
 // Public API: Print runtime memory metrics
 void print_runtime_metrics(void) {
     printf("\n--- BCPL Runtime Metrics ---\n");
@@ -40,5 +80,10 @@ void print_runtime_metrics(void) {
     printf("Current active allocations: %zu (%zu bytes)\n", 
            g_total_allocs - g_total_frees, 
            g_total_bytes_allocated - g_total_bytes_freed);
+
+    if (g_metrics_reporter) {
+        g_metrics_reporter();
+    }
+    printf("Resident set size: %zu KB (peak %zu KB)\n", current_rss_bytes() / 1024, peak_rss_bytes() / 1024);
     printf("--------------------------\n");
 }
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include "InternedString.h"
+#include <deque>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// Strings live in a deque so their addresses (and the string_view keys
+// pointing at them) stay valid as the pool grows. Nothing is ever removed.
+struct StringPool {
+    std::deque<std::string> storage;
+    std::vector<const std::string*> by_id;
+    std::unordered_map<std::string_view, uint32_t> ids;
+    size_t bytes = 0;
+
+    StringPool() {
+        storage.emplace_back();
+        by_id.push_back(&storage.back());
+        ids.emplace(std::string_view(storage.back()), 0);
+    }
+};
+
+StringPool& pool() {
+    static StringPool instance;
+    return instance;
+}
+
+} // namespace
+
+uint32_t InternedString::intern(std::string_view text) {
+    if (text.empty()) return 0;
+    StringPool& p = pool();
+    auto it = p.ids.find(text);
+    if (it != p.ids.end()) return it->second;
+
+    uint32_t id = static_cast<uint32_t>(p.by_id.size());
+    p.storage.emplace_back(text);
+    p.by_id.push_back(&p.storage.back());
+    p.ids.emplace(std::string_view(p.storage.back()), id);
+    p.bytes += text.size();
+    return id;
+}
+
+const std::string& InternedString::str() const {
+    return *pool().by_id[id_];
+}
+
+size_t InternedString::pool_size() {
+    return pool().by_id.size();
+}
+
+size_t InternedString::pool_bytes() {
+    return pool().bytes;
+}
@@ -0,0 +1,91 @@
+#ifndef INTERNED_STRING_H
+#define INTERNED_STRING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+// A 4-byte handle to an immutable string stored once in a process-wide pool.
+// Equal strings share one ID, so copying, assigning and comparing handles
+// never touches the heap. Instruction uses it for its text and symbol
+// fields so that instruction records can be copied as plain data.
+// ID 0 is always the empty string.
+// The pool lives for the whole process and never frees a string, so memory
+// grows with the number of distinct strings ever interned. It has no
+// locking: intern only from the compiler thread.
+class InternedString {
+public:
+    InternedString() : id_(0) {}
+    InternedString(const std::string& text) : id_(intern(text)) {}
+    InternedString(const char* text) : id_(intern(text)) {}
+    // Looks the text up without building a std::string when it is already pooled.
+    explicit InternedString(std::string_view text) : id_(intern(text)) {}
+
+    // Returns the handle for an ID previously obtained from id().
+    static InternedString from_id(uint32_t id) {
+        InternedString s;
+        s.id_ = id;
+        return s;
+    }
+
+    // Number of distinct strings interned so far (including the empty string).
+    static size_t pool_size();
+    // Bytes of character data held by the pool.
+    static size_t pool_bytes();
+
+    uint32_t id() const { return id_; }
+    const std::string& str() const;
+    operator const std::string&() const { return str(); }
+
+    // Read-only std::string conveniences, forwarded to the pooled string.
+    const char* c_str() const { return str().c_str(); }
+    bool empty() const { return id_ == 0; }
+    size_t size() const { return str().size(); }
+    size_t length() const { return str().size(); }
+    char operator[](size_t pos) const { return str()[pos]; }
+    char back() const { return str().back(); }
+    std::string substr(size_t pos = 0, size_t count = std::string::npos) const { return str().substr(pos, count); }
+    template <typename T>
+    size_t find(const T& needle, size_t pos = 0) const { return str().find(needle, pos); }
+    template <typename T>
+    size_t rfind(const T& needle, size_t pos = std::string::npos) const { return str().rfind(needle, pos); }
+    template <typename T>
+    int compare(const T& other) const { return str().compare(other); }
+
+    // Appending interns a new string; the old one stays in the pool.
+    InternedString& operator+=(const std::string& suffix) {
+        *this = InternedString(str() + suffix);
+        return *this;
+    }
+
+    friend bool operator==(InternedString a, InternedString b) { return a.id_ == b.id_; }
+    friend bool operator!=(InternedString a, InternedString b) { return a.id_ != b.id_; }
+    friend bool operator==(InternedString a, const std::string& b) { return a.str() == b; }
+    friend bool operator!=(InternedString a, const std::string& b) { return a.str() != b; }
+    friend bool operator==(const std::string& a, InternedString b) { return a == b.str(); }
+    friend bool operator!=(const std::string& a, InternedString b) { return a != b.str(); }
+    friend bool operator==(InternedString a, const char* b) { return a.str() == b; }
+    friend bool operator!=(InternedString a, const char* b) { return a.str() != b; }
+
+private:
+    static uint32_t intern(std::string_view text);
+    uint32_t id_;
+};
+
+inline std::ostream& operator<<(std::ostream& os, InternedString s) { return os << s.str(); }
+inline std::string operator+(InternedString a, const std::string& b) { return a.str() + b; }
+inline std::string operator+(const std::string& a, InternedString b) { return a + b.str(); }
+inline std::string operator+(InternedString a, const char* b) { return a.str() + b; }
+inline std::string operator+(const char* a, InternedString b) { return a + b.str(); }
+
+namespace std {
+template <>
+struct hash<InternedString> {
+    size_t operator()(InternedString s) const noexcept { return std::hash<uint32_t>()(s.id()); }
+};
+} // namespace std
+
+#endif // INTERNED_STRING_H
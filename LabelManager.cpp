@@ -38,28 +38,67 @@ bool LabelManager::is_runtime_label(const std::string& label_name) const {
     return RuntimeManager::instance().is_function_registered(label_name);
 }
 
+LabelId LabelManager::intern_label(InternedString label_name) {
+    LabelId existing = find_label(label_name);
+    if (existing != kInvalidLabelId) {
+        return existing;
+    }
+    uint32_t key = label_name.id();
+    if (key >= ids_by_string_.size()) {
+        ids_by_string_.resize(key + 1, kInvalidLabelId);
+    }
+    LabelId id = static_cast<LabelId>(names_.size());
+    ids_by_string_[key] = id;
+    names_.push_back(label_name);
+    addresses_.push_back(kUndefinedAddress);
+    return id;
+}
+
+void LabelManager::define_label(LabelId id, size_t address) {
+    if (is_label_defined(id)) {
+        throw std::runtime_error("Error: Label '" + label_name(id) + "' already defined.");
+    }
+    addresses_[id] = address;
+}
+
 void LabelManager::define_label(const std::string& label_name, size_t address) {
-    if (is_label_defined(label_name)) {
-        throw std::runtime_error("Error: Label '" + label_name + "' already defined.");
+    define_label(intern_label(label_name), address);
+}
+
+size_t LabelManager::get_label_address(LabelId id) const {
+    if (!is_label_defined(id)) {
+        std::string name = id < names_.size() ? label_name(id) : "#" + std::to_string(id);
+        throw std::runtime_error("Error: Label '" + name + "' not defined.");
     }
-    defined_labels_[label_name] = address;
+    return addresses_[id];
 }
 
 size_t LabelManager::get_label_address(const std::string& label_name) const {
-    auto it = defined_labels_.find(label_name);
-    if (it == defined_labels_.end()) {
+    LabelId id = find_label(label_name);
+    if (!is_label_defined(id)) {
         throw std::runtime_error("Error: Label '" + label_name + "' not defined.");
     }
-    return it->second;
+    return addresses_[id];
 }
 
 bool LabelManager::is_label_defined(const std::string& label_name) const {
-    return defined_labels_.count(label_name) > 0;
+    return is_label_defined(find_label(label_name));
+}
+
+std::unordered_map<std::string, size_t> LabelManager::get_defined_labels() const {
+    std::unordered_map<std::string, size_t> defined;
+    defined.reserve(names_.size());
+    for (LabelId id = 0; id < names_.size(); ++id) {
+        if (addresses_[id] != kUndefinedAddress) {
+            defined.emplace(names_[id].str(), addresses_[id]);
+        }
+    }
+    return defined;
 }
 
 void LabelManager::reset() {
-    defined_labels_.clear();
+    ids_by_string_.clear();
+    names_.clear();
+    addresses_.clear();
     next_label_id_ = 0;
 }
-
-
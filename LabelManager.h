@@ -2,15 +2,27 @@
 #define LABEL_MANAGER_H
 
 #include "RuntimeManager.h"
+#include "InternedString.h"
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <stdexcept>
 
+// Dense integer ID for a label, assigned in order of first appearance.
+using LabelId = uint32_t;
+constexpr LabelId kInvalidLabelId = UINT32_MAX;
+
 // The LabelManager creates and defines labels, mapping their names to addresses.
+// Each label name is interned once into a LabelId; addresses live in a flat
+// vector indexed by that ID, so lookups during linking are array accesses.
 // Singleton pattern: only one instance exists.
 class LabelManager {
 public:
+    // Address value for a label that has been interned but not yet defined.
+    static constexpr size_t kUndefinedAddress = SIZE_MAX;
+
     // Singleton accessor
     static LabelManager& instance() {
         static LabelManager instance;
@@ -38,17 +50,36 @@ public:
     // Returns the next label id (for unique label generation)
     size_t get_next_id() const;
 
+    // --- Label IDs ---
+    // Returns the ID for a label name, assigning a new one on first use.
+    LabelId intern_label(InternedString label_name);
+    // Returns the ID for a label name, or kInvalidLabelId if it was never interned.
+    LabelId find_label(InternedString label_name) const {
+        uint32_t key = label_name.id();
+        return key < ids_by_string_.size() ? ids_by_string_[key] : kInvalidLabelId;
+    }
+    // Returns the name a label ID was interned from.
+    const std::string& label_name(LabelId id) const { return names_[id].str(); }
+    // Number of label IDs assigned so far.
+    size_t label_count() const { return names_.size(); }
+
     // Defines a label, associating it with a specific address (offset in bytes).
+    void define_label(LabelId id, size_t address);
     void define_label(const std::string& label_name, size_t address);
 
     // Retrieves the address associated with a label.
+    size_t get_label_address(LabelId id) const;
     size_t get_label_address(const std::string& label_name) const;
 
     // Checks if a label is defined.
+    bool is_label_defined(LabelId id) const {
+        return id < addresses_.size() && addresses_[id] != kUndefinedAddress;
+    }
     bool is_label_defined(const std::string& label_name) const;
 
     // Returns a map of all defined labels and their addresses.
-    const std::unordered_map<std::string, size_t>& get_defined_labels() const { return defined_labels_; }
+    // Built on demand; intended for listings and assembly output.
+    std::unordered_map<std::string, size_t> get_defined_labels() const;
 
 private:
     // Private constructor for singleton
@@ -59,7 +90,11 @@ private:
     LabelManager(LabelManager&&) = delete;
     LabelManager& operator=(LabelManager&&) = delete;
 
-    std::unordered_map<std::string, size_t> defined_labels_;
+    // Indexed by InternedString ID; kInvalidLabelId for strings that are not labels.
+    std::vector<LabelId> ids_by_string_;
+    // Both indexed by LabelId.
+    std::vector<InternedString> names_;
+    std::vector<size_t> addresses_;
     size_t next_label_id_;
 
     // List of runtime routine labels for identification
@@ -1,9 +1,10 @@
 #include "Lexer.h"
 #include "LexerDebug.h"
 #include <cctype>
+#include <stdexcept>
 #include <utility>
 
-const std::unordered_map<std::string, TokenType> Lexer::keywords_ = {
+const std::unordered_map<std::string_view, TokenType> Lexer::keywords_ = {
     {"LET", TokenType::Let}, {"MANIFEST", TokenType::Manifest}, {"STATIC", TokenType::Static}, {"FSTATIC", TokenType::FStatic},
     {"GLOBAL", TokenType::Global}, {"FUNCTION", TokenType::Function}, {"ROUTINE", TokenType::Routine},
     {"AND", TokenType::LogicalAnd}, {"NOT", TokenType::LogicalNot}, {"VEC", TokenType::Vec}, {"IF", TokenType::If},
@@ -69,6 +70,34 @@ Lexer::Lexer(std::string source, bool trace)
 }
 
 Token Lexer::get_next_token() {
+    if (lookahead_count_ > 0) {
+        Token token = lookahead_[lookahead_head_];
+        lookahead_head_ = (lookahead_head_ + 1) % kLookahead;
+        --lookahead_count_;
+        return token;
+    }
+    return scan_token();
+}
+
+const Token& Lexer::peek(size_t ahead) {
+    if (ahead >= kLookahead) {
+        throw std::out_of_range("Lexer::peek: lookahead is limited to " + std::to_string(kLookahead) + " tokens");
+    }
+    // Tokens are scanned in order, so last_token_was_value_ sees the same
+    // history it would without the lookahead.
+    while (lookahead_count_ <= ahead) {
+        lookahead_[(lookahead_head_ + lookahead_count_) % kLookahead] = scan_token();
+        ++lookahead_count_;
+    }
+    return lookahead_[(lookahead_head_ + ahead) % kLookahead];
+}
+
+std::string_view Lexer::keep_text(std::string text) {
+    decoded_text_.push_back(std::move(text));
+    return decoded_text_.back();
+}
+
+Token Lexer::scan_token() {
     skip_whitespace_and_comments();
 
     if (is_at_end()) {
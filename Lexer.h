@@ -2,8 +2,10 @@
 #define LEXER_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <cstdint>
+#include <deque>
 #include <unordered_map>
 
 enum class TokenType {
@@ -52,44 +54,67 @@ enum class TokenType {
 
 std::string to_string(TokenType type);
 
+// A token's text is a view, never a copy. Identifiers and keywords point
+// into the InternedString pool and stay valid for the whole run; other
+// values point into the Lexer's source or its decoded-text store and are
+// valid while the Lexer lives.
 struct Token {
-    TokenType type;
-    std::string value;
-    int line;
-    int column;
+    TokenType type = TokenType::Eof;
+    std::string_view value;
+    int line = 0;
+    int column = 0;
     std::string to_string() const;
 };
 
 class Lexer {
 public:
     Lexer(std::string source, bool trace = false);
+    // Tokens view the source and lookahead buffer held here.
+    Lexer(const Lexer&) = delete;
+    Lexer& operator=(const Lexer&) = delete;
+
     Token get_next_token();
-    Token peek() const;
+    // Returns the token after the one get_next_token() last returned without
+    // consuming it. O(1): the token is scanned once into the lookahead ring.
+    const Token& peek(size_t ahead = 0);
 
 public:
     std::string source_;
 private:
+    // Lookahead ring buffer, filled by peek() and drained by get_next_token().
+    static constexpr size_t kLookahead = 4;
+    Token lookahead_[kLookahead];
+    size_t lookahead_head_ = 0;
+    size_t lookahead_count_ = 0;
+
+    // Text that is not a slice of the source: string literals with escapes
+    // and error messages. A deque keeps earlier entries in place.
+    std::deque<std::string> decoded_text_;
+
     size_t position_;
     int line_;
     int column_;
     bool trace_enabled_;
     bool last_token_was_value_; // Add this state variable
-    static const std::unordered_map<std::string, TokenType> keywords_;
+    static const std::unordered_map<std::string_view, TokenType> keywords_;
 
+    Token scan_token();
     char advance();
     char peek_char() const;
     char peek_next_char() const;
     bool is_at_end() const;
     void skip_whitespace_and_comments();
 
+    std::string_view source_from(size_t start) const { return std::string_view(source_).substr(start, position_ - start); }
+    std::string_view keep_text(std::string text);
+
     Token make_token(TokenType type) const;
-    Token make_error_token(const std::string& message) const;
+    Token make_error_token(std::string message);
     Token scan_identifier_or_keyword();
     Token scan_number();
     Token scan_string();
     Token scan_char();
     Token scan_operator();
-    Token make_token_with_value(TokenType type, const std::string& value) const;
 };
 
 #endif // LEXER_H
\ No newline at end of file
@@ -34,8 +34,11 @@ std::vector<Instruction> Linker::process(
     std::vector<Instruction> instructions_with_addresses =
         assignAddressesAndResolveLabels(stream, manager, code_base_address, data_base, enable_tracing);
 
+    // Resolve every label once, so that relocation is a lookup in a flat array.
+    std::vector<size_t> label_targets = resolveLabelTargets(manager, runtime_manager, enable_tracing);
+
     // Pass 2: Apply relocations to patch instructions with the now-known label addresses.
-    performRelocations(instructions_with_addresses, manager, runtime_manager, enable_tracing);
+    performRelocations(instructions_with_addresses, manager, label_targets, enable_tracing);
 
     return instructions_with_addresses;
 }
@@ -61,7 +64,8 @@ std::vector<Instruction> Linker::process(
      if (enable_tracing) std::cerr << "[LINKER-PASS1] Starting address and label assignment...\n";
 
      std::vector<Instruction> finalized_instructions;
-     finalized_instructions.reserve(stream.get_instructions().size());
+     const std::vector<Instruction>& source = stream.get_instructions_ref();
+     finalized_instructions.reserve(source.size());
 
      // --- Correct Cursor Management ---
      size_t code_cursor = code_base_address;
@@ -70,7 +74,7 @@ std::vector<Instruction> Linker::process(
 
      // --- Pass 1a: Calculate the total size of the code segment to find where .rodata starts ---
      size_t code_segment_size = 0;
-     for (const auto& instr : stream.get_instructions()) {
+     for (const auto& instr : source) {
          if (instr.segment == SegmentType::CODE) {
              if (!instr.is_label_definition) {
                  code_segment_size += 4;
@@ -88,7 +92,7 @@ std::vector<Instruction> Linker::process(
      }
 
      // --- Pass 1b: Assign final addresses to all instructions and define all labels ---
-     for (const auto& instr : stream.get_instructions()) {
+     for (const auto& instr : source) {
          Instruction new_instr = instr;
 
          // Determine which cursor to use based on the segment
@@ -104,7 +108,11 @@ std::vector<Instruction> Linker::process(
 
          // Step 1: Always define a label if the instruction has one.
          if (instr.is_label_definition) {
-             manager.define_label(instr.target_label, *current_cursor);
+             manager.define_label(manager.intern_label(instr.target_label), *current_cursor);
+         } else if (instr.relocation != RelocationType::NONE && !instr.target_label.empty()) {
+             // Give relocation targets an ID now, including runtime symbols
+             // that are never defined in the stream.
+             manager.intern_label(instr.target_label);
          }
 
          // Step 2: Always advance the cursor if the instruction emits data/code.
@@ -126,6 +134,38 @@ std::vector<Instruction> Linker::process(
 
 
 
+/**
+ * @brief Resolves the final address of every interned label.
+ *
+ * Runtime routines take precedence over labels defined in the stream, as they
+ * always have. Each label is looked up in the RuntimeManager once here rather
+ * than once per relocation.
+ *
+ * @return A vector indexed by LabelId; LabelManager::kUndefinedAddress marks
+ *         labels that resolved to nothing.
+ */
+std::vector<size_t> Linker::resolveLabelTargets(
+    const LabelManager& manager,
+    const RuntimeManager& runtime_manager,
+    bool enable_tracing
+) {
+    std::vector<size_t> targets(manager.label_count(), LabelManager::kUndefinedAddress);
+    size_t runtime_count = 0;
+    for (LabelId id = 0; id < targets.size(); ++id) {
+        const std::string& name = manager.label_name(id);
+        if (runtime_manager.is_function_registered(name)) {
+            targets[id] = reinterpret_cast<size_t>(runtime_manager.get_function(name).address);
+            runtime_count++;
+        } else if (manager.is_label_defined(id)) {
+            targets[id] = manager.get_label_address(id);
+        }
+    }
+    if (enable_tracing) {
+        std::cerr << "[LINKER] Resolved " << targets.size() << " labels (" << runtime_count << " runtime symbols).\n";
+    }
+    return targets;
+}
+
 /**
  * @brief (PASS 2) Applies relocations to instructions.
  *
@@ -135,7 +175,7 @@ std::vector<Instruction> Linker::process(
 void Linker::performRelocations(
     std::vector<Instruction>& instructions,
     const LabelManager& manager,
-    const RuntimeManager& runtime_manager,
+    const std::vector<size_t>& label_targets,
     bool enable_tracing
 ) {
     if (enable_tracing) std::cerr << "[LINKER-PASS2] Starting instruction relocation...\n";
@@ -154,13 +194,11 @@ void Linker::performRelocations(
         instr.resolved_symbol_name = instr.target_label;
         instr.relocation_applied = true;
 
-        if (runtime_manager.is_function_registered(instr.target_label)) {
-            target_address = reinterpret_cast<size_t>(runtime_manager.get_function(instr.target_label).address);
-        } else if (manager.is_label_defined(instr.target_label)) {
-            target_address = manager.get_label_address(instr.target_label);
-        } else {
+        LabelId label_id = manager.find_label(instr.target_label);
+        if (label_id == kInvalidLabelId || label_targets[label_id] == LabelManager::kUndefinedAddress) {
             throw std::runtime_error("Error: Undefined label '" + instr.target_label + "' encountered during linking.");
         }
+        target_address = label_targets[label_id];
 
         instr.resolved_target_address = target_address;
 
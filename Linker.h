@@ -35,12 +35,19 @@ private:
         bool enable_tracing
     );
 
+    // Builds the final address of every label, indexed by LabelId.
+    std::vector<size_t> resolveLabelTargets(
+        const LabelManager& manager,
+        const RuntimeManager& runtime_manager,
+        bool enable_tracing
+    );
+
     // --- Pass 2 Helper ---
     // Iterates through instructions to patch relocations.
     void performRelocations(
         std::vector<Instruction>& instructions,
         const LabelManager& manager,
-        const RuntimeManager& runtime_manager,
+        const std::vector<size_t>& label_targets,
         bool enable_tracing
     );
 
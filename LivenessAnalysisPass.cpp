@@ -4,7 +4,7 @@
 
 // Constructor
 LivenessAnalysisPass::LivenessAnalysisPass(const CFGMap& cfgs, bool trace_enabled) 
-    : cfgs_(cfgs), trace_enabled_(trace_enabled) {}
+    : trace_enabled_(trace_enabled), cfgs_(cfgs) {}
 
 // Phase 1: Compute use and def sets for every basic block in every CFG.
 // Implementation moved to separate file: live_compute_use_def_sets.cpp
@@ -14,11 +14,20 @@ LivenessAnalysisPass::LivenessAnalysisPass(const CFGMap& cfgs, bool trace_enable
 
 
 
+uint32_t LivenessAnalysisPass::variable_id(const std::string& name) {
+    auto inserted = current_function_->variable_index.emplace(name, static_cast<uint32_t>(current_function_->variables.size()));
+    if (inserted.second) {
+        current_function_->variables.push_back(name);
+    }
+    return inserted.first->second;
+}
+
 // Visitor for variable access (a 'use' case).
 void LivenessAnalysisPass::visit(VariableAccess& node) {
     // A variable is used if it's not already defined within this block.
-    if (current_def_set_.find(node.name) == current_def_set_.end()) {
-        current_use_set_.insert(node.name);
+    uint32_t id = variable_id(node.name);
+    if (!current_def_set_.test(id)) {
+        current_use_set_.set(id);
     }
 }
 
@@ -33,7 +42,7 @@ void LivenessAnalysisPass::visit(AssignmentStatement& node) {
     for (const auto& lhs_expr : node.lhs) {
         if (auto* var = dynamic_cast<VariableAccess*>(lhs_expr.get())) {
             // This variable is defined here.
-            current_def_set_.insert(var->name);
+            current_def_set_.set(variable_id(var->name));
         }
     }
 }
@@ -96,49 +105,47 @@ void LivenessAnalysisPass::visit(RoutineCallStatement& node) {
     }
 }
 
+// A branching statement ends its block and only its condition is evaluated
+// there. The CFG builder places the branches and loop bodies in their own
+// blocks, so visiting them here would add uses and defs to the wrong block.
 void LivenessAnalysisPass::visit(IfStatement& node) {
     if (node.condition) node.condition->accept(*this);
-    if (node.then_branch) node.then_branch->accept(*this);
 }
 
 void LivenessAnalysisPass::visit(UnlessStatement& node) {
     if (node.condition) node.condition->accept(*this);
-    if (node.then_branch) node.then_branch->accept(*this);
 }
 
 void LivenessAnalysisPass::visit(TestStatement& node) {
     if (node.condition) node.condition->accept(*this);
-    if (node.then_branch) node.then_branch->accept(*this);
-    if (node.else_branch) node.else_branch->accept(*this);
 }
 
 void LivenessAnalysisPass::visit(WhileStatement& node) {
     if (node.condition) node.condition->accept(*this);
-    if (node.body) node.body->accept(*this);
 }
 
 void LivenessAnalysisPass::visit(UntilStatement& node) {
     if (node.condition) node.condition->accept(*this);
-    if (node.body) node.body->accept(*this);
 }
 
 void LivenessAnalysisPass::visit(RepeatStatement& node) {
     if (node.body) node.body->accept(*this);
 }
 
+// The FOR header block compares the loop variable with the end value. The
+// initialisation, increment and body are separate statements and blocks.
 void LivenessAnalysisPass::visit(ForStatement& node) {
-    if (node.start_expr) node.start_expr->accept(*this);
+    if (!node.unique_loop_variable_name.empty()) {
+        uint32_t id = variable_id(node.unique_loop_variable_name);
+        if (!current_def_set_.test(id)) {
+            current_use_set_.set(id);
+        }
+    }
     if (node.end_expr) node.end_expr->accept(*this);
-    if (node.step_expr) node.step_expr->accept(*this);
-    if (node.body) node.body->accept(*this);
 }
 
 void LivenessAnalysisPass::visit(SwitchonStatement& node) {
     if (node.expression) node.expression->accept(*this);
-    for (const auto& case_stmt : node.cases) {
-        if (case_stmt) case_stmt->accept(*this);
-    }
-    if (node.default_case) node.default_case->accept(*this);
 }
 
 void LivenessAnalysisPass::visit(CaseStatement& node) {
@@ -150,11 +157,11 @@ void LivenessAnalysisPass::visit(DefaultStatement& node) {
     if (node.command) node.command->accept(*this);
 }
 
-void LivenessAnalysisPass::visit(GotoStatement& node) {
+void LivenessAnalysisPass::visit(GotoStatement&) {
     // No variable use in label jump
 }
 
-void LivenessAnalysisPass::visit(ReturnStatement& node) {
+void LivenessAnalysisPass::visit(ReturnStatement&) {
     // No return value expression in ReturnStatement
 }
 
@@ -165,15 +172,15 @@ void LivenessAnalysisPass::visit(FinishStatement& node) {
     }
 }
 
-void LivenessAnalysisPass::visit(BreakStatement& node) {
+void LivenessAnalysisPass::visit(BreakStatement&) {
     // No variable use
 }
 
-void LivenessAnalysisPass::visit(LoopStatement& node) {
+void LivenessAnalysisPass::visit(LoopStatement&) {
     // No body field in LoopStatement
 }
 
-void LivenessAnalysisPass::visit(EndcaseStatement& node) {
+void LivenessAnalysisPass::visit(EndcaseStatement&) {
     // No variable use
 }
 
@@ -193,7 +200,7 @@ void LivenessAnalysisPass::visit(BlockStatement& node) {
     }
 }
 
-void LivenessAnalysisPass::visit(StringStatement& node) {
+void LivenessAnalysisPass::visit(StringStatement&) {
     // No variable use
     }
 
@@ -203,7 +210,7 @@ void LivenessAnalysisPass::visit(StringStatement& node) {
 
 
 
-void LivenessAnalysisPass::visit(LabelTargetStatement& node) {
+void LivenessAnalysisPass::visit(LabelTargetStatement&) {
     // LabelTargetStatement only has a labelName (no statement/command to visit)
 }
 
@@ -212,6 +219,10 @@ void LivenessAnalysisPass::visit(ConditionalBranchStatement& node) {
     // node.targetLabel is a string, not an AST node
 }
 
+void LivenessAnalysisPass::visit(PrefetchStatement& node) {
+    if (node.address_expr) node.address_expr->accept(*this);
+}
+
 void LivenessAnalysisPass::visit(SysCall& node) {
     for (const auto& arg : node.arguments) {
         if (arg) arg->accept(*this);
@@ -232,7 +243,7 @@ void LivenessAnalysisPass::visit(TableExpression& node) {
     }
 }
 
-void LivenessAnalysisPass::visit(GlobalVariableDeclaration& node) {
+void LivenessAnalysisPass::visit(GlobalVariableDeclaration&) {
     // Global variables are not part of liveness analysis within functions.
     // This method is implemented to satisfy the ASTVisitor interface.
     
@@ -249,16 +260,45 @@ void LivenessAnalysisPass::visit(GlobalVariableDeclaration& node) {
 // Implementation moved to separate file: live_run.cpp
 
 // Accessors
-// Implementation moved to separate files: live_get_in_set.cpp and live_get_out_set.cpp
+// get_in_set and get_out_set live in live_get_in_set.cpp and live_get_out_set.cpp.
 
-// Print results
-// Implementation moved to separate file: live_print_results.cpp
+const BitVector* LivenessAnalysisPass::get_in_bits(BasicBlock* block) const {
+    auto it = block_sets_.find(block);
+    return (it != block_sets_.end()) ? &it->second.in : nullptr;
+}
 
+const BitVector* LivenessAnalysisPass::get_out_bits(BasicBlock* block) const {
+    auto it = block_sets_.find(block);
+    return (it != block_sets_.end()) ? &it->second.out : nullptr;
+}
 
+const std::vector<std::string>& LivenessAnalysisPass::get_variables(const std::string& function_name) const {
+    auto it = function_index_.find(function_name);
+    return (it != function_index_.end()) ? functions_[it->second].variables : empty_variables_;
+}
 
+int LivenessAnalysisPass::get_variable_index(const std::string& function_name, const std::string& variable) const {
+    auto it = function_index_.find(function_name);
+    if (it == function_index_.end()) return -1;
+    const auto& index = functions_[it->second].variable_index;
+    auto var_it = index.find(variable);
+    return (var_it != index.end()) ? static_cast<int>(var_it->second) : -1;
+}
 
+const std::vector<BasicBlock*>& LivenessAnalysisPass::get_block_order(const std::string& function_name) const {
+    auto it = function_index_.find(function_name);
+    return (it != function_index_.end()) ? functions_[it->second].block_order : empty_block_order_;
+}
 
-// Print results for debugging
+std::set<std::string> LivenessAnalysisPass::to_names(const BlockSets& sets, const BitVector& bits) const {
+    const auto& variables = functions_[sets.function].variables;
+    std::set<std::string> names;
+    bits.for_each([&](size_t id) { names.insert(variables[id]); });
+    return names;
+}
+
+// Print results
+// Implementation moved to separate file: live_print_results.cpp
 
 #include <algorithm>
 #include <map>
@@ -275,14 +315,12 @@ std::map<std::string, int> LivenessAnalysisPass::calculate_register_pressure() c
 
         // Iterate over each basic block in the current function's CFG
         for (const auto& block_pair : cfg->get_blocks()) {
-            BasicBlock* block = block_pair.second.get();
-
-            // Find the size of the in-set and out-set for the current block
-            size_t in_size = get_in_set(block).size();
-            size_t out_size = get_out_set(block).size();
+            auto it = block_sets_.find(block_pair.second.get());
+            if (it == block_sets_.end()) continue;
 
-            // The register pressure at this block's boundaries is the max of the two
-            int current_max = std::max(in_size, out_size);
+            // The register pressure at this block's boundaries is the max of
+            // the live-in and live-out population counts.
+            int current_max = static_cast<int>(std::max(it->second.in.count(), it->second.out.count()));
 
             // Keep track of the highest pressure seen so far in this function
             if (current_max > max_pressure) {
@@ -1,12 +1,14 @@
 #pragma once
 
 #include "ASTVisitor.h"
+#include "BitVector.h"
 #include "ControlFlowGraph.h"
 #include <string>
 #include <vector>
 #include <set>
 #include <map>
 #include <memory>
+#include <unordered_map>
 
 class LivenessAnalysisPass : public ASTVisitor {
 public:
@@ -16,36 +18,48 @@ public:
     // Constructor: Takes the map of CFGs generated by CFGBuilderPass and a trace flag.
     LivenessAnalysisPass(const CFGMap& cfgs, bool trace_enabled);
 
-    // A map to hold the resulting sets for each basic block.
-    using LivenessSets = std::map<BasicBlock*, std::set<std::string>>;
-
     // Trace flag to control debug output.
     bool trace_enabled_;
 
     // Main entry point to run the analysis.
     void run();
 
-    // Public methods to access the results.
-    const std::set<std::string>& get_in_set(BasicBlock* block) const;
-    const std::set<std::string>& get_out_set(BasicBlock* block) const;
+    // Public methods to access the results. The name sets are built from the
+    // bit-vectors on demand; passes that run per block should use the bits.
+    std::set<std::string> get_in_set(BasicBlock* block) const;
+    std::set<std::string> get_out_set(BasicBlock* block) const;
     void print_results() const;
 
+    // Variables of each function are numbered densely in first-seen order.
+    // Returns nullptr for blocks the analysis has not seen.
+    const BitVector* get_in_bits(BasicBlock* block) const;
+    const BitVector* get_out_bits(BasicBlock* block) const;
+    const std::vector<std::string>& get_variables(const std::string& function_name) const;
+    // Returns -1 if the variable does not occur in the function.
+    int get_variable_index(const std::string& function_name, const std::string& variable) const;
+    // Blocks of a function in reverse postorder from the entry block, followed
+    // by any blocks not reachable from it.
+    const std::vector<BasicBlock*>& get_block_order(const std::string& function_name) const;
+    // Use and def bits of one statement of the function, by the same rules as
+    // the block sets. Used by passes that need per-statement precision.
+    void get_statement_use_def(const std::string& function_name, Statement& stmt, BitVector& use, BitVector& def);
+
     // Returns a map where key is function name and value is the max register pressure.
     std::map<std::string, int> calculate_register_pressure() const;
 
     // --- ASTVisitor stubs for all required visit methods ---
-    void visit(Program& node) override {}
-    void visit(LetDeclaration& node) override {}
-    void visit(ManifestDeclaration& node) override {}
-    void visit(StaticDeclaration& node) override {}
-    void visit(GlobalDeclaration& node) override {}
-    void visit(FunctionDeclaration& node) override {}
-    void visit(RoutineDeclaration& node) override {}
-    void visit(LabelDeclaration& node) override {}
-    void visit(NumberLiteral& node) override {}
-    void visit(StringLiteral& node) override {}
-    void visit(CharLiteral& node) override {}
-    void visit(BooleanLiteral& node) override {}
+    void visit(Program&) override {}
+    void visit(LetDeclaration&) override {}
+    void visit(ManifestDeclaration&) override {}
+    void visit(StaticDeclaration&) override {}
+    void visit(GlobalDeclaration&) override {}
+    void visit(FunctionDeclaration&) override {}
+    void visit(RoutineDeclaration&) override {}
+    void visit(LabelDeclaration&) override {}
+    void visit(NumberLiteral&) override {}
+    void visit(StringLiteral&) override {}
+    void visit(CharLiteral&) override {}
+    void visit(BooleanLiteral&) override {}
     void visit(VariableAccess& node) override;
     void visit(BinaryOp& node) override;
     void visit(UnaryOp& node) override;
@@ -80,26 +94,44 @@ public:
     void visit(FreeStatement& node) override;
     void visit(LabelTargetStatement& node) override;
     void visit(ConditionalBranchStatement& node) override;
+    void visit(PrefetchStatement& node) override;
     void visit(SysCall& node) override;
     void visit(VecAllocationExpression& node) override;
     void visit(StringAllocationExpression& node) override;
     void visit(TableExpression& node) override;
-    void visit(FloatValofExpression& node) override {}
-    void visit(BrkStatement& node) override {}
+    void visit(FloatValofExpression&) override {}
+    void visit(BrkStatement&) override {}
     void visit(GlobalVariableDeclaration& node) override;
 
 private:
     // Input: A reference to the map of CFGs.
     const CFGMap& cfgs_;
 
-    // Storage for the results.
-    LivenessSets use_sets_;
-    LivenessSets def_sets_;
-    LivenessSets in_sets_;
-    LivenessSets out_sets_;
-    
-    // An empty set to return for blocks with no data.
-    std::set<std::string> empty_set_;
+    // Per-block use/def/in/out sets over the function's variable numbering.
+    struct BlockSets {
+        BitVector use;
+        BitVector def;
+        BitVector in;
+        BitVector out;
+        size_t function = 0; // Index into functions_.
+        size_t order = 0;    // Position in the function's block order.
+    };
+
+    // Dense variable numbering and block order for one function.
+    struct FunctionInfo {
+        std::string name;
+        std::vector<std::string> variables;
+        std::unordered_map<std::string, uint32_t> variable_index;
+        std::vector<BasicBlock*> block_order;
+    };
+
+    std::unordered_map<BasicBlock*, BlockSets> block_sets_;
+    std::vector<FunctionInfo> functions_;
+    std::unordered_map<std::string, size_t> function_index_;
+
+    // Returned for unknown functions.
+    std::vector<std::string> empty_variables_;
+    std::vector<BasicBlock*> empty_block_order_;
 
     // --- Private Helper Methods ---
     
@@ -112,9 +144,15 @@ private:
     // A helper to traverse the statements of a basic block.
     void analyze_block(BasicBlock* block);
 
-    // Track the current sets being built for the block being analyzed.
+    // Orders a function's blocks for the solver.
+    static std::vector<BasicBlock*> compute_block_order(const ControlFlowGraph& cfg);
 
+    // Numbers a variable in the function being analyzed.
+    uint32_t variable_id(const std::string& name);
+    std::set<std::string> to_names(const BlockSets& sets, const BitVector& bits) const;
 
-    std::set<std::string> current_use_set_;
-    std::set<std::string> current_def_set_;
+    // Track the current sets being built for the block being analyzed.
+    FunctionInfo* current_function_ = nullptr;
+    BitVector current_use_set_;
+    BitVector current_def_set_;
 };
\ No newline at end of file
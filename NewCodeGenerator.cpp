@@ -17,6 +17,7 @@
 #include <map>        // For std::map
 #include <stack>      // For std::stack
 #include "analysis/LiveInterval.h"
+#include "RegisterAllocationPass.h"
 #include "runtime/ListDataTypes.h"
 #include "RuntimeManager.h"
 
@@ -60,28 +61,28 @@ NewCodeGenerator::NewCodeGenerator(InstructionStream& instruction_stream,
 // X19-relative scalable access helpers for runtime tables (now as private member functions)
 void NewCodeGenerator::emit_x19_relative_ldr(const std::string& dest_reg, size_t byte_offset, const std::string& comment) {
     if (byte_offset <= MAX_LDR_OFFSET) {
-        emit(Encoder::create_ldr_imm(dest_reg, "X19", byte_offset, comment));
+        emit(Encoder::create_ldr_imm(Reg::parse(dest_reg), Reg::x(19), static_cast<int>(byte_offset), comment));
     } else {
-        std::string offset_reg = register_manager_.acquire_scratch_reg(*this);
-        std::string addr_reg = register_manager_.acquire_scratch_reg(*this);
-        emit(Encoder::create_movz_movk_abs64(offset_reg, byte_offset, ""));
-        emit(Encoder::create_add_reg(addr_reg, "X19", offset_reg));
-        emit(Encoder::create_ldr_imm(dest_reg, addr_reg, 0, comment));
-        register_manager_.release_register(offset_reg);
-        register_manager_.release_register(addr_reg);
+        Reg offset_reg = register_manager_.acquire_scratch(*this);
+        Reg addr_reg = register_manager_.acquire_scratch(*this);
+        emit(Encoder::create_movz_movk_abs64(offset_reg.str(), byte_offset, ""));
+        emit(Encoder::create_add_reg(addr_reg, Reg::x(19), offset_reg));
+        emit(Encoder::create_ldr_imm(Reg::parse(dest_reg), addr_reg, 0, comment));
+        register_manager_.release_scratch(offset_reg);
+        register_manager_.release_scratch(addr_reg);
     }
 }
 void NewCodeGenerator::emit_x19_relative_str(const std::string& src_reg, size_t byte_offset, const std::string& comment) {
     if (byte_offset <= MAX_LDR_OFFSET) {
-        emit(Encoder::create_str_imm(src_reg, "X19", byte_offset, comment));
+        emit(Encoder::create_str_imm(Reg::parse(src_reg), Reg::x(19), static_cast<int>(byte_offset), comment));
     } else {
-        std::string offset_reg = register_manager_.acquire_scratch_reg(*this);
-        std::string addr_reg = register_manager_.acquire_scratch_reg(*this);
-        emit(Encoder::create_movz_movk_abs64(offset_reg, byte_offset, ""));
-        emit(Encoder::create_add_reg(addr_reg, "X19", offset_reg));
-        emit(Encoder::create_str_imm(src_reg, addr_reg, 0, comment));
-        register_manager_.release_register(offset_reg);
-        register_manager_.release_register(addr_reg);
+        Reg offset_reg = register_manager_.acquire_scratch(*this);
+        Reg addr_reg = register_manager_.acquire_scratch(*this);
+        emit(Encoder::create_movz_movk_abs64(offset_reg.str(), byte_offset, ""));
+        emit(Encoder::create_add_reg(addr_reg, Reg::x(19), offset_reg));
+        emit(Encoder::create_str_imm(Reg::parse(src_reg), addr_reg, 0, comment));
+        register_manager_.release_scratch(offset_reg);
+        register_manager_.release_scratch(addr_reg);
     }
 }
 
@@ -416,265 +417,6 @@ bool NewCodeGenerator::lookup_symbol(const std::string& name, Symbol& symbol) co
     return symbol_table_->lookup(name, symbol);
 }
 
-// --- Linear Scan Register Allocation ---
-void NewCodeGenerator::performLinearScan(const std::string& functionName, const std::vector<LiveInterval>& intervals) {
-    debug_print("Performing linear scan register allocation for function: " + functionName);
-
-    // Don't clear the existing allocations - we might need to keep non-local variables
-
-    // Make sure we have a valid frame manager
-    if (!current_frame_manager_) {
-        debug_print("WARNING: No current frame manager when performing linear scan for " + functionName);
-        return;
-    }
-
-    // First, check if we have any intervals to process
-    if (intervals.empty()) {
-        debug_print("No intervals to process for function: " + functionName);
-        return;
-    }
-
-    // Check if the prologue has been generated, which finalized variable offsets
-    bool is_prologue_ready = false;
-    try {
-        // This is just a test to see if we can get offsets
-        if (!intervals.empty() && current_frame_manager_->has_local(intervals[0].var_name)) {
-            current_frame_manager_->get_offset(intervals[0].var_name);
-            is_prologue_ready = true;
-        }
-    } catch (const std::runtime_error& e) {
-        debug_print("WARNING: Prologue not yet generated, cannot determine stack offsets: " + std::string(e.what()));
-    }
-
-    // 1. Sort intervals by their starting point
-    std::vector<LiveInterval> sorted_intervals = intervals;
-    std::sort(sorted_intervals.begin(), sorted_intervals.end(),
-        [](const LiveInterval& a, const LiveInterval& b) {
-            return a.start_point < b.start_point;
-        });
-
-    // 2. Initialize state
-    std::vector<LiveInterval> active_int;  // Active intervals using int registers
-    std::vector<LiveInterval> active_fp;   // Active intervals using float registers
-
-    // Prioritize the use of callee-saved registers for variables
-    std::vector<std::string> free_int_registers = RegisterManager::VARIABLE_REGS;
-    std::vector<std::string> free_fp_registers = RegisterManager::FP_VARIABLE_REGS;
-
-    // Ensure FP_VARIABLE_REGS (D8-D15) are prioritized for floating-point variables
-    // By reversing the order, we'll use D8, D9, etc. first (which are callee-saved)
-    std::reverse(free_fp_registers.begin(), free_fp_registers.end());
-
-    debug_print("Available INT registers for allocation: " +
-                std::to_string(free_int_registers.size()));
-    debug_print("Available FP registers for allocation: " +
-                std::to_string(free_fp_registers.size()));
-
-    // Track assigned registers to avoid duplicates
-    std::unordered_map<std::string, bool> register_in_use;
-    for (const auto& reg : RegisterManager::VARIABLE_REGS) {
-        register_in_use[reg] = false;
-    }
-    for (const auto& reg : RegisterManager::FP_VARIABLE_REGS) {
-        register_in_use[reg] = false;
-    }
-
-    // Track maximum register pressure
-    size_t max_int_pressure = 0;
-    size_t max_fp_pressure = 0;
-
-    // 3. Main allocation loop
-    for (auto interval : sorted_intervals) {
-        debug_print("Processing interval for: " + interval.var_name +
-                    " (start=" + std::to_string(interval.start_point) +
-                    ", end=" + std::to_string(interval.end_point) + ")");
-
-        // Skip runtime functions or global variables that don't need register allocation
-        if (interval.var_name == "WRITES" || interval.var_name == "WRITEN" ||
-            interval.var_name == "WRITEF" || interval.var_name == "READN" ||
-            data_generator_.is_global_variable(interval.var_name)) {
-            debug_print("Skipping runtime function or global variable: " + interval.var_name);
-            continue;
-        }
-
-        // Make sure the variable is registered with the frame manager
-        if (!current_frame_manager_->has_local(interval.var_name)) {
-            debug_print("WARNING: Variable " + interval.var_name + " not registered in frame manager. Adding it.");
-            // Default to INTEGER if type is unknown
-            VarType type = ASTAnalyzer::getInstance().get_variable_type(current_function_name_, interval.var_name);
-            current_frame_manager_->add_local(interval.var_name, type);
-        }
-
-        // Determine if this variable is a float
-        VarType var_type = current_frame_manager_->get_variable_type(interval.var_name);
-        bool is_float = (var_type == VarType::FLOAT);
-
-        // Expire old intervals from appropriate active lists based on their register type
-        auto expire_intervals = [&interval, &register_in_use, this](
-            LiveInterval& active_interval, std::vector<std::string>& free_regs) {
-            if (active_interval.end_point < interval.start_point) {
-                debug_print("Expiring interval for: " + active_interval.var_name);
-                // Free the register
-                if (!active_interval.is_spilled) {
-                    free_regs.push_back(active_interval.assigned_register);
-                    register_in_use[active_interval.assigned_register] = false;
-                }
-                return true;
-            }
-            return false;
-        };
-
-        // Expire integer intervals
-        active_int.erase(
-            std::remove_if(active_int.begin(), active_int.end(),
-                [&expire_intervals, &free_int_registers](LiveInterval& active_interval) {
-                    return expire_intervals(active_interval, free_int_registers);
-                }
-            ),
-            active_int.end()
-        );
-
-        // Expire floating-point intervals
-        active_fp.erase(
-            std::remove_if(active_fp.begin(), active_fp.end(),
-                [&expire_intervals, &free_fp_registers](LiveInterval& active_interval) {
-                    return expire_intervals(active_interval, free_fp_registers);
-                }
-            ),
-            active_fp.end()
-        );
-
-        // Track register pressure
-        size_t int_pressure = active_int.size();
-        size_t fp_pressure = active_fp.size();
-        debug_print("Integer register pressure: " + std::to_string(int_pressure) +
-                    ", Float register pressure: " + std::to_string(fp_pressure));
-
-        // Update maximum pressure
-        max_int_pressure = std::max(max_int_pressure, int_pressure);
-        max_fp_pressure = std::max(max_fp_pressure, fp_pressure);
-
-        // Choose the appropriate register pool based on variable type
-        std::vector<std::string>& free_registers = is_float ? free_fp_registers : free_int_registers;
-        std::vector<LiveInterval>& active_list = is_float ? active_fp : active_int;
-
-        if (free_registers.empty()) {
-            // No free registers, need to spill
-            // Find the interval in active that has the longest remaining lifetime from current point
-            auto spill_candidate = std::max_element(active_list.begin(), active_list.end(),
-                [&interval](const LiveInterval& a, const LiveInterval& b) {
-                    // Consider remaining lifetime from current point (not total lifetime)
-                    size_t a_remaining = a.end_point - interval.start_point;
-                    size_t b_remaining = b.end_point - interval.start_point;
-                    return a_remaining < b_remaining;
-                });
-
-            if (spill_candidate != active_list.end() && spill_candidate->end_point > interval.end_point) {
-                // Spill the new interval
-                debug_print("Spilling new interval: " + interval.var_name +
-                            " (float=" + std::to_string(is_float) + ")");
-                interval.is_spilled = true;
-
-                // Only try to get stack offset if prologue is ready
-                if (is_prologue_ready) {
-                    try {
-                        interval.stack_offset = current_frame_manager_->get_offset(interval.var_name);
-                    } catch (const std::runtime_error& e) {
-                        // If there's an error, we'll set the offset later when the prologue is generated
-                        debug_print("Cannot get stack offset for " + interval.var_name + ": " + e.what());
-                        interval.stack_offset = -1;  // Mark as invalid
-                    }
-                } else {
-                    // We'll set the actual offset after prologue generation
-                    interval.stack_offset = -1;
-                }
-            } else {
-                // Spill the candidate with the longest remaining lifetime
-                debug_print("Spilling active interval: " + spill_candidate->var_name);
-                std::string freed_reg = spill_candidate->assigned_register;
-                spill_candidate->is_spilled = true;
-
-                // Only try to get stack offset if prologue is ready
-                if (is_prologue_ready) {
-                    try {
-                        spill_candidate->stack_offset = current_frame_manager_->get_offset(spill_candidate->var_name);
-                    } catch (const std::runtime_error& e) {
-                        debug_print("Cannot get stack offset for " + spill_candidate->var_name + ": " + e.what());
-                        spill_candidate->stack_offset = -1;  // Mark as invalid
-                    }
-                } else {
-                    spill_candidate->stack_offset = -1;
-                }
-
-                // Assign the freed register to our current interval
-                interval.assigned_register = freed_reg;
-                register_in_use[freed_reg] = true;
-            }
-        } else {
-            // We have a free register, assign it
-            std::string reg = free_registers.back();
-            free_registers.pop_back();
-            interval.assigned_register = reg;
-            register_in_use[reg] = true;
-
-            // If this is a float variable, make sure the register manager knows about it
-            if (is_float && current_frame_manager_) {
-                current_frame_manager_->set_variable_type(interval.var_name, VarType::FLOAT);
-            }
-
-            debug_print("Assigned register " + reg + " to " + interval.var_name +
-                        " (float=" + std::to_string(is_float) + ", reg_type=" +
-                        (reg[0] == 'D' ? "float" : "int") + ")");
-        }
-
-        // Add the current interval to the appropriate active list
-        if (is_float) {
-            active_fp.push_back(interval);
-        } else {
-            active_int.push_back(interval);
-        }
-
-        // Update our allocation map
-        current_function_allocation_[interval.var_name] = interval;
-    }
-
-    // Print allocation plan and register pressure stats for debugging
-    debug_print("Linear scan allocation complete for function: " + functionName);
-    debug_print("Maximum register pressure: INT=" + std::to_string(max_int_pressure) +
-                " (of " + std::to_string(RegisterManager::VARIABLE_REGS.size()) + "), " +
-                "FLOAT=" + std::to_string(max_fp_pressure) +
-                " (of " + std::to_string(RegisterManager::FP_VARIABLE_REGS.size()) + ")");
-
-    // Store the maximum pressure values for later reporting
-    max_int_pressure_ = std::max(max_int_pressure_, max_int_pressure);
-    max_fp_pressure_ = std::max(max_fp_pressure_, max_fp_pressure);
-
-    // Verify type consistency and print allocation details
-    for (const auto& [var_name, alloc] : current_function_allocation_) {
-        if (alloc.is_spilled) {
-            if (alloc.stack_offset != -1) {
-                debug_print("  " + var_name + " => SPILLED (stack offset: " + std::to_string(alloc.stack_offset) + ")");
-            } else {
-                debug_print("  " + var_name + " => SPILLED (stack offset pending prologue generation)");
-            }
-        } else {
-            // Verify type consistency
-            VarType var_type = current_frame_manager_->get_variable_type(var_name);
-            bool is_float = (var_type == VarType::FLOAT);
-            bool got_float_reg = (alloc.assigned_register[0] == 'D' || alloc.assigned_register[0] == 'S');
-
-            debug_print("  " + var_name + " => " + alloc.assigned_register +
-                       " (type=" + (is_float ? "float" : "int") + ")");
-
-            if (is_float != got_float_reg) {
-                debug_print("  WARNING: Type-register mismatch for " + var_name +
-                          ": expected " + (is_float ? "float" : "int") +
-                          " register, got " + alloc.assigned_register);
-            }
-        }
-    }
-}
-
 // Updates the stack offsets for all spilled variables after prologue generation
 void NewCodeGenerator::update_spill_offsets() {
 if (!current_frame_manager_) {
@@ -828,24 +570,48 @@ void NewCodeGenerator::handle_char_indirection_assignment(CharIndirection* char_
     generate_expression_code(*char_indirection->index_expr);
     std::string index_reg = expression_result_reg_;
 
+    std::string effective_addr_reg = register_manager_.get_free_register(*this);
+    std::string compact_label;
+    std::string done_label;
+    if (compact_strings_) {
+        compact_label = label_manager_.create_label();
+        done_label = label_manager_.create_label();
+        emit_compact_string_test(string_base_reg, compact_label);
+    }
+
     // 3. Calculate the byte offset: index * 4 (for 32-bit characters in BCPL)
     emit(Encoder::create_lsl_imm(index_reg, index_reg, 2));
     debug_print("Calculated byte offset for char indirection assignment.");
 
     // 4. Calculate the effective memory address: base + offset
-    std::string effective_addr_reg = register_manager_.get_free_register(*this);
     emit(Encoder::create_add_reg(effective_addr_reg, string_base_reg, index_reg));
     debug_print("Calculated effective address for char indirection assignment.");
 
-    // Release registers used for address calculation
-    register_manager_.release_register(string_base_reg);
-    register_manager_.release_register(index_reg);
-
     // 5. Store the RHS value to the effective address (using STR for 32-bit word for char)
     // FIX: Use the new 32-bit store instruction for character assignment
     emit(Encoder::create_str_word_imm(value_to_store_reg, effective_addr_reg, 0));
     debug_print("Stored value to character element.");
 
+    if (compact_strings_) {
+        // A compact string holds one Latin-1 byte per character. A wider
+        // character does not fit and halts, rather than losing its upper bits.
+        std::string fits_label = label_manager_.create_label();
+        emit(Encoder::create_branch_unconditional(done_label));
+        instruction_stream_.define_label(compact_label);
+        emit(Encoder::create_cmp_imm(value_to_store_reg, 0xFF));
+        emit(Encoder::create_branch_conditional("LS", fits_label));
+        emit(Encoder::create_brk(1)); // Character above 0xFF in a compact string
+        instruction_stream_.define_label(fits_label);
+        emit(Encoder::create_add_reg(effective_addr_reg, string_base_reg, index_reg));
+        std::string w_value_reg = (value_to_store_reg[0] == 'X' || value_to_store_reg[0] == 'x') ? "W" + value_to_store_reg.substr(1) : value_to_store_reg;
+        emit(Encoder::create_strb_imm(w_value_reg, effective_addr_reg, 0));
+        instruction_stream_.define_label(done_label);
+    }
+
+    // Release registers used for address calculation
+    register_manager_.release_register(string_base_reg);
+    register_manager_.release_register(index_reg);
+
     // Release registers used in the store
     register_manager_.release_register(value_to_store_reg);
     register_manager_.release_register(effective_addr_reg);
@@ -985,8 +751,17 @@ std::string NewCodeGenerator::get_variable_register(const std::string& var_name)
                             (is_float ? "float" : "int") + " but got register " + allocation.assigned_register);
             }
 
+            // Hand out a copy: expression code computes into its operand
+            // registers, which must not be the variable's home.
             debug_print("Variable '" + var_name + "' is in register: " + allocation.assigned_register);
-            return allocation.assigned_register;
+            if (got_float_reg) {
+                std::string reg = register_manager_.acquire_fp_scratch_reg();
+                emit(Encoder::create_fmov_reg(reg, allocation.assigned_register));
+                return reg;
+            }
+            Reg reg = register_manager_.acquire_scratch(*this);
+            emit(Encoder::create_mov_reg(reg, Reg::parse(allocation.assigned_register)));
+            return reg.str();
         } else {
             // Check if the stack offset is valid or still pending
             if (allocation.stack_offset != -1) {
@@ -1008,7 +783,7 @@ std::string NewCodeGenerator::get_variable_register(const std::string& var_name)
                     // In all these cases, the value being loaded from the stack is an integer-like
                     // address or value. It MUST be loaded into a general-purpose register.
                     std::string reg = register_manager_.acquire_spillable_temp_reg(*this);
-                    emit(Encoder::create_ldr_imm(reg, "X29", allocation.stack_offset, var_name));
+                    emit(Encoder::create_ldr_imm(Reg::parse(reg), Reg::fp(), allocation.stack_offset, var_name));
                     register_manager_.mark_dirty(reg, false); // Mark register as clean after load
                     debug_print("Loaded integer/pointer VALUE for '" + var_name + "' into " + reg);
                     return reg;
@@ -1035,7 +810,7 @@ std::string NewCodeGenerator::get_variable_register(const std::string& var_name)
                         // In all these cases, the value being loaded from the stack is an integer-like
                         // address or value. It MUST be loaded into a general-purpose register.
                         std::string reg = register_manager_.acquire_spillable_temp_reg(*this);
-                        emit(Encoder::create_ldr_imm(reg, "X29", offset, var_name));
+                        emit(Encoder::create_ldr_imm(Reg::parse(reg), Reg::fp(), offset, var_name));
                         register_manager_.mark_dirty(reg, false); // Mark register as clean after load
                         debug_print("Loaded integer/pointer VALUE for '" + var_name + "' into " + reg);
                         return reg;
@@ -1066,7 +841,7 @@ std::string NewCodeGenerator::get_variable_register(const std::string& var_name)
                 return reg;
             } else {
                 std::string reg = register_manager_.acquire_spillable_temp_reg(*this);
-                emit(Encoder::create_ldr_imm(reg, "X29", offset, var_name));
+                emit(Encoder::create_ldr_imm(Reg::parse(reg), Reg::fp(), offset, var_name));
                 register_manager_.mark_dirty(reg, false); // Mark register as clean after load
                 return reg;
             }
@@ -1085,7 +860,7 @@ std::string NewCodeGenerator::get_variable_register(const std::string& var_name)
                 return reg;
             } else {
                 std::string reg = register_manager_.acquire_spillable_temp_reg(*this);
-                emit(Encoder::create_ldr_imm(reg, "X28", offset * 8, var_name));
+                emit(Encoder::create_ldr_imm(Reg::parse(reg), RegisterManager::data_base_reg(), offset * 8, var_name));
                 register_manager_.mark_dirty(reg, false); // Mark register as clean after load
                 return reg;
             }
@@ -1137,7 +912,7 @@ std::string NewCodeGenerator::get_variable_register(const std::string& var_name)
         } else {
             reg = rm.acquire_spillable_temp_reg(*this);
             if (byte_offset <= MAX_LDR_OFFSET) {
-                emit(Encoder::create_ldr_imm(reg, "X28", byte_offset, var_name));
+                emit(Encoder::create_ldr_imm(Reg::parse(reg), RegisterManager::data_base_reg(), byte_offset, var_name));
             } else {
                 std::string offset_reg = rm.acquire_scratch_reg(*this);
                 std::string addr_reg = rm.acquire_scratch_reg(*this);
@@ -1235,7 +1010,7 @@ void NewCodeGenerator::store_variable_register(const std::string& var_name, cons
                     debug_print("Storing float VALUE from " + reg_to_store + " to stack offset " +
                                std::to_string(allocation.stack_offset) + " for '" + var_name + "'");
                 } else {
-                    emit(Encoder::create_str_imm(reg_to_store, "X29", allocation.stack_offset, var_name));
+                    emit(Encoder::create_str_imm(Reg::parse(reg_to_store), Reg::fp(), allocation.stack_offset, var_name));
                     debug_print("Storing integer/pointer VALUE from " + reg_to_store + " to stack offset " +
                                std::to_string(allocation.stack_offset) + " for '" + var_name + "'");
                 }
@@ -1271,7 +1046,7 @@ void NewCodeGenerator::store_variable_register(const std::string& var_name, cons
                     if (is_source_reg_float) {
                         emit(Encoder::create_str_fp_imm(reg_to_store, "X29", offset));
                     } else {
-                        emit(Encoder::create_str_imm(reg_to_store, "X29", offset, var_name));
+                        emit(Encoder::create_str_imm(Reg::parse(reg_to_store), Reg::fp(), offset, var_name));
                     }
 
                     // Update the allocation with the now-known offset
@@ -1333,7 +1108,7 @@ void NewCodeGenerator::store_variable_register(const std::string& var_name, cons
                     emit(Encoder::create_str_fp_imm(reg_to_store, "X29", new_interval.stack_offset));
                     debug_print("Spilled float variable '" + var_name + "' to stack offset: " + std::to_string(new_interval.stack_offset));
                 } else {
-                    emit(Encoder::create_str_imm(reg_to_store, "X29", new_interval.stack_offset, var_name));
+                    emit(Encoder::create_str_imm(Reg::parse(reg_to_store), Reg::fp(), new_interval.stack_offset, var_name));
                     debug_print("Spilled variable '" + var_name + "' to stack offset: " + std::to_string(new_interval.stack_offset));
                 }
                 return;
@@ -1356,7 +1131,7 @@ void NewCodeGenerator::store_variable_register(const std::string& var_name, cons
                 // Efficient and scalable path for large offsets
                 static constexpr size_t MAX_LDR_OFFSET = 4095 * 8; // 32,760 bytes
                 if (byte_offset <= MAX_LDR_OFFSET) {
-                    emit(Encoder::create_str_imm(reg_to_store, "X28", byte_offset, var_name));
+                    emit(Encoder::create_str_imm(Reg::parse(reg_to_store), RegisterManager::data_base_reg(), byte_offset, var_name));
                 } else {
                     std::string offset_reg = register_manager_.acquire_scratch_reg(*this);
                     std::string addr_reg = register_manager_.acquire_scratch_reg(*this);
@@ -1388,7 +1163,7 @@ void NewCodeGenerator::store_variable_register(const std::string& var_name, cons
             // Efficient and scalable path for large offsets
             static constexpr size_t MAX_LDR_OFFSET = 4095 * 8; // 32,760 bytes
             if (byte_offset <= MAX_LDR_OFFSET) {
-                emit(Encoder::create_str_imm(reg_to_store, "X28", byte_offset, var_name));
+                emit(Encoder::create_str_imm(Reg::parse(reg_to_store), RegisterManager::data_base_reg(), byte_offset, var_name));
             } else {
                 std::string offset_reg = register_manager_.acquire_scratch_reg(*this);
                 std::string addr_reg = register_manager_.acquire_scratch_reg(*this);
@@ -1509,6 +1284,18 @@ void NewCodeGenerator::generate_function_like_code(
     // -- END OF NEW LOGIC --
     enter_scope();
 
+    // --- Register allocation ---
+    // Reserve the registers RegisterAllocationPass assigned for the whole
+    // function, and have the prologue save the callee-saved ones.
+    static const std::map<std::string, LiveInterval> no_allocation;
+    const auto& allocation = register_allocation_ ? register_allocation_->get_allocation(name) : no_allocation;
+    for (const auto& [var_name, interval] : allocation) {
+        register_manager_.bind_allocated_register(interval.assigned_register, var_name);
+        if (Reg::parse(interval.assigned_register).is_callee_saved()) {
+            current_frame_manager_->force_save_register(interval.assigned_register);
+        }
+    }
+
     // --- HEURISTIC-BASED SPILL SLOT RESERVATION ---
     int max_live = 0;
     auto& metrics_map = ASTAnalyzer::getInstance().get_function_metrics();
@@ -1544,68 +1331,19 @@ void NewCodeGenerator::generate_function_like_code(
         emit(instr);
     }
 
-    // --- FIX STARTS HERE ---
-    // Prime the register allocator with the locations of incoming parameters.
-    debug_print("Priming register allocator with incoming parameter locations.");
-    if (function_metrics_it != analyzer.get_function_metrics().end()) {
-        const auto& metrics = function_metrics_it->second;
-        const auto& param_types = metrics.parameter_types;
-        for (size_t i = 0; i < parameters.size(); ++i) {
-            const std::string& param_name = parameters[i];
-            VarType ptype = VarType::INTEGER; // Default to integer
-            auto ptype_it = param_types.find(param_name);
-            if (ptype_it != param_types.end()) {
-                ptype = ptype_it->second;
-            }
-
-            LiveInterval param_interval;
-            param_interval.var_name = param_name;
-            param_interval.is_spilled = false; // It's in a register, not on the stack.
-            param_interval.start_point = 0; // It's live from the very start.
-            param_interval.end_point = 1000; // Liveness analysis will provide more accurate ranges later.
-
-            if (i < 8) {
-                if (ptype == VarType::FLOAT) {
-                    param_interval.assigned_register = "D" + std::to_string(i);
-                } else {
-                    param_interval.assigned_register = "X" + std::to_string(i);
-                }
-            } else {
-                // For >8 parameters, not handled in registers, so mark as spilled.
-                param_interval.is_spilled = true;
-                param_interval.assigned_register = "";
-            }
-
-            current_function_allocation_[param_name] = param_interval;
-            debug_print("  Primed '" + param_name + "' in register " + param_interval.assigned_register);
-        }
+    // Variables in registers take their assignment from the allocation pass.
+    // Parameters it left out are read back from the stack slots they are
+    // stored to below.
+    for (const auto& [var_name, interval] : allocation) {
+        current_function_allocation_[var_name] = interval;
+        debug_print("  Allocated '" + var_name + "' to register " + interval.assigned_register);
     }
-    // --- FIX ENDS HERE ---
-
-    // Now that the prologue is generated and offsets are finalized,
-    // store incoming arguments from registers to their stack slots.
-    if (function_metrics_it != analyzer.get_function_metrics().end()) {
-        const auto& metrics = function_metrics_it->second;
-        const auto& param_types = metrics.parameter_types;
-        for (size_t i = 0; i < parameters.size(); ++i) {
-            const std::string& param_name = parameters[i];
-            VarType ptype = VarType::INTEGER; // Default to integer
-            auto ptype_it = param_types.find(param_name);
-            if (ptype_it != param_types.end()) {
-                ptype = ptype_it->second;
-            }
-
-            // ARM64 calling convention: first 8 args in X0-X7 or D0-D7
-            if (i < 8) {
-                if (ptype == VarType::FLOAT) {
-                    emit(Encoder::create_str_fp_imm("D" + std::to_string(i), "X29", current_frame_manager_->get_offset(param_name)));
-                } else {
-                    emit(Encoder::create_str_imm("X" + std::to_string(i), "X29", current_frame_manager_->get_offset(param_name), param_name));
-                }
-            } else {
-                debug_print("Warning: More than 8 parameters are not handled for stack storage.");
-            }
-        }
+    for (const auto& param_name : parameters) {
+        if (current_function_allocation_.count(param_name)) continue;
+        LiveInterval param_interval;
+        param_interval.var_name = param_name;
+        param_interval.is_spilled = true;
+        current_function_allocation_[param_name] = param_interval;
     }
 
     // Update stack offsets for spilled variables now that the prologue has been generated
@@ -1676,6 +1414,19 @@ void NewCodeGenerator::generate_function_like_code(
         const std::string& param_name = parameters[i];
         int offset = current_frame_manager_->get_offset(param_name);
 
+        // A parameter with a register of its own is copied there instead.
+        auto alloc_it = current_function_allocation_.find(param_name);
+        if (alloc_it != current_function_allocation_.end() && !alloc_it->second.is_spilled) {
+            const std::string& home = alloc_it->second.assigned_register;
+            if (current_function_return_type_ == VarType::FLOAT) {
+                std::string arg_reg = "D" + std::to_string(i);
+                if (home != arg_reg) emit(Encoder::create_fmov_reg(home, arg_reg));
+            } else if (home != "X" + std::to_string(i)) {
+                emit(Encoder::create_mov_reg(Reg::parse(home), Reg::x(i)));
+            }
+            continue;
+        }
+
         // --- REVISED FIX IS HERE ---
         // The decision is now based on the function's return type, not the parameter's type.
         if (current_function_return_type_ == VarType::FLOAT) {
@@ -1685,7 +1436,7 @@ void NewCodeGenerator::generate_function_like_code(
         } else {
             // This is an integer function, so assume the argument was passed in an X register.
             std::string arg_reg = "X" + std::to_string(i);
-            emit(Encoder::create_str_imm(arg_reg, "X29", offset, param_name));
+            emit(Encoder::create_str_imm(Reg::parse(arg_reg), Reg::fp(), offset, param_name));
         }
         // --- END REVISED FIX ---
     }
@@ -1857,7 +1608,7 @@ void NewCodeGenerator::generate_block_epilogue(BasicBlock* block) {
 
             // Load current loop variable value
             std::string loop_var_reg = register_manager_.acquire_scratch_reg(*this);
-            emit(Encoder::create_ldr_imm(loop_var_reg, "X29", current_frame_manager_->get_offset(for_stmt->unique_loop_variable_name), for_stmt->unique_loop_variable_name));
+            emit(Encoder::create_ldr_imm(Reg::parse(loop_var_reg), Reg::fp(), current_frame_manager_->get_offset(for_stmt->unique_loop_variable_name), for_stmt->unique_loop_variable_name));
 
             // Evaluate end expression
             generate_expression_code(*for_stmt->end_expr);
@@ -23,6 +23,7 @@
 
 class LabelManager;
 class ASTAnalyzer;
+class RegisterAllocationPass;
 class Identifier;
 
 
@@ -67,6 +68,14 @@ public:
     // Returns true if this code generator is in JIT mode (not static/exec mode)
     bool is_jit_mode() const { return is_jit_mode_; }
 
+    // Register assignments to use for locals and parameters. Without one,
+    // every variable lives in its stack slot.
+    void set_register_allocation(const RegisterAllocationPass* allocation) { register_allocation_ = allocation; }
+
+    // With --compact-strings, character access checks each string's length
+    // word for the compact (one byte per character) flag.
+    void set_compact_strings(bool enabled) { compact_strings_ = enabled; }
+
 private:
     static constexpr size_t MAX_LDR_OFFSET = 4095 * 8; // 32,760 bytes
     bool is_jit_mode_ = false;
@@ -137,6 +146,7 @@ private:
     void visit(ResultisStatement& node) override;
     void visit(LabelTargetStatement& node) override;
     void visit(ConditionalBranchStatement& node) override;
+    void visit(PrefetchStatement& node) override;
     void visit(CompoundStatement& node) override;
     void visit(BlockStatement& node) override;
     void visit(StringStatement& node) override;
@@ -148,6 +158,7 @@ private:
     void handle_variable_assignment(VariableAccess* var_access, const std::string& value_to_store_reg);
     void handle_vector_assignment(VectorAccess* vec_access, const std::string& value_to_store_reg);
     void handle_char_indirection_assignment(CharIndirection* char_indirection, const std::string& value_to_store_reg);
+    void emit_compact_string_test(const std::string& string_base_reg, const std::string& compact_label);
     void handle_float_vector_indirection_assignment(FloatVectorIndirection* float_vec_indirection, const std::string& value_to_store_reg);
     void handle_indirection_assignment(UnaryOp* unary_op, const std::string& value_to_store_reg);
 
@@ -186,6 +197,11 @@ private:
     void generate_len_op_code(UnaryOp& node);
     void generate_float_op_code(UnaryOp& node);
     void generate_integer_op_code(UnaryOp& node);
+
+    // --- Runtime call helpers ---
+    void generate_map_call(const std::string& name, std::vector<ExprPtr>& arguments);
+    std::string hold_call_argument(const std::string& value_reg);
+    void reload_pushed_arguments(std::vector<std::string>& arg_regs);
     void debug_print(const std::string& message) const;
     void debug_print_level(const std::string& message, int level) const;
     bool is_local_variable(const std::string& name) const;
@@ -197,12 +213,12 @@ private:
     void process_declarations(const std::vector<DeclPtr>& declarations);
     void process_declaration(Declaration& decl);
 
-    // --- Linear Scan Register Allocation ---
-    void performLinearScan(const std::string& functionName, const std::vector<LiveInterval>& intervals);
+    // --- Register Allocation ---
+    // Per-function variable locations, seeded from register_allocation_.
+    const RegisterAllocationPass* register_allocation_ = nullptr;
+    bool compact_strings_ = false;
     void update_spill_offsets();
     std::map<std::string, LiveInterval> current_function_allocation_;
-    size_t max_int_pressure_ = 0;  // Maximum integer register pressure observed
-    size_t max_fp_pressure_ = 0;   // Maximum floating-point register pressure observed
     void generate_float_to_int_truncation(const std::string& dest_x_reg, const std::string& src_d_reg);
 
     // CFG-driven codegen helpers
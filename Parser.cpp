@@ -104,7 +104,7 @@ DeclPtr Parser::parse_toplevel_let_declaration() {
     bool is_float = check(TokenType::FLet);
     advance(); // Consume LET or FLET
 
-    std::string name = current_token_.value;
+    std::string name(current_token_.value);
     consume(TokenType::Identifier, "Expect identifier after LET/FLET.");
 
     if (check(TokenType::LParen)) {
@@ -113,7 +113,7 @@ DeclPtr Parser::parse_toplevel_let_declaration() {
         consume(TokenType::LParen, "Expect '(' after function name.");
         if (!check(TokenType::RParen)) {
             do {
-                params.push_back(current_token_.value);
+                params.emplace_back(current_token_.value);
                 consume(TokenType::Identifier, "Expect parameter name.");
             } while (match(TokenType::Comma));
         }
@@ -124,7 +124,7 @@ DeclPtr Parser::parse_toplevel_let_declaration() {
         std::vector<std::string> names;
         names.push_back(name);
         while (match(TokenType::Comma)) {
-            names.push_back(current_token_.value);
+            names.emplace_back(current_token_.value);
             consume(TokenType::Identifier, "Expect identifier after comma in LET/FLET.");
         }
 
@@ -156,7 +156,7 @@ void Parser::parse_let_construct() {
     bool is_float_declaration = check(TokenType::FLet);
     advance(); // Consume LET or FLET
 
-    std::string name = current_token_.value;
+    std::string name(current_token_.value);
     consume(TokenType::Identifier, "Expect identifier after LET/FLET.");
 
     // --- Lookahead Logic ---
@@ -166,7 +166,7 @@ void Parser::parse_let_construct() {
         consume(TokenType::LParen, "Expect '(' after function name.");
         if (!check(TokenType::RParen)) {
             do {
-                params.push_back(current_token_.value);
+                params.emplace_back(current_token_.value);
                 consume(TokenType::Identifier, "Expect parameter name.");
             } while (match(TokenType::Comma));
         }
@@ -179,7 +179,7 @@ void Parser::parse_let_construct() {
         std::vector<std::string> names;
         names.push_back(name);
         while (match(TokenType::Comma)) {
-            names.push_back(current_token_.value);
+            names.emplace_back(current_token_.value);
             consume(TokenType::Identifier, "Expect identifier after comma in LET/FLET list.");
         }
 
@@ -238,7 +238,7 @@ void Parser::advance() {
     while (true) {
         current_token_ = lexer_.get_next_token();
         if (current_token_.type != TokenType::Error) break;
-        error("Lexical error: " + current_token_.value);
+        error("Lexical error: " + std::string(current_token_.value));
     }
 }
 
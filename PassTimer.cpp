@@ -0,0 +1,208 @@
+#include "PassTimer.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+#include <sys/resource.h>
+
+#ifdef BCPL_COUNT_ALLOCATIONS
+
+namespace {
+
+std::atomic<uint64_t> g_allocation_count{0};
+std::atomic<uint64_t> g_allocated_bytes{0};
+
+} // namespace
+
+// Global allocation counting for --time-passes. The array and nothrow forms
+// forward here; the aligned forms are left to the library and not counted.
+void* operator new(std::size_t size) {
+    g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+    g_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (size == 0) size = 1;
+    while (true) {
+        if (void* p = std::malloc(size)) return p;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+#endif // BCPL_COUNT_ALLOCATIONS
+
+PassTimer& PassTimer::instance() {
+    static PassTimer instance;
+    return instance;
+}
+
+#ifdef BCPL_COUNT_ALLOCATIONS
+
+bool PassTimer::counts_allocations() {
+    return true;
+}
+
+uint64_t PassTimer::allocation_count() {
+    return g_allocation_count.load(std::memory_order_relaxed);
+}
+
+uint64_t PassTimer::allocated_bytes() {
+    return g_allocated_bytes.load(std::memory_order_relaxed);
+}
+
+#else
+
+bool PassTimer::counts_allocations() {
+    return false;
+}
+
+uint64_t PassTimer::allocation_count() {
+    return 0;
+}
+
+uint64_t PassTimer::allocated_bytes() {
+    return 0;
+}
+
+#endif // BCPL_COUNT_ALLOCATIONS
+
+uint64_t PassTimer::peak_rss_kb() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return static_cast<uint64_t>(usage.ru_maxrss) / 1024; // Bytes on macOS.
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss);        // Kilobytes on Linux.
+#endif
+}
+
+PassTimer::Scope::Scope(PassTimer* timer, const char* name) : timer_(timer), name_(name) {
+    if (!timer_) return;
+    start_allocations_ = allocation_count();
+    start_bytes_ = allocated_bytes();
+    start_ = std::chrono::steady_clock::now();
+}
+
+PassTimer::Scope::Scope(Scope&& other) noexcept
+    : timer_(other.timer_), name_(other.name_), start_(other.start_),
+      start_allocations_(other.start_allocations_), start_bytes_(other.start_bytes_) {
+    other.timer_ = nullptr;
+}
+
+void PassTimer::Scope::stop() {
+    if (!timer_) return;
+    auto end = std::chrono::steady_clock::now();
+    double wall_ms = std::chrono::duration<double, std::milli>(end - start_).count();
+    timer_->record(name_, wall_ms, allocation_count() - start_allocations_, allocated_bytes() - start_bytes_);
+    timer_ = nullptr;
+}
+
+void PassTimer::record(const char* name, double wall_ms, uint64_t allocations, uint64_t bytes) {
+    // A phase that runs more than once accumulates into one row.
+    for (Phase& phase : phases_) {
+        if (phase.name == name) {
+            phase.wall_ms += wall_ms;
+            phase.allocations += allocations;
+            phase.allocated_bytes += bytes;
+            phase.peak_rss_kb = peak_rss_kb();
+            return;
+        }
+    }
+    phases_.push_back({name, wall_ms, allocations, bytes, peak_rss_kb()});
+}
+
+void PassTimer::print_report(std::ostream& out) const {
+    double total_ms = 0;
+    uint64_t total_allocations = 0;
+    uint64_t total_bytes = 0;
+    for (const Phase& phase : phases_) {
+        total_ms += phase.wall_ms;
+        total_allocations += phase.allocations;
+        total_bytes += phase.allocated_bytes;
+    }
+
+    std::ios_base::fmtflags flags = out.flags();
+    out << "===-------------------------------------------------------------------------===\n"
+        << "                          Pass execution timing report\n"
+        << "===-------------------------------------------------------------------------===\n"
+        << std::setw(11) << "Wall (ms)" << std::setw(8) << "%" << std::setw(12) << "Allocs"
+        << std::setw(14) << "Alloc (KB)" << std::setw(15) << "Peak RSS (KB)" << "  Pass\n";
+    bool counted = counts_allocations();
+    auto row = [&](const std::string& name, double ms, uint64_t allocations, uint64_t bytes, uint64_t rss) {
+        out << std::fixed << std::setprecision(3) << std::setw(11) << ms << std::setprecision(1) << std::setw(8)
+            << (total_ms > 0 ? 100.0 * ms / total_ms : 0.0);
+        if (counted) {
+            out << std::setw(12) << allocations << std::setw(14) << bytes / 1024;
+        } else {
+            out << std::setw(12) << "-" << std::setw(14) << "-";
+        }
+        out << std::setw(15) << rss << "  " << name << "\n";
+    };
+    for (const Phase& phase : phases_) {
+        row(phase.name, phase.wall_ms, phase.allocations, phase.allocated_bytes, phase.peak_rss_kb);
+    }
+    row("Total", total_ms, total_allocations, total_bytes, peak_rss_kb());
+    out.flags(flags);
+}
+
+namespace {
+
+void write_json_string(std::ostream& out, const std::string& text) {
+    out << '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out << escaped;
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+} // namespace
+
+void PassTimer::write_json(std::ostream& out) const {
+    double total_ms = 0;
+    uint64_t total_allocations = 0;
+    uint64_t total_bytes = 0;
+    // Allocation figures are null in builds that do not count them.
+    bool counted = counts_allocations();
+    auto allocation_fields = [&](uint64_t allocations, uint64_t bytes) {
+        if (counted) {
+            out << ", \"allocations\": " << allocations << ", \"allocated_bytes\": " << bytes;
+        } else {
+            out << ", \"allocations\": null, \"allocated_bytes\": null";
+        }
+    };
+
+    std::ios_base::fmtflags flags = out.flags();
+    out << std::fixed << std::setprecision(3);
+    out << "{\n  \"passes\": [";
+    for (size_t i = 0; i < phases_.size(); ++i) {
+        const Phase& phase = phases_[i];
+        total_ms += phase.wall_ms;
+        total_allocations += phase.allocations;
+        total_bytes += phase.allocated_bytes;
+        out << (i ? ",\n" : "\n") << "    {\"name\": ";
+        write_json_string(out, phase.name);
+        out << ", \"wall_ms\": " << phase.wall_ms;
+        allocation_fields(phase.allocations, phase.allocated_bytes);
+        out << ", \"peak_rss_kb\": " << phase.peak_rss_kb << "}";
+    }
+    out << "\n  ],\n  \"total\": {\"wall_ms\": " << total_ms;
+    allocation_fields(total_allocations, total_bytes);
+    out << ", \"peak_rss_kb\": " << peak_rss_kb() << "}\n}\n";
+    out.flags(flags);
+}
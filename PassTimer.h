@@ -0,0 +1,89 @@
+#ifndef PASS_TIMER_H
+#define PASS_TIMER_H
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Records wall time, peak resident set size and, in builds that count them,
+// heap allocations for each compiler phase. Enabled by --time-passes; when
+// disabled, a timed phase only tests the flag as it starts and ends.
+//
+//     {
+//         auto timing = PassTimer::instance().time("Liveness Analysis");
+//         liveness_analyzer.run();
+//     }
+//
+// Allocations are counted by a global operator new in PassTimer.cpp, so
+// they cover everything the phase allocates through new, including the
+// standard containers. It adds two atomic increments to every allocation,
+// whether or not --time-passes is given, so it is only compiled in with
+// BCPL_COUNT_ALLOCATIONS (./build.sh --clean --count-allocations). Other
+// builds report no allocation figures.
+class PassTimer {
+public:
+    static PassTimer& instance();
+
+    void set_enabled(bool enabled) { enabled_ = enabled; }
+    bool is_enabled() const { return enabled_; }
+
+    struct Phase {
+        std::string name;
+        double wall_ms = 0;
+        uint64_t allocations = 0;
+        uint64_t allocated_bytes = 0;
+        uint64_t peak_rss_kb = 0; // Process peak at the end of the phase.
+    };
+
+    // Times a phase until the returned object goes out of scope or is stopped.
+    class Scope {
+    public:
+        Scope(Scope&& other) noexcept;
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        ~Scope() { stop(); }
+
+        // Ends the phase early. Later calls do nothing.
+        void stop();
+
+    private:
+        friend class PassTimer;
+        Scope(PassTimer* timer, const char* name);
+
+        PassTimer* timer_;
+        const char* name_;
+        std::chrono::steady_clock::time_point start_;
+        uint64_t start_allocations_ = 0;
+        uint64_t start_bytes_ = 0;
+    };
+
+    Scope time(const char* name) { return Scope(enabled_ ? this : nullptr, name); }
+
+    const std::vector<Phase>& phases() const { return phases_; }
+
+    // Human-readable table, one row per phase in the order they ran.
+    void print_report(std::ostream& out) const;
+    // The same data as a JSON object, for tracking throughput over time.
+    void write_json(std::ostream& out) const;
+
+    // True when built with BCPL_COUNT_ALLOCATIONS.
+    static bool counts_allocations();
+    // Totals since startup, maintained by the global operator new; zero
+    // unless counts_allocations().
+    static uint64_t allocation_count();
+    static uint64_t allocated_bytes();
+    // Peak resident set size of the process in kilobytes.
+    static uint64_t peak_rss_kb();
+
+private:
+    PassTimer() = default;
+
+    void record(const char* name, double wall_ms, uint64_t allocations, uint64_t bytes);
+
+    bool enabled_ = false;
+    std::vector<Phase> phases_;
+};
+
+#endif // PASS_TIMER_H
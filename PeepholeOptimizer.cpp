@@ -1,18 +1,23 @@
 #include "PeepholeOptimizer.h"
 #include "optimizer/PeepholePatterns.h"
+#include "optimizer/PeepholeRules.h"
 #include "InstructionComparator.h" // Now using the new comparator
 #include "InstructionDecoder.h" // For instruction decoding utilities
 #include <iostream>
 #include <cassert>
 #include <regex>
 #include <sstream>
+#include <chrono>
+#include <algorithm>
 
 // InstructionPattern implementation
 InstructionPattern::InstructionPattern(size_t pattern_size, MatcherFunction matcher_func,
                                        std::function<std::vector<Instruction>(const std::vector<Instruction>&, size_t)> transformer_func,
-                                       std::string description)
+                                       std::string description,
+                                       OpcodeList first_opcodes)
     : pattern_size_(pattern_size), matcher_(std::move(matcher_func)),
-      transformer_(std::move(transformer_func)), description_(std::move(description)) {}
+      transformer_(std::move(transformer_func)), description_(std::move(description)),
+      first_opcodes_(std::move(first_opcodes)) {}
 
 MatchResult InstructionPattern::matches(const std::vector<Instruction>& instructions, size_t position) const {
     // Use the matcher function to determine if the pattern matches
@@ -28,26 +33,11 @@ std::vector<Instruction> InstructionPattern::transform(const std::vector<Instruc
 PeepholeOptimizer::PeepholeOptimizer(bool enable_tracing)
     : enable_tracing_(enable_tracing) {
 
-        // 1. Simplification and Constant Folding Pass
-        addPattern(PeepholePatterns::createConstantFoldingPattern());
-        addPattern(PeepholePatterns::createIdentityOperationEliminationPattern());
-        addPattern(PeepholePatterns::createRedundantMovePattern());
-        addPattern(PeepholePatterns::createSelfMoveEliminationPattern());
-        addPattern(PeepholePatterns::createAdrFusionPattern());
-
-        // 2. Strength Reduction Pass
-        addPattern(PeepholePatterns::createStrengthReductionPattern());
-        addPattern(PeepholePatterns::createMultiplyByPowerOfTwoPattern());
-        addPattern(PeepholePatterns::createDivideByPowerOfTwoPattern());
-
-        // 3. Memory Optimization Pass
-        addPattern(PeepholePatterns::createLoadAfterStorePattern());
-        addPattern(PeepholePatterns::createRedundantLoadEliminationPattern());
-        addPattern(PeepholePatterns::createDeadStorePattern());
-        addPattern(PeepholePatterns::createRedundantStorePattern());
-
-        // 4. Control Flow Optimization Pass
-        addPattern(PeepholePatterns::createCompareZeroBranchPattern());
+        // Simplification, strength reduction, address fusion and memory
+        // optimizations are declarative rules in optimizer/PeepholeRules.cpp,
+        // matched through one decision tree before the patterns below.
+
+        // Control Flow Optimization Pass
         addPattern(PeepholePatterns::createBranchChainingPattern());
 
 }
@@ -59,6 +49,7 @@ void PeepholeOptimizer::addPattern(std::unique_ptr<InstructionPattern> pattern)
 void PeepholeOptimizer::optimize(InstructionStream& instruction_stream, int max_passes) {
     // Reset statistics
     stats_.clear();
+    buildDispatchTable();
 
     // Get a copy of the instructions that we can modify
     std::vector<Instruction> instructions = instruction_stream.get_instructions();
@@ -67,28 +58,11 @@ void PeepholeOptimizer::optimize(InstructionStream& instruction_stream, int max_
     if (enable_tracing_) {
         std::cout << "\n=== Peephole Optimization ===\n";
         std::cout << "Analyzing " << instructions.size() << " ARM64 instructions...\n";
-        std::cout << "Maximum optimization passes: " << max_passes << "\n";
+        std::cout << "Rewrite budget: " << max_passes << " per instruction\n";
     }
 
-    // Apply exactly max_passes optimization passes
-    int pass_count = 0;
-    int total_changes = 0;
-
-    while (pass_count < max_passes) {
-        bool changes_made = applyOptimizationPass(instructions);
-        pass_count++;
-
-        if (changes_made) {
-            total_changes++;
-        }
-        if (!changes_made) {
-                   break; // Exit early if the code is stable
-        }
-        if (enable_tracing_) {
-            trace("Completed pass " + std::to_string(pass_count) + "/" + std::to_string(max_passes) +
-                  ", changes made: " + (changes_made ? "yes" : "no"));
-        }
-    }
+    size_t rewrite_budget = static_cast<size_t>(std::max(max_passes, 0)) * (instructions.size() + 1);
+    size_t rewrites = applyOptimizations(instructions, rewrite_budget);
 
     // Replace the original instructions with the optimized ones
     instruction_stream.replace_instructions(instructions);
@@ -97,9 +71,11 @@ void PeepholeOptimizer::optimize(InstructionStream& instruction_stream, int max_
     stats_.total_instructions_after = static_cast<int>(instructions.size());
 
     if (enable_tracing_) {
-        std::cout << "Peephole optimization completed " << pass_count << " \n";
-        std::cout << "  Passes with changes: " << total_changes << "\n";
-        std::cout << "Peephole optimization completed " << pass_count << " passes:\n";
+        std::cout << "Peephole optimization completed with " << rewrites << " rewrites";
+        if (rewrites >= rewrite_budget) {
+            std::cout << " (budget exhausted)";
+        }
+        std::cout << ":\n";
         std::cout << "  Instructions before: " << stats_.total_instructions_before << "\n";
         std::cout << "  Instructions after:  " << stats_.total_instructions_after << "\n";
         std::cout << "  Total optimizations: " << stats_.optimizations_applied << "\n";
@@ -112,83 +88,209 @@ void PeepholeOptimizer::optimize(InstructionStream& instruction_stream, int max_
         } else {
             std::cout << "  No optimization patterns matched\n";
         }
+        std::cout << "  Pattern timings:\n";
+        for (const auto& [pattern, timing] : stats_.pattern_timings) {
+            std::cout << "    - " << pattern << ": " << timing.attempts << " attempts, "
+                      << timing.total_us << " us\n";
+        }
         std::cout << "==============================\n";
         trace("Detailed peephole optimization trace complete");
     }
 }
 
-bool PeepholeOptimizer::applyOptimizationPass(std::vector<Instruction>& instructions) {
-    bool any_changes = false;
-    size_t pos = 0;
+void PeepholeOptimizer::buildDispatchTable() {
+    size_t table_size = 0;
+    max_pattern_size_ = PeepholeRules::kMaxRuleLength;
+    for (const auto& pattern : patterns_) {
+        for (auto op : pattern->getFirstOpcodes()) {
+            table_size = std::max(table_size, static_cast<size_t>(op) + 1);
+        }
+        max_pattern_size_ = std::max(max_pattern_size_, pattern->getSize());
+    }
 
-    while (pos < instructions.size()) {
-        // Only attempt to optimize instructions that are part of the CODE segment.
-        // Skip over any instructions intended for RODATA or DATA segments.
-        if (instructions[pos].segment != SegmentType::CODE) {
-            pos++;
-            continue; // Skip to the next instruction
+    patterns_by_opcode_.assign(table_size, {});
+    any_opcode_patterns_.clear();
+    for (size_t index = 0; index < patterns_.size(); ++index) {
+        const auto& opcodes = patterns_[index]->getFirstOpcodes();
+        if (opcodes.empty()) {
+            any_opcode_patterns_.push_back(index);
+            for (auto& candidates : patterns_by_opcode_) {
+                candidates.push_back(index);
+            }
+            continue;
+        }
+        for (auto op : opcodes) {
+            auto& candidates = patterns_by_opcode_[static_cast<size_t>(op)];
+            if (candidates.empty() || candidates.back() != index) {
+                candidates.push_back(index);
+            }
         }
+    }
+}
 
-        bool applied_optimization = false;
+/**
+ * @brief Runs every pattern over the instructions in one left-to-right sweep.
+ *
+ * The vector is used as a gap buffer: [0, done) holds finished output and
+ * [next, size) holds instructions still to be examined, with blank slots in
+ * between. Patterns always match at 'next', so they see the pending
+ * instructions as a contiguous run, and a rewrite only touches the slots
+ * around the gap. After a rewrite the sweep steps back far enough for the
+ * longest pattern to match across the new instructions, so the result
+ * reaches a fixed point without rescanning the whole function.
+ */
+size_t PeepholeOptimizer::applyOptimizations(std::vector<Instruction>& instructions, size_t rewrite_budget) {
+    using Clock = std::chrono::steady_clock;
+
+    size_t done = 0;
+    size_t next = 0;
+    size_t rewrites = 0;
+    std::vector<PatternTiming> timings(patterns_.size());
+    PatternTiming rule_timing;
+    const bool timed = enable_tracing_ || collect_timings_;
+    auto elapsed_us = [](Clock::time_point start) {
+        return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    };
+
+    // Moves the instruction at 'next' to the end of the finished output.
+    auto advance = [&]() {
+        if (done != next) {
+            instructions[done] = instructions[next];
+            instructions[next] = Instruction();
+        }
+        ++done;
+        ++next;
+    };
+
+    // Moves the last finished instruction back in front of 'next'.
+    auto retreat = [&]() {
+        --done;
+        --next;
+        if (done != next) {
+            instructions[next] = instructions[done];
+            instructions[done] = Instruction();
+        }
+    };
 
-        // Skip special instructions (labels, directives, etc.)
-        if (isSpecialInstruction(instructions[pos])) {
-            pos++;
+    while (next < instructions.size()) {
+        const Instruction& instr = instructions[next];
+
+        // Only attempt to optimize instructions that are part of the CODE segment,
+        // and skip special instructions (labels, directives, etc.)
+        if (instr.segment != SegmentType::CODE || isSpecialInstruction(instr) || rewrites >= rewrite_budget) {
+            advance();
             continue;
         }
 
-        // Try each pattern
-        for (const auto& pattern : patterns_) {
-            MatchResult result = pattern->matches(instructions, pos);
-            if (result.matched) {
-                // Check if applying this optimization would break any label references
-                if (wouldBreakLabelReferences(instructions, pos, result.length,
-                                             pattern->transform(instructions, pos))) {
-                    continue;  // Skip this pattern if it would break references
-                }
-
-                // Apply the pattern's transformation
-                std::vector<Instruction> replacements = pattern->transform(instructions, pos);
+        // Rewrites the 'length' instructions at 'next' and steps back so the
+        // neighbourhood of the change is examined again.
+        auto commit = [&](const std::string& description, size_t length,
+                          const std::vector<Instruction>& replacements) {
+            // Update statistics
+            stats_.optimizations_applied++;
+            stats_.pattern_matches[description]++;
+
+            if (enable_tracing_) {
+                std::vector<Instruction> original_instructions(
+                    instructions.begin() + next, instructions.begin() + next + length);
+                traceOptimization(description, original_instructions, replacements, done);
+            }
+
+            // Drop the matched instructions into the gap...
+            for (size_t i = 0; i < length; ++i) {
+                instructions[next++] = Instruction();
+            }
+
+            // ...widen the gap if the replacements do not fit...
+            size_t gap = next - done;
+            if (gap < replacements.size()) {
+                size_t grow = std::max(replacements.size() - gap, instructions.size() / 8 + 16);
+                instructions.insert(instructions.begin() + done, grow, Instruction());
+                next += grow;
+            }
+
+            // ...and queue the replacements to be examined next.
+            next -= replacements.size();
+            std::copy(replacements.begin(), replacements.end(), instructions.begin() + next);
+
+            for (size_t i = 1; i < max_pattern_size_ && done > 0; ++i) {
+                retreat();
+            }
+            rewrites++;
+        };
+
+        // Declarative rules first, through the decision tree.
+        std::vector<Instruction> replacements;
+        size_t rule_length = 0;
+        size_t matched_rule = 0;
+        Clock::time_point start;
+        if (timed) start = Clock::now();
+        bool rule_matched = PeepholeRules::forEachMatch(instructions, next, [&](size_t rule, size_t length) {
+            replacements = PeepholeRules::rewrite(rule, instructions, next);
+            // Skip rewrites that would break label references or change nothing
+            if (wouldBreakLabelReferences(instructions, next, length) ||
+                isNoOpRewrite(instructions, next, length, replacements)) {
+                return false;
+            }
+            matched_rule = rule;
+            rule_length = length;
+            return true;
+        });
+        rule_timing.attempts++;
+        if (timed) rule_timing.total_us += elapsed_us(start);
+        if (rule_matched) {
+            commit(PeepholeRules::ruleDescription(matched_rule), rule_length, replacements);
+            continue;
+        }
 
-                // Update statistics
-                stats_.optimizations_applied++;
-                stats_.pattern_matches[pattern->getDescription()]++;
+        // Then the patterns that are not expressible as rules.
+        size_t op = static_cast<size_t>(instr.opcode);
+        const std::vector<size_t>& candidates =
+            op < patterns_by_opcode_.size() ? patterns_by_opcode_[op] : any_opcode_patterns_;
 
-                // Get the original instructions for tracing
-                std::vector<Instruction> original_instructions;
-                for (size_t i = 0; i < result.length; i++) {
-                    original_instructions.push_back(instructions[pos + i]);
-                }
+        bool applied_optimization = false;
+        for (size_t index : candidates) {
+            const InstructionPattern& pattern = *patterns_[index];
+            PatternTiming& timing = timings[index];
 
-                // Use enhanced tracing to show detailed before/after
-                if (enable_tracing_) {
-                    traceOptimization(
-                        pattern->getDescription(),
-                        original_instructions,
-                        replacements,
-                        pos
-                    );
-                }
+            if (timed) start = Clock::now();
+            MatchResult result = pattern.matches(instructions, next);
+            timing.attempts++;
+            if (!result.matched || result.length == 0 || next + result.length > instructions.size()) {
+                if (timed) timing.total_us += elapsed_us(start);
+                continue;
+            }
 
-                // Replace the original instructions with the optimized ones
-                instructions.erase(instructions.begin() + pos,
-                                  instructions.begin() + pos + result.length);
-                instructions.insert(instructions.begin() + pos,
-                                   replacements.begin(), replacements.end());
+            replacements = pattern.transform(instructions, next);
+            if (timed) timing.total_us += elapsed_us(start);
 
-                applied_optimization = true;
-                any_changes = true;
-                break;  // Break out of the pattern loop
+            // Skip rewrites that would break label references or change nothing
+            if (wouldBreakLabelReferences(instructions, next, result.length) ||
+                isNoOpRewrite(instructions, next, result.length, replacements)) {
+                continue;
             }
+
+            commit(pattern.getDescription(), result.length, replacements);
+            applied_optimization = true;
+            break;
         }
 
-        // If no optimization was applied, move to the next instruction
         if (!applied_optimization) {
-            pos++;
+            advance();
         }
     }
 
-    return any_changes;
+    instructions.resize(done);
+
+    PatternTiming& rules_total = stats_.pattern_timings["Declarative rules (decision tree)"];
+    rules_total.attempts += rule_timing.attempts;
+    rules_total.total_us += rule_timing.total_us;
+    for (size_t index = 0; index < patterns_.size(); ++index) {
+        PatternTiming& total = stats_.pattern_timings[patterns_[index]->getDescription()];
+        total.attempts += timings[index].attempts;
+        total.total_us += timings[index].total_us;
+    }
+    return rewrites;
 }
 
 void PeepholeOptimizer::trace(const std::string& message) const {
@@ -267,10 +369,27 @@ bool PeepholeOptimizer::isSpecialInstruction(const Instruction& instr) {
            assembly.empty() || assembly[0] == ';' || assembly[0] == '.';
 }
 
-bool PeepholeOptimizer::wouldBreakLabelReferences(
+bool PeepholeOptimizer::isNoOpRewrite(
     const std::vector<Instruction>& instructions,
     size_t start_pos, size_t count,
-    const std::vector<Instruction>& replacements) const {
+    const std::vector<Instruction>& replacements) {
+    if (replacements.size() != count) {
+        return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+        const Instruction& before = instructions[start_pos + i];
+        const Instruction& after = replacements[i];
+        if (before.encoding != after.encoding || before.assembly_text != after.assembly_text ||
+            before.target_label != after.target_label || before.branch_target != after.branch_target) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool PeepholeOptimizer::wouldBreakLabelReferences(
+    const std::vector<Instruction>& instructions,
+    size_t start_pos, size_t count) const {
 
     // Check if any of the instructions being replaced has a label reference
     for (size_t i = 0; i < count && (start_pos + i) < instructions.size(); i++) {
@@ -873,7 +992,7 @@ std::unique_ptr<InstructionPattern> PeepholeOptimizer::createSelfMoveElimination
             }
             return {false, 0};
         },
-        [](const std::vector<Instruction>& instrs, size_t pos) -> std::vector<Instruction> {
+        [](const std::vector<Instruction>&, size_t) -> std::vector<Instruction> {
             // Return an empty vector to remove the instruction
             return {};
         },
@@ -22,10 +22,15 @@ struct MatchResult {
 class InstructionPattern {
 public:
     using MatcherFunction = std::function<MatchResult(const std::vector<Instruction>&, size_t)>;
+    using OpcodeList = std::vector<InstructionDecoder::OpType>;
 
+    // first_opcodes lists the opcodes the first matched instruction can have.
+    // The optimizer only tries the pattern at instructions with one of those
+    // opcodes; an empty list means the pattern is tried everywhere.
     InstructionPattern(size_t pattern_size, MatcherFunction matcher_func,
                       std::function<std::vector<Instruction>(const std::vector<Instruction>&, size_t)> transformer_func,
-                      std::string description);
+                      std::string description,
+                      OpcodeList first_opcodes = {});
 
     // Check if pattern matches at the given position in the instruction stream
     MatchResult matches(const std::vector<Instruction>& instructions, size_t position) const;
@@ -39,11 +44,15 @@ public:
     // Get the description of this optimization pattern
     const std::string& getDescription() const { return description_; }
 
+    // Get the opcodes this pattern can start with (empty for any opcode)
+    const OpcodeList& getFirstOpcodes() const { return first_opcodes_; }
+
 private:
     size_t pattern_size_;
     MatcherFunction matcher_;
     std::function<std::vector<Instruction>(const std::vector<Instruction>&, size_t)> transformer_;
     std::string description_;
+    OpcodeList first_opcodes_;
 };
 
 // Main peephole optimizer class
@@ -53,24 +62,37 @@ public:
 
     // Apply optimizations to the instruction stream
     // @param instruction_stream The stream of instructions to optimize
-    // @param max_passes Maximum number of optimization passes to run (default: 5)
+    // @param max_passes Bounds the work done: at most max_passes rewrites per
+    //        instruction on average (default: 5)
     void optimize(InstructionStream& instruction_stream, int max_passes = 5);
 
     // Add a new optimization pattern
     void addPattern(std::unique_ptr<InstructionPattern> pattern);
 
+    // Times each pattern attempt even when tracing is off, for getStats().
+    // Off by default: reading the clock costs more than most attempts.
+    void set_collect_timings(bool enabled) { collect_timings_ = enabled; }
+
     // Get statistics about optimizations applied
+    struct PatternTiming {
+        long attempts = 0;      // Times the matcher was called
+        double total_us = 0.0;  // Time spent matching and transforming; only
+                                // measured when tracing or collecting timings
+    };
+
     struct OptimizationStats {
         int total_instructions_before;
         int total_instructions_after;
         int optimizations_applied;
         std::unordered_map<std::string, int> pattern_matches;
+        std::unordered_map<std::string, PatternTiming> pattern_timings;
 
         void clear() {
             total_instructions_before = 0;
             total_instructions_after = 0;
             optimizations_applied = 0;
             pattern_matches.clear();
+            pattern_timings.clear();
         }
     };
 
@@ -104,15 +126,34 @@ public:
     static std::unique_ptr<InstructionPattern>createRedundantIndexCalculationPattern();
     static std::unique_ptr<InstructionPattern>createLoadStoreForwardingPatternSimple();
     static std::unique_ptr<InstructionPattern>createAdjacentLoadStoreForwardingPattern();
+    static std::unique_ptr<InstructionPattern> createRedundantStorePattern();
+    static std::unique_ptr<InstructionPattern> createAdrFusionPattern();
+    static std::unique_ptr<InstructionPattern> createSelfMoveEliminationPattern();
 
 
 private:
     std::vector<std::unique_ptr<InstructionPattern>> patterns_;
     OptimizationStats stats_;
     bool enable_tracing_;
+    bool collect_timings_ = false;
+
+    // Candidate patterns (indices into patterns_, in registration order)
+    // for each opcode. Opcodes past the end of the table use any_opcode_.
+    std::vector<std::vector<size_t>> patterns_by_opcode_;
+    std::vector<size_t> any_opcode_patterns_;
+    size_t max_pattern_size_ = 1;
+
+    // Rebuilds the opcode dispatch table from patterns_
+    void buildDispatchTable();
+
+    // Rewrites the instructions to a fixed point in a single sweep, revisiting
+    // only the neighbourhood of each rewrite. Returns the number of rewrites.
+    size_t applyOptimizations(std::vector<Instruction>& instructions, size_t rewrite_budget);
 
-    // Helper method to apply a single pass of optimization
-    bool applyOptimizationPass(std::vector<Instruction>& instructions);
+    // Check if a rewrite would reproduce the matched instructions unchanged
+    static bool isNoOpRewrite(const std::vector<Instruction>& instructions,
+                              size_t start_pos, size_t count,
+                              const std::vector<Instruction>& replacements);
 
     // Helper method to trace optimizations when enabled
     void trace(const std::string& message) const;
@@ -128,8 +169,7 @@ private:
 
     // Check if an optimization would affect label references
     bool wouldBreakLabelReferences(const std::vector<Instruction>& instructions,
-                                  size_t start_pos, size_t count,
-                                  const std::vector<Instruction>& replacements) const;
+                                  size_t start_pos, size_t count) const;
 
     // Declaration for copy propagation pattern
     static std::unique_ptr<InstructionPattern> createCopyPropagationPattern();
@@ -0,0 +1,69 @@
+#include "Register.h"
+#include <cstdio>
+
+namespace {
+
+char lower(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+bool equals_lower(const char* text, size_t length, const char* word) {
+    size_t i = 0;
+    for (; i < length && word[i]; ++i) {
+        if (lower(text[i]) != word[i]) return false;
+    }
+    return i == length && word[i] == '\0';
+}
+
+// Names for every (class, number) pair, built once on first use.
+struct NameTable {
+    char names[8][32][5] = {};
+
+    NameTable() {
+        const char prefixes[8] = {'?', 'X', 'W', 'X', 'W', 'D', 'S', 'V'};
+        for (int cls = 0; cls < 8; ++cls) {
+            for (int num = 0; num < 32; ++num) {
+                std::snprintf(names[cls][num], sizeof(names[cls][num]), "%c%d", prefixes[cls], num);
+            }
+        }
+        std::snprintf(names[static_cast<int>(RegClass::X)][31], 5, "XZR");
+        std::snprintf(names[static_cast<int>(RegClass::W)][31], 5, "WZR");
+        std::snprintf(names[static_cast<int>(RegClass::SP)][31], 5, "SP");
+        std::snprintf(names[static_cast<int>(RegClass::WSP)][31], 5, "WSP");
+    }
+};
+
+} // namespace
+
+Reg Reg::parse(const char* text, size_t length) {
+    if (length < 2 || length > 3) return Reg();
+
+    if (equals_lower(text, length, "sp")) return sp();
+    if (equals_lower(text, length, "wsp")) return wsp();
+    if (equals_lower(text, length, "xzr")) return xzr();
+    if (equals_lower(text, length, "wzr")) return wzr();
+
+    RegClass cls;
+    switch (lower(text[0])) {
+        case 'x': cls = RegClass::X; break;
+        case 'w': cls = RegClass::W; break;
+        case 'd': cls = RegClass::D; break;
+        case 's': cls = RegClass::S; break;
+        case 'v': cls = RegClass::V; break;
+        default: return Reg();
+    }
+
+    unsigned num = 0;
+    for (size_t i = 1; i < length; ++i) {
+        if (text[i] < '0' || text[i] > '9') return Reg();
+        num = num * 10 + static_cast<unsigned>(text[i] - '0');
+    }
+    if (num > 31) return Reg();
+    return Reg(cls, static_cast<uint8_t>(num));
+}
+
+const char* Reg::name() const {
+    static const NameTable table;
+    if (!valid()) return "?";
+    return table.names[static_cast<int>(cls)][num];
+}
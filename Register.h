@@ -0,0 +1,66 @@
+#ifndef REGISTER_H
+#define REGISTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Register class of a typed register operand. XZR and WZR are number 31 of
+// X and W; SP and WSP are separate classes because they print differently.
+enum class RegClass : uint8_t { None, X, W, SP, WSP, D, S, V };
+
+// A typed ARM64 register: a class and a 5-bit number, two bytes in all.
+// Code generators can pass Reg values straight to the Encoder instead of
+// building and re-parsing register names for every operand.
+struct Reg {
+    RegClass cls = RegClass::None;
+    uint8_t num = 0;
+
+    constexpr Reg() = default;
+    constexpr Reg(RegClass c, uint8_t n) : cls(c), num(n) {}
+
+    static constexpr Reg x(unsigned n) { return Reg(RegClass::X, static_cast<uint8_t>(n)); }
+    static constexpr Reg w(unsigned n) { return Reg(RegClass::W, static_cast<uint8_t>(n)); }
+    static constexpr Reg d(unsigned n) { return Reg(RegClass::D, static_cast<uint8_t>(n)); }
+    static constexpr Reg s(unsigned n) { return Reg(RegClass::S, static_cast<uint8_t>(n)); }
+    static constexpr Reg v(unsigned n) { return Reg(RegClass::V, static_cast<uint8_t>(n)); }
+    static constexpr Reg sp() { return Reg(RegClass::SP, 31); }
+    static constexpr Reg wsp() { return Reg(RegClass::WSP, 31); }
+    static constexpr Reg xzr() { return Reg(RegClass::X, 31); }
+    static constexpr Reg wzr() { return Reg(RegClass::W, 31); }
+    static constexpr Reg fp() { return x(29); }
+    static constexpr Reg lr() { return x(30); }
+
+    // Parses a register name ("X10", "w3", "sp", "XZR", "D0", "v7") without
+    // allocating. Matching is case-insensitive. Returns an invalid Reg if the
+    // text is not a register name.
+    static Reg parse(const char* text, size_t length);
+    static Reg parse(const std::string& text) { return parse(text.data(), text.size()); }
+
+    constexpr bool valid() const { return cls != RegClass::None && num < 32; }
+    // The 5-bit hardware encoding.
+    constexpr uint32_t encoding() const { return num; }
+    // True for the general-purpose classes (X, W, SP, WSP).
+    constexpr bool is_general() const {
+        return cls == RegClass::X || cls == RegClass::W || cls == RegClass::SP || cls == RegClass::WSP;
+    }
+    // True for 64-bit general-purpose registers (X and SP).
+    constexpr bool is_64bit() const { return cls == RegClass::X || cls == RegClass::SP; }
+    constexpr bool is_fp() const { return cls == RegClass::D || cls == RegClass::S; }
+    constexpr bool is_vector() const { return cls == RegClass::V; }
+    // True for registers a callee must preserve under AAPCS64: X19-X28 and
+    // the low halves of V8-V15.
+    constexpr bool is_callee_saved() const {
+        return (is_general() && num >= 19 && num <= 28) || (is_fp() && num >= 8 && num <= 15);
+    }
+
+    // Canonical upper-case name, e.g. "X10", "SP", "XZR", "D3". Points into a
+    // static table, so it is valid for the life of the program.
+    const char* name() const;
+    std::string str() const { return name(); }
+
+    friend constexpr bool operator==(Reg a, Reg b) { return a.cls == b.cls && a.num == b.num; }
+    friend constexpr bool operator!=(Reg a, Reg b) { return !(a == b); }
+};
+
+#endif // REGISTER_H
@@ -0,0 +1,614 @@
+#include "RegisterAllocationPass.h"
+#include "AST.h"
+#include "analysis/ASTAnalyzer.h"
+#include <algorithm>
+#include <climits>
+#include <iostream>
+#include <set>
+#include <unordered_map>
+
+namespace {
+
+// Callee-saved registers available to the allocator, in order of preference.
+// They are taken from the top of RegisterManager's variable pools so that the
+// code generator's temporaries, which scan those pools from the bottom, keep
+// X20/X21 and D8/D9.
+constexpr Reg kIntRegs[] = {Reg::x(27), Reg::x(26), Reg::x(25), Reg::x(24), Reg::x(23), Reg::x(22)};
+constexpr Reg kFloatRegs[] = {Reg::d(15), Reg::d(14), Reg::d(13), Reg::d(12), Reg::d(11), Reg::d(10)};
+constexpr int kPoolSize = 6;
+constexpr int kArgumentRegs = 8;
+
+// Each statement occupies two positions. A use in statement i keeps the
+// variable live to the end of it and a def makes it live from the start, so
+// the operands of one statement never share a register.
+constexpr int kStatementWidth = 2;
+
+// Half-open [from, to).
+struct Range {
+    int from;
+    int to;
+};
+
+struct Interval {
+    uint32_t var = 0;
+    std::vector<Range> ranges; // Sorted and disjoint once built.
+    bool is_float = false;
+    int param_index = -1;
+    bool crosses_call = false;
+    double weight = 0;
+    int reg = -1;             // Index into the pool, or -1.
+    bool spilled = false;
+
+    int start() const { return ranges.front().from; }
+    int end() const { return ranges.back().to; }
+
+    bool covers(int pos) const {
+        for (const Range& r : ranges) {
+            if (pos < r.from) return false;
+            if (pos < r.to) return true;
+        }
+        return false;
+    }
+
+    // First position covered by both intervals, or -1.
+    int next_intersection(const Interval& other) const {
+        size_t i = 0, j = 0;
+        while (i < ranges.size() && j < other.ranges.size()) {
+            const Range& a = ranges[i];
+            const Range& b = other.ranges[j];
+            if (a.to <= b.from) {
+                ++i;
+            } else if (b.to <= a.from) {
+                ++j;
+            } else {
+                return std::max(a.from, b.from);
+            }
+        }
+        return -1;
+    }
+};
+
+// What the allocator needs to know about one statement.
+struct StatementFacts {
+    bool may_call = false; // Calls out, or sets up X0-X7 for a call.
+    bool modeled = true;   // Every node is one the liveness pass visits fully.
+};
+
+// Variables the code generator reads or writes through their stack slot
+// directly: address-taken locals and FOR loop control variables.
+using NameSet = std::set<std::string>;
+
+void scan_expression(const Expression* expr, StatementFacts& facts, NameSet& memory);
+
+void scan_expressions(const std::vector<ExprPtr>& exprs, StatementFacts& facts, NameSet& memory) {
+    for (const auto& expr : exprs) scan_expression(expr.get(), facts, memory);
+}
+
+void scan_expression(const Expression* expr, StatementFacts& facts, NameSet& memory) {
+    if (!expr) return;
+    using Type = ASTNode::NodeType;
+    switch (expr->getType()) {
+        case Type::NumberLit:
+        case Type::StringLit:
+        case Type::CharLit:
+        case Type::BooleanLit:
+            return;
+        case Type::VariableAccessExpr: {
+            const auto* var = static_cast<const VariableAccess*>(expr);
+            if (!var->unique_name.empty()) {
+                memory.insert(var->name);
+                memory.insert(var->unique_name);
+            }
+            return;
+        }
+        case Type::BinaryOpExpr: {
+            const auto* op = static_cast<const BinaryOp*>(expr);
+            scan_expression(op->left.get(), facts, memory);
+            scan_expression(op->right.get(), facts, memory);
+            return;
+        }
+        case Type::UnaryOpExpr: {
+            const auto* op = static_cast<const UnaryOp*>(expr);
+            using Op = UnaryOp::Operator;
+            if (op->op == Op::AddressOf && op->operand &&
+                op->operand->getType() == Type::VariableAccessExpr) {
+                memory.insert(static_cast<const VariableAccess*>(op->operand.get())->name);
+            }
+            // The list operators go through the runtime.
+            if (op->op == Op::HeadOf || op->op == Op::HeadOfAsFloat || op->op == Op::TailOf ||
+                op->op == Op::TailOfNonDestructive || op->op == Op::LengthOf || op->op == Op::TypeOf) {
+                facts.may_call = true;
+            }
+            scan_expression(op->operand.get(), facts, memory);
+            return;
+        }
+        case Type::VectorAccessExpr: {
+            // List element access calls the runtime.
+            const auto* access = static_cast<const VectorAccess*>(expr);
+            facts.may_call = true;
+            scan_expression(access->vector_expr.get(), facts, memory);
+            scan_expression(access->index_expr.get(), facts, memory);
+            return;
+        }
+        case Type::CharIndirectionExpr: {
+            const auto* access = static_cast<const CharIndirection*>(expr);
+            scan_expression(access->string_expr.get(), facts, memory);
+            scan_expression(access->index_expr.get(), facts, memory);
+            return;
+        }
+        case Type::FloatVectorIndirectionExpr: {
+            const auto* access = static_cast<const FloatVectorIndirection*>(expr);
+            scan_expression(access->vector_expr.get(), facts, memory);
+            scan_expression(access->index_expr.get(), facts, memory);
+            return;
+        }
+        case Type::FunctionCallExpr: {
+            const auto* call = static_cast<const FunctionCall*>(expr);
+            facts.may_call = true;
+            scan_expression(call->function_expr.get(), facts, memory);
+            scan_expressions(call->arguments, facts, memory);
+            return;
+        }
+        case Type::SysCallExpr: {
+            const auto* call = static_cast<const SysCall*>(expr);
+            facts.may_call = true;
+            scan_expression(call->syscall_number.get(), facts, memory);
+            scan_expressions(call->arguments, facts, memory);
+            return;
+        }
+        case Type::ConditionalExpr: {
+            const auto* cond = static_cast<const ConditionalExpression*>(expr);
+            scan_expression(cond->condition.get(), facts, memory);
+            scan_expression(cond->true_expr.get(), facts, memory);
+            scan_expression(cond->false_expr.get(), facts, memory);
+            return;
+        }
+        case Type::VecAllocationExpr:
+            facts.may_call = true;
+            scan_expression(static_cast<const VecAllocationExpression*>(expr)->size_expr.get(), facts, memory);
+            return;
+        case Type::StringAllocationExpr:
+            facts.may_call = true;
+            scan_expression(static_cast<const StringAllocationExpression*>(expr)->size_expr.get(), facts, memory);
+            return;
+        case Type::TableExpr:
+            facts.may_call = true;
+            scan_expressions(static_cast<const TableExpression*>(expr)->initializers, facts, memory);
+            return;
+        default:
+            // VALOF, LIST, bitfields and the rest carry statements or operands
+            // the liveness pass does not see.
+            facts.modeled = false;
+            return;
+    }
+}
+
+StatementFacts scan_statement(const Statement* stmt, NameSet& memory) {
+    StatementFacts facts;
+    if (!stmt) return facts;
+    using Type = ASTNode::NodeType;
+    switch (stmt->getType()) {
+        case Type::AssignmentStmt: {
+            const auto* assign = static_cast<const AssignmentStatement*>(stmt);
+            scan_expressions(assign->lhs, facts, memory);
+            scan_expressions(assign->rhs, facts, memory);
+            break;
+        }
+        case Type::RoutineCallStmt: {
+            const auto* call = static_cast<const RoutineCallStatement*>(stmt);
+            facts.may_call = true;
+            scan_expression(call->routine_expr.get(), facts, memory);
+            scan_expressions(call->arguments, facts, memory);
+            break;
+        }
+        case Type::IfStmt:
+            scan_expression(static_cast<const IfStatement*>(stmt)->condition.get(), facts, memory);
+            break;
+        case Type::UnlessStmt:
+            scan_expression(static_cast<const UnlessStatement*>(stmt)->condition.get(), facts, memory);
+            break;
+        case Type::TestStmt:
+            scan_expression(static_cast<const TestStatement*>(stmt)->condition.get(), facts, memory);
+            break;
+        case Type::WhileStmt:
+            scan_expression(static_cast<const WhileStatement*>(stmt)->condition.get(), facts, memory);
+            break;
+        case Type::UntilStmt:
+            scan_expression(static_cast<const UntilStatement*>(stmt)->condition.get(), facts, memory);
+            break;
+        case Type::ForStmt: {
+            // The header compares the loop variable through its stack slot.
+            const auto* loop = static_cast<const ForStatement*>(stmt);
+            memory.insert(loop->loop_variable);
+            memory.insert(loop->unique_loop_variable_name);
+            memory.insert(loop->unique_step_variable_name);
+            memory.insert(loop->unique_end_variable_name);
+            scan_expression(loop->end_expr.get(), facts, memory);
+            break;
+        }
+        case Type::SwitchonStmt:
+            scan_expression(static_cast<const SwitchonStatement*>(stmt)->expression.get(), facts, memory);
+            break;
+        case Type::ConditionalBranchStmt:
+            scan_expression(static_cast<const ConditionalBranchStatement*>(stmt)->condition_expr.get(), facts, memory);
+            break;
+        case Type::PrefetchStmt:
+            scan_expression(static_cast<const PrefetchStatement*>(stmt)->address_expr.get(), facts, memory);
+            break;
+        case Type::GotoStmt: {
+            // Liveness does not look at the target, so keep a computed target in memory.
+            const auto* jump = static_cast<const GotoStatement*>(stmt);
+            if (jump->label_expr && jump->label_expr->getType() == Type::VariableAccessExpr) {
+                memory.insert(static_cast<const VariableAccess*>(jump->label_expr.get())->name);
+            } else if (jump->label_expr) {
+                facts.modeled = false;
+            }
+            break;
+        }
+        case Type::ResultisStmt:
+            // The result is moved to X0/D0 after the expression is evaluated.
+            scan_expression(static_cast<const ResultisStatement*>(stmt)->expression.get(), facts, memory);
+            break;
+        case Type::FinishStmt: {
+            const auto* finish = static_cast<const FinishStatement*>(stmt);
+            facts.may_call = true;
+            scan_expression(finish->syscall_number.get(), facts, memory);
+            scan_expressions(finish->arguments, facts, memory);
+            break;
+        }
+        case Type::FreeStmt:
+            facts.may_call = true;
+            scan_expression(static_cast<const FreeStatement*>(stmt)->list_expr.get(), facts, memory);
+            break;
+        case Type::ReturnStmt:
+        case Type::BreakStmt:
+        case Type::LoopStmt:
+        case Type::EndcaseStmt:
+        case Type::LabelTargetStmt:
+            break;
+        default:
+            facts.modeled = false;
+            break;
+    }
+    return facts;
+}
+
+// Adds [from, to) to an interval whose ranges are being built back to front
+// (stored in reverse), merging with the most recent range where they touch.
+void add_range(Interval& interval, int from, int to) {
+    if (!interval.ranges.empty() && to >= interval.ranges.back().from) {
+        Range& last = interval.ranges.back();
+        last.from = std::min(last.from, from);
+        last.to = std::max(last.to, to);
+    } else {
+        interval.ranges.push_back({from, to});
+    }
+}
+
+// Loop nesting depth of each block in the given order, from back edges in
+// that order. Only used to weight spill costs.
+std::vector<int> loop_depths(const std::vector<BasicBlock*>& order) {
+    std::unordered_map<const BasicBlock*, size_t> index;
+    for (size_t i = 0; i < order.size(); ++i) index[order[i]] = i;
+    std::vector<int> depth(order.size(), 0);
+    for (size_t i = 0; i < order.size(); ++i) {
+        for (const BasicBlock* succ : order[i]->successors) {
+            auto it = index.find(succ);
+            if (it == index.end() || it->second > i) continue;
+            for (size_t j = it->second; j <= i; ++j) ++depth[j];
+        }
+    }
+    return depth;
+}
+
+// Linear scan with lifetime holes over one register pool. An interval gets a
+// register only if it is free for the whole interval; otherwise the cheaper
+// of the interval and the intervals holding the best register is spilled.
+void linear_scan(std::vector<Interval*>& intervals) {
+    std::sort(intervals.begin(), intervals.end(), [](const Interval* a, const Interval* b) {
+        return a->start() != b->start() ? a->start() < b->start() : a->var < b->var;
+    });
+
+    std::vector<Interval*> active;
+    std::vector<Interval*> inactive;
+    auto erase = [](std::vector<Interval*>& list, Interval* interval) {
+        list.erase(std::find(list.begin(), list.end(), interval));
+    };
+
+    for (Interval* current : intervals) {
+        int pos = current->start();
+
+        for (size_t i = 0; i < active.size();) {
+            Interval* it = active[i];
+            if (it->end() <= pos) {
+                active.erase(active.begin() + i);
+            } else if (!it->covers(pos)) {
+                inactive.push_back(it);
+                active.erase(active.begin() + i);
+            } else {
+                ++i;
+            }
+        }
+        for (size_t i = 0; i < inactive.size();) {
+            Interval* it = inactive[i];
+            if (it->end() <= pos) {
+                inactive.erase(inactive.begin() + i);
+            } else if (it->covers(pos)) {
+                active.push_back(it);
+                inactive.erase(inactive.begin() + i);
+            } else {
+                ++i;
+            }
+        }
+
+        int free_until[kPoolSize];
+        std::fill(free_until, free_until + kPoolSize, INT_MAX);
+        for (const Interval* it : active) free_until[it->reg] = 0;
+        for (const Interval* it : inactive) {
+            int next = it->next_intersection(*current);
+            if (next >= 0) free_until[it->reg] = std::min(free_until[it->reg], next);
+        }
+
+        int reg = static_cast<int>(std::max_element(free_until, free_until + kPoolSize) - free_until);
+        if (free_until[reg] >= current->end()) {
+            current->reg = reg;
+            active.push_back(current);
+            continue;
+        }
+
+        // Every register is taken somewhere in the interval. Find the
+        // register whose conflicting holders are cheapest to spill.
+        double cost[kPoolSize] = {};
+        for (const Interval* it : active) cost[it->reg] += it->weight;
+        for (const Interval* it : inactive) {
+            if (it->next_intersection(*current) >= 0) cost[it->reg] += it->weight;
+        }
+        reg = static_cast<int>(std::min_element(cost, cost + kPoolSize) - cost);
+        if (cost[reg] >= current->weight) {
+            current->spilled = true;
+            continue;
+        }
+
+        std::vector<Interval*> evicted;
+        for (Interval* it : active) {
+            if (it->reg == reg) evicted.push_back(it);
+        }
+        for (Interval* it : inactive) {
+            if (it->reg == reg && it->next_intersection(*current) >= 0) evicted.push_back(it);
+        }
+        for (Interval* it : evicted) {
+            if (std::find(active.begin(), active.end(), it) != active.end()) {
+                erase(active, it);
+            } else {
+                erase(inactive, it);
+            }
+            it->reg = -1;
+            it->spilled = true;
+        }
+        current->reg = reg;
+        active.push_back(current);
+    }
+}
+
+} // namespace
+
+RegisterAllocationPass::RegisterAllocationPass(const LivenessAnalysisPass::CFGMap& cfgs,
+                                               LivenessAnalysisPass& liveness, bool trace_enabled)
+    : cfgs_(cfgs), liveness_(liveness), trace_enabled_(trace_enabled) {}
+
+void RegisterAllocationPass::run() {
+    results_.clear();
+    for (const auto& pair : cfgs_) {
+        if (pair.second) allocate_function(pair.first);
+    }
+}
+
+void RegisterAllocationPass::allocate_function(const std::string& name) {
+    FunctionResult& result = results_[name];
+    Stats& stats = result.stats;
+
+    const auto& metrics_map = ASTAnalyzer::getInstance().get_function_metrics();
+    auto metrics_it = metrics_map.find(name);
+    if (metrics_it == metrics_map.end()) return;
+    const FunctionMetrics& metrics = metrics_it->second;
+
+    const std::vector<BasicBlock*>& order = liveness_.get_block_order(name);
+    const std::vector<std::string>& variables = liveness_.get_variables(name);
+
+    // Arguments arrive in D registers for float functions and X registers
+    // otherwise; see generate_function_like_code.
+    bool float_arguments = false;
+    const auto& return_types = ASTAnalyzer::getInstance().get_function_return_types();
+    auto return_it = return_types.find(name);
+    if (return_it != return_types.end()) float_arguments = (return_it->second == VarType::FLOAT);
+
+    // Candidates are the function's own locals and parameters.
+    std::vector<Interval> intervals(variables.size());
+    std::vector<bool> candidate(variables.size(), false);
+    for (size_t id = 0; id < variables.size(); ++id) {
+        const std::string& var = variables[id];
+        intervals[id].var = static_cast<uint32_t>(id);
+        auto param_it = metrics.parameter_indices.find(var);
+        if (param_it != metrics.parameter_indices.end()) {
+            auto type_it = metrics.parameter_types.find(var);
+            intervals[id].is_float = type_it != metrics.parameter_types.end() && type_it->second == VarType::FLOAT;
+            intervals[id].param_index = param_it->second;
+            candidate[id] = true;
+            continue;
+        }
+        auto type_it = metrics.variable_types.find(var);
+        if (type_it != metrics.variable_types.end()) {
+            intervals[id].is_float = (type_it->second == VarType::FLOAT);
+            candidate[id] = true;
+        }
+    }
+
+    // Build the ranges back to front: blocks in reverse order, statements in
+    // reverse within each block.
+    std::vector<int> block_from(order.size());
+    int next_pos = 0;
+    for (size_t b = 0; b < order.size(); ++b) {
+        block_from[b] = next_pos;
+        next_pos += kStatementWidth * std::max<int>(1, static_cast<int>(order[b]->statements.size()));
+    }
+    std::vector<int> depth = loop_depths(order);
+    std::vector<int> call_positions;
+    NameSet memory;
+    bool modeled = true;
+    BitVector use;
+    BitVector def;
+    BitVector live;
+
+    for (size_t b = order.size(); b-- > 0;) {
+        BasicBlock* block = order[b];
+        int from = block_from[b];
+        int to = from + kStatementWidth * std::max<int>(1, static_cast<int>(block->statements.size()));
+        double use_weight = 1;
+        for (int d = 0; d < std::min(depth[b], 3); ++d) use_weight *= 8;
+
+        live.clear();
+        if (const BitVector* out = liveness_.get_out_bits(block)) live.union_with(*out);
+        live.for_each([&](size_t id) { add_range(intervals[id], from, to); });
+
+        for (size_t i = block->statements.size(); i-- > 0;) {
+            Statement* stmt = block->statements[i].get();
+            if (!stmt) continue;
+            int pos = from + kStatementWidth * static_cast<int>(i);
+            StatementFacts facts = scan_statement(stmt, memory);
+            modeled = modeled && facts.modeled;
+            liveness_.get_statement_use_def(name, *stmt, use, def);
+
+            // Variables live after the statement and also before it are
+            // carried across any call the statement makes.
+            BitVector live_after;
+            if (facts.may_call) {
+                live_after = live;
+                call_positions.push_back(pos + 1);
+            }
+
+            def.for_each([&](size_t id) {
+                if (live.test(id)) {
+                    intervals[id].ranges.back().from = pos;
+                } else {
+                    add_range(intervals[id], pos, pos + kStatementWidth);
+                }
+                intervals[id].weight += use_weight;
+                live.reset(id);
+            });
+            use.for_each([&](size_t id) {
+                add_range(intervals[id], from, pos + kStatementWidth);
+                intervals[id].weight += use_weight;
+                live.set(id);
+            });
+
+            if (facts.may_call) {
+                live_after.for_each([&](size_t id) {
+                    if (live.test(id)) intervals[id].crosses_call = true;
+                });
+            }
+        }
+    }
+
+    stats.call_sites = static_cast<int>(call_positions.size());
+    if (!modeled) {
+        stats.skipped = true;
+        if (trace_enabled_) {
+            std::cout << "[RegisterAllocationPass] " << name << ": not allocated (unmodeled statements)" << std::endl;
+        }
+        return;
+    }
+
+    std::vector<Interval*> int_intervals;
+    std::vector<Interval*> float_intervals;
+    std::set<int> used_int_regs;
+    std::set<int> used_float_regs;
+    for (Interval& interval : intervals) {
+        const std::string& var = variables[interval.var];
+        if (!candidate[interval.var] || interval.ranges.empty() || memory.count(var)) continue;
+        std::reverse(interval.ranges.begin(), interval.ranges.end());
+        ++stats.candidates;
+        if (interval.crosses_call) ++stats.crossing_calls;
+        // Spill cost per position: short, busy intervals are kept first.
+        interval.weight /= static_cast<double>(interval.end() - interval.start());
+
+        if (interval.param_index >= 0) {
+            // A parameter passed in the other register class is read back
+            // through its stack slot, as before.
+            if (interval.param_index >= kArgumentRegs || interval.is_float != float_arguments) {
+                ++stats.spilled;
+                continue;
+            }
+            bool call_inside = false;
+            for (int call : call_positions) {
+                if (interval.covers(call)) {
+                    call_inside = true;
+                    break;
+                }
+            }
+            if (!call_inside) {
+                LiveInterval& out = result.allocation[var];
+                out = LiveInterval(var, interval.start(), interval.end());
+                out.assigned_register = interval.is_float ? Reg::d(interval.param_index).str()
+                                                          : Reg::x(interval.param_index).str();
+                ++stats.in_argument_registers;
+                continue;
+            }
+        }
+        (interval.is_float ? float_intervals : int_intervals).push_back(&interval);
+    }
+
+    linear_scan(int_intervals);
+    linear_scan(float_intervals);
+
+    for (const std::vector<Interval*>* list : {&int_intervals, &float_intervals}) {
+        for (const Interval* interval : *list) {
+            if (interval->spilled) {
+                ++stats.spilled;
+                continue;
+            }
+            const std::string& var = variables[interval->var];
+            Reg reg = interval->is_float ? kFloatRegs[interval->reg] : kIntRegs[interval->reg];
+            (interval->is_float ? used_float_regs : used_int_regs).insert(interval->reg);
+            LiveInterval& out = result.allocation[var];
+            out = LiveInterval(var, interval->start(), interval->end());
+            out.assigned_register = reg.str();
+            ++stats.in_registers;
+        }
+    }
+    stats.callee_saved_used = static_cast<int>(used_int_regs.size() + used_float_regs.size());
+
+    if (trace_enabled_) {
+        std::cout << "[RegisterAllocationPass] " << name << ": " << stats.in_registers << " in registers, "
+                  << stats.in_argument_registers << " in argument registers, " << stats.spilled << " spilled"
+                  << std::endl;
+    }
+}
+
+const std::map<std::string, LiveInterval>& RegisterAllocationPass::get_allocation(const std::string& function_name) const {
+    auto it = results_.find(function_name);
+    return it != results_.end() ? it->second.allocation : empty_allocation_;
+}
+
+const RegisterAllocationPass::Stats& RegisterAllocationPass::get_stats(const std::string& function_name) const {
+    auto it = results_.find(function_name);
+    return it != results_.end() ? it->second.stats : empty_stats_;
+}
+
+void RegisterAllocationPass::print_results() const {
+    for (const auto& pair : results_) {
+        const Stats& stats = pair.second.stats;
+        std::cout << "\nRegister Allocation for function: " << pair.first << "\n";
+        std::cout << "-------------------------------------------\n";
+        if (stats.skipped) {
+            std::cout << "  (not allocated: function contains statements the allocator does not model)\n";
+            continue;
+        }
+        for (const auto& alloc : pair.second.allocation) {
+            std::cout << "  " << alloc.first << " => " << alloc.second.assigned_register << " ["
+                      << alloc.second.start_point << ", " << alloc.second.end_point << ")\n";
+        }
+        std::cout << "  Call sites: " << stats.call_sites << ", candidates: " << stats.candidates
+                  << ", live across calls: " << stats.crossing_calls << ", spilled: " << stats.spilled
+                  << ", callee-saved registers: " << stats.callee_saved_used << "\n";
+    }
+}
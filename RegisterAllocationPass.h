@@ -0,0 +1,66 @@
+#pragma once
+
+#include "LivenessAnalysisPass.h"
+#include "Register.h"
+#include "analysis/LiveInterval.h"
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Assigns registers to the local variables and parameters of each function.
+//
+// Live ranges are built per statement from the liveness results, over the
+// blocks in the liveness block order. A range has holes where the variable
+// is dead, so two variables share a register whenever their ranges do not
+// overlap. Every statement that may call out (a function or routine call, or
+// a runtime helper such as GETVEC or a list access) is a call site.
+//
+// Variables are allocated by linear scan over the callee-saved registers, so
+// a value in a register survives every call. X20/X21 and D8/D9 are left to
+// the code generator for temporaries. A parameter whose range contains no
+// call site stays in the argument register it arrived in. Variables the
+// allocator cannot place stay in their stack slots, as does every variable
+// of a function containing constructs the pass does not model.
+class RegisterAllocationPass {
+public:
+    RegisterAllocationPass(const LivenessAnalysisPass::CFGMap& cfgs, LivenessAnalysisPass& liveness,
+                           bool trace_enabled);
+
+    // Main entry point. Liveness analysis must have run.
+    void run();
+
+    // Register assignments of a function, keyed by variable name. Variables
+    // that are not listed live in their stack slots.
+    const std::map<std::string, LiveInterval>& get_allocation(const std::string& function_name) const;
+
+    struct Stats {
+        int call_sites = 0;
+        int candidates = 0;           // Locals and parameters the pass considered.
+        int in_registers = 0;         // Given a callee-saved register.
+        int in_argument_registers = 0; // Parameters left in X0-X7/D0-D7.
+        int spilled = 0;              // Candidates left in their stack slots.
+        int crossing_calls = 0;       // Candidates live across at least one call.
+        int callee_saved_used = 0;    // Distinct callee-saved registers assigned.
+        bool skipped = false;         // Function contains constructs the pass does not model.
+    };
+    const Stats& get_stats(const std::string& function_name) const;
+    void print_results() const;
+
+private:
+    struct FunctionResult {
+        std::map<std::string, LiveInterval> allocation;
+        Stats stats;
+    };
+
+    void allocate_function(const std::string& name);
+
+    const LivenessAnalysisPass::CFGMap& cfgs_;
+    LivenessAnalysisPass& liveness_;
+    bool trace_enabled_;
+    std::map<std::string, FunctionResult> results_;
+
+    // Returned for unknown functions.
+    std::map<std::string, LiveInterval> empty_allocation_;
+    Stats empty_stats_;
+};
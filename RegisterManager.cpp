@@ -162,7 +162,7 @@ Instruction RegisterManager::generate_spill_code(const std::string& reg_name, co
     
     // Otherwise generate the store instruction for the dirty register
     int offset = cfm.get_spill_offset(variable_name);
-    return Encoder::create_str_imm(reg_name, "X29", offset, variable_name);
+    return Encoder::create_str_imm(Reg::parse(reg_name), Reg::fp(), offset, variable_name);
 }
 
 
@@ -33,9 +33,20 @@ public:
 
     // --- Variable & Scratch Management (Updated to use partitioned pools) ---
     std::pair<std::string, bool> acquire_reg_for_variable(const std::string& variable_name, NewCodeGenerator& code_gen);
+    // Binds a register to a variable for the rest of the function, as assigned
+    // by RegisterAllocationPass. It is never handed out, evicted or released.
+    void bind_allocated_register(const std::string& reg_name, const std::string& variable_name);
     void release_reg_for_variable(const std::string& variable_name);
     std::string acquire_scratch_reg(NewCodeGenerator& code_gen);
     void release_scratch_reg(const std::string& reg_name);
+    // Typed wrappers over the name-keyed pool, for emitters whose operands
+    // are all Reg values (X19/X28-relative addressing, frame access, spills).
+    // The register state stays keyed by name, so these convert at the
+    // boundary. Expression generators keep names: their results travel in
+    // expression_result_reg_ and their other operands are names too.
+    Reg acquire_scratch(NewCodeGenerator& code_gen) { return Reg::parse(acquire_scratch_reg(code_gen)); }
+    void release_scratch(Reg reg) { release_scratch_reg(reg.name()); }
+    static constexpr Reg data_base_reg() { return Reg::x(28); }
 
     // Acquire/release a callee-saved temp register for preserving values across function calls
     std::string acquire_callee_saved_temp_reg(CallFrameManager& cfm);
@@ -43,7 +54,8 @@ public:
 
     // NEW METHOD:
     // Acquires a register for a temporary, anonymous value,
-    // using the spillable VARIABLE_REGS pool.
+    // using the spillable VARIABLE_REGS pool. Released by release_register;
+    // when the pool is exhausted the register may be caller-saved.
     std::string acquire_spillable_temp_reg(NewCodeGenerator& code_gen);
     std::string acquire_spillable_fp_temp_reg(NewCodeGenerator& code_gen);
 
@@ -116,7 +128,8 @@ public:
         IN_USE_VARIABLE,
         IN_USE_SCRATCH,
         IN_USE_ROUTINE_ADDR,
-        IN_USE_DATA_BASE
+        IN_USE_DATA_BASE,
+        IN_USE_ALLOCATED // Holds a variable for the whole function.
     };
 
     struct RegisterInfo {
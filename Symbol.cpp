@@ -84,6 +84,9 @@ std::string Symbol::to_string() const {
         case VarType::POINTER_TO_TABLE:
             oss << "POINTER_TO_TABLE";
             break;
+        case VarType::POINTER_TO_MAP:
+            oss << "POINTER_TO_MAP";
+            break;
         case VarType::POINTER_TO_ANY_LIST:
             oss << "POINTER_TO_ANY_LIST";
             break;
@@ -49,6 +49,10 @@ class ASTAnalyzer : public ASTVisitor {
     bool is_local_float_function(const std::string& name) const;
     VarType get_variable_type(const std::string& function_name, const std::string& var_name) const;
     FunctionType get_runtime_function_type(const std::string& name) const;
+    // MAP_* calls whose second argument is a key, and the atom type
+    // (ATOM_INT, ATOM_FLOAT or ATOM_STRING) the key is passed with.
+    static bool is_map_keyed_call(const std::string& name);
+    int64_t get_map_key_type(const Expression* key) const;
 
     // Visitor methods
     void visit(Program& node) override;
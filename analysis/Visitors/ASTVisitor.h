@@ -59,6 +59,7 @@ class DefaultStatement;
 class BrkStatement;
 class LabelTargetStatement;
 class ConditionalBranchStatement;
+class PrefetchStatement;
 class GlobalVariableDeclaration;
 
 // --- The base visitor interface ---
@@ -124,5 +125,6 @@ public:
     virtual void visit(BrkStatement& node) {}
     virtual void visit(LabelTargetStatement& node) {}
     virtual void visit(ConditionalBranchStatement& node) {}
+    virtual void visit(PrefetchStatement&) {}
     virtual void visit(GlobalVariableDeclaration& node) {}
 };
\ No newline at end of file
@@ -186,6 +186,11 @@ VarType ASTAnalyzer::infer_expression_type(const Expression* expr) const {
                 return VarType::POINTER_TO_ANY_LIST;
             }
 
+            // COMPACTLIST rebuilds its argument in place and returns the same list.
+            if (func_var->name == "COMPACTLIST" && call->arguments.size() == 1) {
+                return infer_expression_type(call->arguments[0].get());
+            }
+
             if (modifying_funcs.count(func_var->name)) {
                 if (!call->arguments.empty()) {
                     VarType list_arg_type = infer_expression_type(call->arguments[0].get());
@@ -212,6 +217,32 @@ VarType ASTAnalyzer::infer_expression_type(const Expression* expr) const {
                 // JOIN returns a new string, which is a pointer to a string.
                 return VarType::POINTER_TO_STRING;
             }
+            if (func_var->name == "READLINE") {
+                // READLINE returns the next line of a FOPEN reader as a string.
+                return VarType::POINTER_TO_STRING;
+            }
+            // --- MAP_* built-in hash map functions ---
+            if (func_var->name == "MAP_NEW") {
+                return VarType::POINTER_TO_MAP;
+            }
+            if (func_var->name == "MAP_GETF") {
+                return VarType::FLOAT;
+            }
+            if (func_var->name == "MAP_GET" || func_var->name == "MAP_HAS" ||
+                func_var->name == "MAP_DEL" || func_var->name == "MAP_SIZE") {
+                return VarType::INTEGER;
+            }
+            if (func_var->name == "MAP_KEYS") {
+                // Keys of one map may mix ints, floats and strings.
+                return VarType::POINTER_TO_ANY_LIST;
+            }
+            // --- STRBUILDER built-in string builder functions ---
+            if (func_var->name == "SB_LENGTH") {
+                return VarType::INTEGER;
+            }
+            if (func_var->name == "TOSTRING") {
+                return VarType::POINTER_TO_STRING;
+            }
             // --- AS_* built-in type-casting intrinsics ---
             if (func_var->name == "AS_INT") {
                 return VarType::INTEGER;
@@ -0,0 +1,23 @@
+#include "../ASTAnalyzer.h"
+#include "runtime/ListDataTypes.h"
+
+/**
+ * @brief Checks if a name is a MAP_* call that takes a key as its second argument.
+ * @param name The called name.
+ * @return True for MAP_PUT, MAP_GET, MAP_GETF, MAP_HAS and MAP_DEL.
+ */
+bool ASTAnalyzer::is_map_keyed_call(const std::string& name) {
+    return name == "MAP_PUT" || name == "MAP_GET" || name == "MAP_GETF" || name == "MAP_HAS" || name == "MAP_DEL";
+}
+
+/**
+ * @brief Determines the runtime atom type a map key is passed with.
+ * @param key The key expression.
+ * @return ATOM_FLOAT for floats, ATOM_STRING for strings, ATOM_INT otherwise.
+ */
+int64_t ASTAnalyzer::get_map_key_type(const Expression* key) const {
+    VarType type = infer_expression_type(key);
+    if (type == VarType::FLOAT) return ATOM_FLOAT;
+    if (type == VarType::POINTER_TO_STRING) return ATOM_STRING;
+    return ATOM_INT;
+}
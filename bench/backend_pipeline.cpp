@@ -0,0 +1,117 @@
+// backend_pipeline.cpp
+// Compile time and peak memory of the back end on a synthetic program of
+// about a million instructions: building the instruction stream the way
+// the code generator does, the peephole optimizer, and both linker passes.
+// These are the stages that create, copy and compare Instruction records,
+// so their cost tracks the record's size and how its text is stored.
+//
+// The InternedString pool behind Instruction's text is process-wide and is
+// never freed, so peak RSS includes every distinct string interned during
+// the run. The pool is not thread-safe; the back end runs on one thread.
+//
+// Build with bench/build.sh, then run: bench/build/backend_pipeline [instructions]
+
+#include "Encoder.h"
+#include "InstructionStream.h"
+#include "InternedString.h"
+#include "LabelManager.h"
+#include "Linker.h"
+#include "PeepholeOptimizer.h"
+#include "RuntimeManager.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <sys/resource.h>
+#include <vector>
+
+static double ms_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Peak resident set size so far, in MB (ru_maxrss is KB on Linux, bytes on macOS).
+static double peak_rss_mb() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1e6;
+#else
+    return usage.ru_maxrss / 1e3;
+#endif
+}
+
+// One routine of 25 instructions with a loop, a call and a few moves the
+// peephole passes can remove, like the code generator's output.
+static void emit_routine(InstructionStream& stream, LabelManager& labels, int routine, int routines) {
+    stream.define_label("R_" + std::to_string(routine));
+    stream.add(Encoder::create_stp_pre_imm("X29", "X30", "SP", -32));
+    stream.add(Encoder::create_mov_reg("X29", "SP"));
+    stream.add(Encoder::create_movz_imm("X9", static_cast<uint16_t>(routine & 0xFFFF)));
+    stream.add(Encoder::create_str_imm("X9", "X29", 16));
+    stream.add(Encoder::create_ldr_imm("X10", "X29", 16));
+    std::string loop = labels.create_label();
+    std::string done = labels.create_label();
+    stream.define_label(loop);
+    stream.add(Encoder::create_cmp_imm("X10", 100));
+    stream.add(Encoder::create_branch_conditional("GE", done));
+    stream.add(Encoder::create_add_imm("X10", "X10", 1));
+    stream.add(Encoder::create_mov_reg("X11", "X10"));
+    stream.add(Encoder::create_mov_reg("X10", "X11"));
+    stream.add(Encoder::create_add_reg("X12", "X10", "X9"));
+    stream.add(Encoder::create_lsl_imm("X12", "X12", 3));
+    stream.add(Encoder::create_sub_reg("X12", "X12", "X10"));
+    stream.add(Encoder::create_branch_unconditional(loop));
+    stream.define_label(done);
+    stream.add(Encoder::create_mov_reg("X0", "X10"));
+    stream.add(Encoder::create_str_imm("X0", "X29", 24));
+    stream.add(Encoder::create_ldr_imm("X0", "X29", 24));
+    stream.add(Encoder::create_branch_with_link("R_" + std::to_string((routine + 1) % routines)));
+    stream.add(Encoder::create_mul_reg("X0", "X0", "X9"));
+    stream.add(Encoder::create_cmp_reg("X0", "X9"));
+    stream.add(Encoder::create_cset_eq("X0"));
+    stream.add(Encoder::create_movz_imm("X1", 0));
+    stream.add(Encoder::create_ldp_post_imm("X29", "X30", "SP", 32));
+    stream.add(Encoder::create_return());
+}
+
+int main(int argc, char** argv) {
+    size_t target = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    const int per_routine = 25;
+    int routines = static_cast<int>((target + per_routine - 1) / per_routine);
+    double rss_start = peak_rss_mb();
+
+    LabelManager& labels = LabelManager::instance();
+    labels.reset();
+    InstructionStream stream(labels, false);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < routines; r++) emit_routine(stream, labels, r, routines);
+    double build = ms_since(start);
+    size_t before = stream.size();
+
+    start = std::chrono::steady_clock::now();
+    PeepholeOptimizer optimizer(false);
+    optimizer.optimize(stream);
+    double peephole = ms_since(start);
+    size_t after = stream.size();
+
+    // Addresses only have to be consistent, not mapped: nothing is executed.
+    std::vector<uint8_t> data(4096);
+    start = std::chrono::steady_clock::now();
+    Linker linker;
+    std::vector<Instruction> linked =
+        linker.process(stream, labels, RuntimeManager::instance(), 0x100000000ull, data.data(), data.data());
+    double link = ms_since(start);
+
+    printf("sizeof(Instruction) = %zu bytes\n", sizeof(Instruction));
+    printf("%zu instructions in %d routines, %zu after peephole, %zu linked\n",
+           before, routines, after, linked.size());
+    printf("build stream   %10.1f ms\n", build);
+    printf("peephole       %10.1f ms\n", peephole);
+    printf("link           %10.1f ms\n", link);
+    printf("total          %10.1f ms\n", build + peephole + link);
+    printf("peak RSS       %10.1f MB (%.1f MB at start)\n", peak_rss_mb(), rss_start);
+    printf("interned       %10zu strings, %.1f KB\n",
+           InternedString::pool_size(), InternedString::pool_bytes() / 1e3);
+    return 0;
+}
@@ -0,0 +1,56 @@
+#!/bin/bash
+
+# Builds the benchmarks in this folder into bench/build.
+# Run from the repository root or from bench/: ./bench/build.sh
+
+# Exit immediately if a command exits with a non-zero status
+set -e
+
+cd "$(dirname "$0")"
+
+BUILD_DIR="build"
+CXX="${CXX:-clang++}"
+CXXFLAGS="-std=c++17 -O2 -DNDEBUG -I.. -I../HeapManager -I../runtime"
+
+# Heap manager plus the JIT-mode runtime that sits on top of it
+HEAP_SOURCES="../HeapManager/*.cpp ../SignalSafeUtils.cpp"
+RUNTIME_SOURCES="../runtime/runtime_bridge.cpp ../runtime/heap_interface.cpp ../runtime/runtime_string_ops.cpp ../runtime/runtime_map.cpp ../runtime/runtime_string_builder.cpp"
+
+# Compiler pieces the compiler benchmarks link against
+LEXER_SOURCES="../Lexer.cpp ../lex_*.cpp ../InternedString.cpp"
+ENCODER_SOURCES="../Encoder.cpp ../BitPatcher.cpp ../InternedString.cpp ../Register.cpp ../encoders/*.cpp"
+BACKEND_SOURCES="../InstructionStream.cpp ../LabelManager.cpp ../RuntimeManager.cpp ../PeepholeOptimizer.cpp ../PeepholePatterns.cpp ../optimizer/PeepholeRules.cpp ../optimizer/patterns/*.cpp ../InstructionDecoder.cpp ../InstructionComparator.cpp ../Linker.cpp ../linker_helpers/*.cpp"
+
+mkdir -p "${BUILD_DIR}"
+
+echo "Building heap_alloc_free..."
+${CXX} ${CXXFLAGS} -DJIT_MODE heap_alloc_free.cpp ${HEAP_SOURCES} ${RUNTIME_SOURCES} -o "${BUILD_DIR}/heap_alloc_free"
+
+echo "Building write_output..."
+${CXX} ${CXXFLAGS} write_output.cpp ${RUNTIME_SOURCES} -o "${BUILD_DIR}/write_output"
+
+echo "Building slurp..."
+${CXX} ${CXXFLAGS} slurp.cpp ${RUNTIME_SOURCES} -o "${BUILD_DIR}/slurp"
+
+echo "Building list_foreach..."
+${CXX} ${CXXFLAGS} list_foreach.cpp ${RUNTIME_SOURCES} -o "${BUILD_DIR}/list_foreach"
+
+echo "Building string_length..."
+${CXX} ${CXXFLAGS} string_length.cpp ${RUNTIME_SOURCES} -o "${BUILD_DIR}/string_length"
+
+echo "Building string_builder..."
+${CXX} ${CXXFLAGS} -DJIT_MODE string_builder.cpp ${HEAP_SOURCES} ${RUNTIME_SOURCES} -o "${BUILD_DIR}/string_builder"
+
+echo "Building instruction_copy..."
+${CXX} ${CXXFLAGS} -I../include instruction_copy.cpp ${ENCODER_SOURCES} -o "${BUILD_DIR}/instruction_copy"
+
+echo "Building encoder_throughput..."
+${CXX} ${CXXFLAGS} -I../include encoder_throughput.cpp ${ENCODER_SOURCES} -o "${BUILD_DIR}/encoder_throughput"
+
+echo "Building backend_pipeline..."
+${CXX} ${CXXFLAGS} -I../include backend_pipeline.cpp ${BACKEND_SOURCES} ${ENCODER_SOURCES} -o "${BUILD_DIR}/backend_pipeline"
+
+echo "Building lexer_throughput..."
+${CXX} ${CXXFLAGS} lexer_throughput.cpp ${LEXER_SOURCES} -o "${BUILD_DIR}/lexer_throughput"
+
+echo "Benchmarks built in bench/${BUILD_DIR}"
@@ -0,0 +1,65 @@
+// heap_alloc_free.cpp
+// Alloc/free throughput of the HeapManager as the number of live blocks grows.
+//
+// For each live-set size the benchmark allocates that many vectors and
+// strings, churns the live set (free a random block, allocate a replacement),
+// then frees everything in random order. With a per-free scan of the block
+// table the churn and free rates fall as the live set grows; with the
+// hashed block table they should stay flat.
+//
+// Build with bench/build.sh, then run: bench/build/heap_alloc_free [max_live]
+
+#include "HeapManager.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Mixed sizes so both the slab classes and the large-block path are used.
+static void* alloc_block(HeapManager& heap, std::mt19937_64& rng) {
+    size_t n = 1 + rng() % 200;
+    return (rng() & 1) ? heap.allocVec(n) : heap.allocString(n);
+}
+
+int main(int argc, char** argv) {
+    size_t max_live = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    HeapManager& heap = HeapManager::getInstance();
+    std::mt19937_64 rng(42);
+
+    printf("%12s %14s %14s %14s\n", "live blocks", "alloc Mops/s", "churn Mops/s", "free Mops/s");
+    for (size_t live = 100; live <= max_live; live *= 10) {
+        std::vector<void*> blocks(live);
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < live; i++) {
+            blocks[i] = alloc_block(heap, rng);
+        }
+        double alloc_time = seconds_since(start);
+
+        size_t churn_ops = live < 1000000 ? 1000000 : live;
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < churn_ops; i++) {
+            size_t victim = rng() % live;
+            heap.free(blocks[victim]);
+            blocks[victim] = alloc_block(heap, rng);
+        }
+        double churn_time = seconds_since(start);
+
+        std::shuffle(blocks.begin(), blocks.end(), rng);
+        start = std::chrono::steady_clock::now();
+        for (void* block : blocks) {
+            heap.free(block);
+        }
+        double free_time = seconds_since(start);
+
+        printf("%12zu %14.2f %14.2f %14.2f\n", live,
+               live / alloc_time / 1e6, churn_ops / churn_time / 1e6, live / free_time / 1e6);
+    }
+    return 0;
+}
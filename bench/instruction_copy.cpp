@@ -0,0 +1,44 @@
+// instruction_copy.cpp
+// Cost of copying the back end's Instruction records. The peephole passes,
+// the instruction stream and the linker all copy vectors of them, so the
+// record's size and whether copying it allocates dominate those passes.
+//
+// Build with bench/build.sh, then run: bench/build/instruction_copy [count]
+
+#include "Encoder.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    const int copies = 10;
+
+    // Text and labels repeat the way generated code does.
+    std::vector<Instruction> instructions;
+    instructions.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        Instruction instr(0x91000000u + i % 7, "ADD X0, X1, #" + std::to_string(i % 50));
+        instr.target_label = "L_" + std::to_string(i % 1000);
+        instructions.push_back(instr);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    size_t copied = 0;
+    for (int i = 0; i < copies; i++) {
+        std::vector<Instruction> copy(instructions);
+        copied += copy.size();
+    }
+    double copy_time = seconds_since(start);
+
+    printf("sizeof(Instruction) = %zu bytes\n", sizeof(Instruction));
+    printf("%d copies of %zu instructions: %.1f ms (%.1f M instructions/s)\n",
+           copies, count, copy_time * 1e3, copied / copy_time / 1e6);
+    return 0;
+}
@@ -0,0 +1,71 @@
+// lexer_throughput.cpp
+// Lexer throughput over a synthetic BCPL corpus, reading tokens only and
+// with the parser's habit of peeking after every identifier (to spot
+// labels). Before the lookahead ring, each peek copied the whole Lexer.
+//
+// Build with bench/build.sh, then run: bench/build/lexer_throughput [KB]
+// [KB] sizes the tokens-only corpus (default 16384); the peek run uses a
+// corpus 1/64 of that size.
+
+#include "Lexer.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// Defined in main.cpp in the compiler.
+bool g_enable_lexer_trace = false;
+
+// Functions in the shape of generated test programs: declarations,
+// conditionals, loops, labels, comments, strings, floats and hex.
+static std::string make_corpus(size_t bytes) {
+    std::string source;
+    for (int f = 0; source.size() < bytes; f++) {
+        std::string n = std::to_string(f);
+        source += "// Function number " + n + "\n";
+        source += "LET func_" + n + "(alpha, beta, gamma) = VALOF $(\n";
+        source += "    LET counter_" + n + " := alpha + beta * " + std::to_string(f * 7919 % 100000) + "\n";
+        source += "    IF counter_" + n + " > #X" + std::to_string(2000 + f % 8000) + " THEN writes(\"value *n is %d*n\")\n";
+        source += "    FOR index = 1 TO " + std::to_string(2 + f % 30) + " DO total := total + vector!index\n";
+        source += "    label_" + n + ": gamma := gamma +# 0." + std::to_string(10000 + f % 89999) + "\n";
+        source += "    /* block comment " + n + " */ writef(\"plain text\", 'c', '*n')\n";
+        source += "    RESULTIS alpha\n";
+        source += "$)\n\n";
+    }
+    return source;
+}
+
+// Best of three passes, in MB/s.
+static double lex(const std::string& source, bool peek_after_identifiers, size_t& tokens) {
+    double best = 1e9;
+    for (int rep = 0; rep < 3; ++rep) {
+        auto start = std::chrono::steady_clock::now();
+        Lexer lexer(source);
+        tokens = 0;
+        while (true) {
+            Token token = lexer.get_next_token();
+            ++tokens;
+            if (token.type == TokenType::Eof) break;
+            if (peek_after_identifiers && token.type == TokenType::Identifier) {
+                (void)lexer.peek().type;
+            }
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (seconds < best) best = seconds;
+    }
+    return source.size() / 1e6 / best;
+}
+
+int main(int argc, char** argv) {
+    size_t kb = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 16384;
+    size_t tokens = 0;
+
+    std::string source = make_corpus(kb * 1024);
+    double rate = lex(source, false, tokens);
+    printf("tokens only, %zu KB: %zu tokens, %.1f MB/s\n", source.size() / 1024, tokens, rate);
+
+    std::string small = make_corpus(kb * 1024 / 64);
+    rate = lex(small, true, tokens);
+    printf("peek after identifiers, %zu KB: %zu tokens, %.1f MB/s\n", small.size() / 1024, tokens, rate);
+    return 0;
+}
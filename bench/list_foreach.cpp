@@ -0,0 +1,93 @@
+// list_foreach.cpp
+// The two ways FOREACH can walk a runtime list: chasing 'next' on every
+// atom, or stepping through each run by sizeof(ListAtom) using the run
+// length on its first atom and prefetching ahead, as the lowering in
+// CFGBuilderPass::build_list_foreach_cfg does.
+//
+// Lists are built by the runtime itself: one in append order (a single
+// run per chunk), one interleaved with another list (no runs, so the flag
+// is off and both walks chase), and the interleaved one after COMPACTLIST.
+//
+// Build with bench/build.sh, then run: bench/build/list_foreach [atoms]
+// The compiled FOREACH can be timed on an ARM64 machine with
+// bench/list_foreach.bcl.
+
+#include "ListDataTypes.h"
+#include "heap_interface.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+extern "C" void BCPL_LIST_APPEND_INT(ListHeader* header, int64_t value);
+
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static int64_t sum_chase(const ListHeader* header) {
+    int64_t sum = 0;
+    for (const ListAtom* cursor = header->head; cursor; cursor = cursor->next) {
+        sum += cursor->value.int_value;
+    }
+    return sum;
+}
+
+static int64_t sum_runs(const ListHeader* header) {
+    int64_t sum = 0;
+    int64_t contig = (header->flags & LIST_FLAG_CONTIGUOUS);
+    for (const ListAtom* cursor = header->head; cursor; cursor = cursor->next) {
+        int64_t left = cursor->pad * contig;
+        sum += cursor->value.int_value;
+        while (left != 0) {
+            left--;
+            cursor++;
+            __builtin_prefetch(cursor + LIST_FOREACH_PREFETCH_ATOMS);
+            sum += cursor->value.int_value;
+        }
+    }
+    return sum;
+}
+
+static void report(const char* name, const ListHeader* header, int passes) {
+    int64_t expected = sum_chase(header);
+    auto start = std::chrono::steady_clock::now();
+    int64_t check = 0;
+    for (int i = 0; i < passes; i++) check += sum_chase(header);
+    double chase_time = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < passes; i++) check -= sum_runs(header);
+    double runs_time = seconds_since(start);
+
+    if (check != 0 || sum_runs(header) != expected) {
+        fprintf(stderr, "%s: walks disagree\n", name);
+        exit(1);
+    }
+    double atoms = (double)header->length * passes;
+    printf("%-22s %8s %14.1f %14.1f %8.2fx\n", name,
+           (header->flags & LIST_FLAG_CONTIGUOUS) ? "yes" : "no",
+           atoms / chase_time / 1e6, atoms / runs_time / 1e6, chase_time / runs_time);
+}
+
+int main(int argc, char** argv) {
+    int64_t atoms = argc > 1 ? std::strtoll(argv[1], nullptr, 10) : 4000000;
+    int passes = atoms >= 1000000 ? 10 : (int)(10000000 / atoms);
+
+    ListHeader* ordered = BCPL_LIST_CREATE_EMPTY();
+    for (int64_t i = 0; i < atoms; i++) BCPL_LIST_APPEND_INT(ordered, i);
+
+    ListHeader* interleaved = BCPL_LIST_CREATE_EMPTY();
+    ListHeader* other = BCPL_LIST_CREATE_EMPTY();
+    for (int64_t i = 0; i < atoms; i++) {
+        BCPL_LIST_APPEND_INT(interleaved, i);
+        BCPL_LIST_APPEND_INT(other, i);
+    }
+
+    printf("%lld atoms, %d passes\n", (long long)atoms, passes);
+    printf("%-22s %8s %14s %14s %9s\n", "list", "flag", "chase Ma/s", "runs Ma/s", "speedup");
+    report("append order", ordered, passes);
+    report("interleaved", interleaved, passes);
+    COMPACTLIST(interleaved);
+    report("interleaved+COMPACT", interleaved, passes);
+    return 0;
+}
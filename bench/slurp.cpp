@@ -0,0 +1,100 @@
+// slurp.cpp
+// SLURP throughput on 1 MB, 100 MB and 1 GB files, against a baseline that
+// reads the file into a malloc buffer and decodes UTF-8 byte by byte, as
+// the previous SLURP did.
+//
+// Build with bench/build.sh, then run: bench/build/slurp [size_mb ...]
+// Test files are written to $TMPDIR (default /tmp) and removed afterwards.
+
+#include "runtime.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static uint32_t* make_string(const std::string& text) {
+    uint32_t* s = static_cast<uint32_t*>(bcpl_alloc_chars(text.size()));
+    for (size_t i = 0; i < text.size(); i++) s[i] = static_cast<unsigned char>(text[i]);
+    return s;
+}
+
+// Mostly ASCII text with a two-byte and a three-byte sequence on each line.
+static bool write_test_file(const std::string& path, size_t bytes) {
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) return false;
+    const char line[] = "The quick brown fox jumps over the lazy dog, caf\xC3\xA9 \xE2\x98\xBA 0123456789\n";
+    for (size_t written = 0; written < bytes; written += sizeof(line) - 1) {
+        fwrite(line, 1, sizeof(line) - 1, f);
+    }
+    return fclose(f) == 0;
+}
+
+// The previous SLURP: read everything, then decode one byte at a time.
+static uint32_t* slurp_baseline(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return nullptr;
+    fseek(f, 0, SEEK_END);
+    size_t size = static_cast<size_t>(ftell(f));
+    fseek(f, 0, SEEK_SET);
+    unsigned char* bytes = static_cast<unsigned char*>(malloc(size));
+    size_t got = fread(bytes, 1, size, f);
+    fclose(f);
+
+    uint32_t* out = static_cast<uint32_t*>(bcpl_alloc_chars(got));
+    size_t n = 0;
+    for (size_t i = 0; i < got;) {
+        unsigned char c = bytes[i];
+        uint32_t cp;
+        if (c < 0x80) { cp = c; i += 1; }
+        else if ((c >> 5) == 6 && i + 1 < got) { cp = ((c & 0x1F) << 6) | (bytes[i + 1] & 0x3F); i += 2; }
+        else if ((c >> 4) == 14 && i + 2 < got) { cp = ((c & 0x0F) << 12) | ((bytes[i + 1] & 0x3F) << 6) | (bytes[i + 2] & 0x3F); i += 3; }
+        else if (i + 3 < got) { cp = ((c & 0x07) << 18) | ((bytes[i + 1] & 0x3F) << 12) | ((bytes[i + 2] & 0x3F) << 6) | (bytes[i + 3] & 0x3F); i += 4; }
+        else { cp = 0xFFFD; i += 1; }
+        out[n++] = cp;
+    }
+    out[n] = 0;
+    free(bytes);
+    return out;
+}
+
+int main(int argc, char** argv) {
+    std::vector<size_t> sizes_mb;
+    for (int i = 1; i < argc; i++) sizes_mb.push_back(std::strtoull(argv[i], nullptr, 10));
+    if (sizes_mb.empty()) sizes_mb = {1, 100, 1024};
+
+    const char* tmpdir = getenv("TMPDIR");
+    std::string path = std::string(tmpdir ? tmpdir : "/tmp") + "/bcpl_slurp_bench.txt";
+
+    printf("%10s %16s %16s\n", "size MB", "baseline MB/s", "SLURP MB/s");
+    for (size_t mb : sizes_mb) {
+        if (!write_test_file(path, mb << 20)) {
+            fprintf(stderr, "cannot write %s\n", path.c_str());
+            return 1;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        uint32_t* expected = slurp_baseline(path.c_str());
+        double baseline = seconds_since(start);
+
+        start = std::chrono::steady_clock::now();
+        uint32_t* actual = SLURP(make_string(path));
+        double slurp = seconds_since(start);
+
+        if (!actual || STRCMP(expected, actual) != 0) {
+            fprintf(stderr, "SLURP result differs from the baseline decoder\n");
+            return 1;
+        }
+        bcpl_free(expected);
+        bcpl_free(actual);
+
+        printf("%10zu %16.1f %16.1f\n", mb, mb / baseline, mb / slurp);
+    }
+    remove(path.c_str());
+    return 0;
+}
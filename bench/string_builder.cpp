@@ -0,0 +1,64 @@
+// string_builder.cpp
+// Building one long string from many short pieces: STRBUILDER appends and
+// TOSTRING, against appending the pieces to a list and JOINing it, which
+// is how programs built strings before the builder.
+//
+// Pieces alternate "ab" and "abc" so appends are not all the same size.
+// The builder grows through HeapManager::resizeString, so this also shows
+// how many resizes the doubling needs.
+//
+// Build with bench/build.sh, then run: bench/build/string_builder [pieces]
+
+#include "runtime.h"
+#include "HeapManager.h"
+#include "ListDataTypes.h"
+#include "heap_interface.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static double ms_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static uint32_t* make_string(const char* text) {
+    size_t n = std::strlen(text);
+    uint32_t* s = static_cast<uint32_t*>(bcpl_alloc_chars((int64_t)n));
+    for (size_t i = 0; i < n; i++) s[i] = (uint32_t)text[i];
+    return s;
+}
+
+int main(int argc, char** argv) {
+    size_t pieces = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    uint32_t* ab = make_string("ab");
+    uint32_t* abc = make_string("abc");
+
+    auto start = std::chrono::steady_clock::now();
+    BCPLStringBuilder* sb = BCPL_SB_NEW();
+    for (size_t i = 0; i < pieces; i++) BCPL_SB_APPEND(sb, (i & 1) ? abc : ab);
+    uint32_t* built = BCPL_SB_TOSTRING(sb);
+    double builder = ms_since(start);
+    int64_t built_length = STRLEN(built);
+    bcpl_free(built);
+
+    // String atoms hold base pointers, as SPLIT's do and JOIN expects.
+    uint32_t* ab_base = reinterpret_cast<uint32_t*>(reinterpret_cast<uint64_t*>(ab) - 1);
+    uint32_t* abc_base = reinterpret_cast<uint32_t*>(reinterpret_cast<uint64_t*>(abc) - 1);
+    uint32_t* empty = make_string("");
+    start = std::chrono::steady_clock::now();
+    ListHeader* list = BCPL_LIST_CREATE_EMPTY();
+    for (size_t i = 0; i < pieces; i++) BCPL_LIST_APPEND_STRING(list, (i & 1) ? abc_base : ab_base);
+    uint32_t* joined = BCPL_JOIN_LIST(list, empty);
+    double join = ms_since(start);
+    int64_t joined_length = STRLEN(joined);
+    bcpl_free(joined);
+
+    printf("%zu pieces, %lld chars (%.1f MB)\n", pieces, (long long)built_length, built_length * 4 / 1e6);
+    printf("STRBUILDER + TOSTRING %10.1f ms\n", builder);
+    printf("list append + JOIN    %10.1f ms%s\n", join, joined_length == built_length ? "" : " (length mismatch)");
+    // Includes Total Strings Resized, the number of times the builder grew.
+    HeapManager::getInstance().printMetrics();
+    return 0;
+}
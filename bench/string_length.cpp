@@ -0,0 +1,82 @@
+// string_length.cpp
+// STRLEN and STRCMP on strings of 16, 1K and 1M characters, against the
+// previous character-by-character loops reproduced here as strlen_baseline
+// and strcmp_baseline.
+//
+// Runtime strings carry a tagged length word and STRLEN reads it in O(1).
+// The same characters copied into a vector, after an element that is not a
+// tagged length, take the terminator scan; that row shows the scan cost.
+//
+// Build with bench/build.sh, then run: bench/build/string_length
+
+#include "runtime.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+// The previous STRLEN and STRCMP.
+static int64_t strlen_baseline(const uint32_t* s) {
+    int64_t len = 0;
+    while (s[len] != 0) len++;
+    return len;
+}
+
+static int64_t strcmp_baseline(const uint32_t* s1, const uint32_t* s2) {
+    while (*s1 && *s1 == *s2) {
+        s1++;
+        s2++;
+    }
+    return (int64_t)*s1 - (int64_t)*s2;
+}
+
+// Keeps the compiler from dropping the calls being timed.
+static volatile int64_t g_sink;
+
+template <typename F>
+static double ns_per_op(size_t reps, F op) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < reps; i++) g_sink = g_sink + op();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return seconds * 1e9 / reps;
+}
+
+static uint32_t* make_string(size_t n, uint32_t last) {
+    uint32_t* s = static_cast<uint32_t*>(bcpl_alloc_chars((int64_t)n));
+    for (size_t i = 0; i < n; i++) s[i] = 'a' + i % 26;
+    s[n - 1] = last;
+    return s;
+}
+
+int main() {
+    const size_t lengths[] = {16, 1024, 1024 * 1024};
+
+    printf("%10s %12s %12s %12s %12s %12s\n", "chars", "STRLEN", "baseline",
+           "STRCMP", "baseline", "scan STRLEN");
+    for (size_t n : lengths) {
+        size_t reps = (size_t)200000000 / (n + 16);
+
+        // Equal but for the last character, so a comparison reads both to the end.
+        uint32_t* a = make_string(n, 'x');
+        uint32_t* b = make_string(n, 'y');
+
+        // The same characters after an untagged word in a vector.
+        uint64_t* v = static_cast<uint64_t*>(bcpl_alloc_words((int64_t)(n / 2 + 2), "main", "v"));
+        v[0] = 0;
+        uint32_t* inner = reinterpret_cast<uint32_t*>(v + 1);
+        STRCOPY(inner, a);
+
+        double len = ns_per_op(reps, [&] { return STRLEN(a); });
+        double len_base = ns_per_op(reps, [&] { return strlen_baseline(a); });
+        double cmp = ns_per_op(reps, [&] { return STRCMP(a, b); });
+        double cmp_base = ns_per_op(reps, [&] { return strcmp_baseline(a, b); });
+        double scan = ns_per_op(reps, [&] { return STRLEN(inner); });
+
+        printf("%10zu %9.1f ns %9.1f ns %9.1f ns %9.1f ns %9.1f ns\n",
+               n, len, len_base, cmp, cmp_base, scan);
+
+        bcpl_free(a);
+        bcpl_free(b);
+        bcpl_free(v);
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+// write_output.cpp
+// Output throughput of WRITES/WRITEN/WRITEC through the buffered UTF-8
+// output engine, against the previous engine (putchar per byte plus an
+// fflush per call), reproduced here as write_baseline.
+//
+// Build with bench/build.sh, then run with stdout redirected so the
+// terminal is not what is being measured:
+//   bench/build/write_output [total_chars] > /dev/null
+// Timings go to stderr.
+
+#include "runtime.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+// The previous WRITES: one putchar per UTF-8 byte and an fflush per call.
+static void write_baseline(const uint32_t* s) {
+    for (; *s; s++) {
+        uint32_t ch = *s;
+        if (ch < 0x80) {
+            putchar((char)ch);
+        } else if (ch < 0x800) {
+            putchar(0xC0 | (ch >> 6));
+            putchar(0x80 | (ch & 0x3F));
+        } else if (ch < 0x10000) {
+            putchar(0xE0 | (ch >> 12));
+            putchar(0x80 | ((ch >> 6) & 0x3F));
+            putchar(0x80 | (ch & 0x3F));
+        } else {
+            putchar(0xF0 | (ch >> 18));
+            putchar(0x80 | ((ch >> 12) & 0x3F));
+            putchar(0x80 | ((ch >> 6) & 0x3F));
+            putchar(0x80 | (ch & 0x3F));
+        }
+    }
+    fflush(stdout);
+}
+
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    size_t total = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000000;
+
+    // 1000-character lines of mostly ASCII with the occasional non-ASCII code point.
+    const size_t line_length = 1000;
+    uint32_t* line = static_cast<uint32_t*>(bcpl_alloc_chars(line_length));
+    for (size_t i = 0; i < line_length; i++) {
+        line[i] = (i % 80 == 79) ? '\n' : (i % 97 == 5 ? 0x263A : 'a' + i % 26);
+    }
+    size_t lines = total / line_length;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < lines; i++) write_baseline(line);
+    double baseline = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < lines; i++) WRITES(line);
+    bcpl_flush_output();
+    double buffered = seconds_since(start);
+
+    // Number formatting path: WRITEN plus a separator per value.
+    size_t numbers = total / 100;
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < numbers; i++) {
+        WRITEN((int64_t)i);
+        WRITEC(' ');
+    }
+    bcpl_flush_output();
+    double writen = seconds_since(start);
+
+    fprintf(stderr, "WRITES baseline: %zu chars in %.3f s (%.1f Mchars/s)\n",
+            lines * line_length, baseline, lines * line_length / baseline / 1e6);
+    fprintf(stderr, "WRITES buffered: %zu chars in %.3f s (%.1f Mchars/s)\n",
+            lines * line_length, buffered, lines * line_length / buffered / 1e6);
+    fprintf(stderr, "WRITEN+WRITEC:   %zu numbers in %.3f s (%.1f M/s)\n",
+            numbers, writen, numbers / writen / 1e6);
+    return 0;
+}
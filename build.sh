@@ -15,10 +15,14 @@ MAX_JOBS=8 # Number of parallel compilation jobs
 
 # --- Argument Parsing ---
 CLEAN_BUILD=false
+EXTRA_CXXFLAGS=""
 for arg in "$@"; do
     if [ "$arg" == "--clean" ]; then
         CLEAN_BUILD=true
-        break
+    elif [ "$arg" == "--count-allocations" ]; then
+        # Per-pass allocation counts for --time-passes (see PassTimer.h).
+        # Objects are reused by incremental builds, so switch with --clean.
+        EXTRA_CXXFLAGS="-DBCPL_COUNT_ALLOCATIONS"
     fi
 done
 
@@ -80,6 +84,7 @@ except FileNotFoundError:
 CORE_SRC_FILES=$(find . -maxdepth 1 -name "*.cpp" ! -name "main.cpp" ! -name "live_*.cpp" ! -name "peephole_test.cpp" -print; \
                  find encoders -name "*.cpp" -print; \
                  find passes -name "*.cpp" -print; \
+                 find optimizer -name "*.cpp" -print; \
                  find linker_helpers -name "*.cpp" -print; \
                  find . -name "cf_*.cpp" -print; \
                  find . -name "rm_*.cpp" -print; \
@@ -152,6 +157,7 @@ else
         src_file="$1"
         obj_dir="$2"
         errors_file="$3"
+        extra_cxxflags="$4"
 
         base_filename=$(basename "${src_file}")
         obj_name="${base_filename%.cpp}.o"
@@ -168,13 +174,13 @@ else
         # -o: Output object file
         # > /dev/null: Redirect stdout (success messages) to null
         # 2>> "${errors_file}": Append stderr (error messages) to the errors file
-        if ! clang++ -g -fno-omit-frame-pointer -std=c++17 -I. -I./NewBCPL -I./analysis/az_impl -I./analysis -I./ -I./include -I./HeapManager -I./runtime -c "${src_file}" -o "${obj_file}" 2>> "${errors_file}"; then
+        if ! clang++ -g -fno-omit-frame-pointer -std=c++17 -I. -I./NewBCPL -I./analysis/az_impl -I./analysis -I./ -I./include -I./HeapManager -I./runtime ${extra_cxxflags} -c "${src_file}" -o "${obj_file}" 2>> "${errors_file}"; then
             # If compilation fails, print an error message to stderr and exit the subshell.
             # Exiting the subshell will cause xargs to stop processing further arguments.
             echo "Error: Compilation failed for ${src_file}. See ${errors_file} for details." >&2
             exit 1
         fi
-    ' _ {} "${OBJ_DIR}" "${ERRORS_FILE}" # Pass OBJ_DIR and ERRORS_FILE as arguments to the subshell
+    ' _ {} "${OBJ_DIR}" "${ERRORS_FILE}" "${EXTRA_CXXFLAGS}" # Pass OBJ_DIR, ERRORS_FILE and EXTRA_CXXFLAGS to the subshell
 fi
 
 # Check if any compilation errors occurred by checking the size of the errors file
@@ -76,20 +76,22 @@ std::vector<Instruction> CallFrameManager::generate_prologue() {
             prologue_code.push_back(instr);
         }
         prologue_code.back().assembly_text += " ; Load UPPER_CANARY_VALUE";
-        prologue_code.push_back(Encoder::create_str_imm("X9", "X29", upper_canary_offset));
+        prologue_code.push_back(Encoder::create_str_imm(Reg::x(9), Reg::fp(), upper_canary_offset));
         prologue_code.back().assembly_text += " ; Store Upper Stack Canary";
 
         for (const auto& instr : Encoder::create_movz_movk_abs64("X9", LOWER_CANARY_VALUE, "")) {
             prologue_code.push_back(instr);
         }
         prologue_code.back().assembly_text += " ; Load LOWER_CANARY_VALUE";
-        prologue_code.push_back(Encoder::create_str_imm("X9", "X29", lower_canary_offset));
+        prologue_code.push_back(Encoder::create_str_imm(Reg::x(9), Reg::fp(), lower_canary_offset));
         prologue_code.back().assembly_text += " ; Store Lower Stack Canary";
     }
 
     for (const auto& reg : this->callee_saved_registers_to_save) {
         int offset = variable_offsets.at(reg);
-        Instruction instr = Encoder::create_str_imm(reg, "X29", offset);
+        Reg saved = Reg::parse(reg);
+        Instruction instr = saved.is_fp() ? Encoder::create_str_fp_imm(reg, "X29", offset)
+                                          : Encoder::create_str_imm(saved, Reg::fp(), offset);
         instr.assembly_text += " ; Saved Reg: " + reg + " @ FP+" + std::to_string(offset);
         prologue_code.push_back(instr);
     }
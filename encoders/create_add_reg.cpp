@@ -1,9 +1,8 @@
 #include "Encoder.h"
+#include "AssemblyText.h"
 #include "BitPatcher.h"
 #include <stdexcept>
 #include <string>
-#include <cctype>
-#include <algorithm>
 #include <vector>
 
 /**
@@ -27,84 +26,34 @@
  * @return An `Instruction` object containing the encoding and assembly text [cite: 2].
  * @throw std::invalid_argument if register names are invalid or if register sizes are mixed.
  */
-Instruction Encoder::create_add_reg(const std::string& xd, const std::string& xn, const std::string& xm) {
-    // Helper lambda to parse register strings like "x0", "w1", "sp", "wzr".
-    // Returns the register number (0-31) and a boolean indicating if it's a 64-bit register.
-    auto parse_register = [](const std::string& reg_str) -> std::pair<uint32_t, bool> {
-        if (reg_str.empty()) {
-            throw std::invalid_argument("Register string cannot be empty.");
-        }
-
-        std::string lower_reg = reg_str;
-        std::transform(lower_reg.begin(), lower_reg.end(), lower_reg.begin(), ::tolower);
-
-        bool is_64bit;
-        uint32_t reg_num;
-
-        if (lower_reg == "wzr") {
-            is_64bit = false;
-            reg_num = 31;
-        } else if (lower_reg == "xzr") {
-            is_64bit = true;
-            reg_num = 31;
-        } else if (lower_reg == "wsp") {
-            is_64bit = false;
-            reg_num = 31;
-        } else if (lower_reg == "sp") {
-            is_64bit = true;
-            reg_num = 31;
-        } else {
-            char prefix = lower_reg[0];
-            if (prefix == 'w') {
-                is_64bit = false;
-            } else if (prefix == 'x') {
-                is_64bit = true;
-            } else {
-                throw std::invalid_argument("Invalid register prefix in '" + reg_str + "'. Must be 'w' or 'x'.");
-            }
-
-            try {
-                reg_num = std::stoul(reg_str.substr(1));
-                if (reg_num > 30) {
-                     throw std::out_of_range("Register number out of range for '" + reg_str + "'. Use 'wsp'/'sp' or 'wzr'/'xzr' for register 31.");
-                }
-            } catch (const std::logic_error&) {
-                throw std::invalid_argument("Invalid register format: '" + reg_str + "'.");
-            }
-        }
-        return {reg_num, is_64bit};
-    };
-
-    // (A) Perform self-checking by parsing and validating all register arguments first.
-    auto [rd_num, rd_is_64] = parse_register(xd);
-    auto [rn_num, rn_is_64] = parse_register(xn);
-    auto [rm_num, rm_is_64] = parse_register(xm);
-
-    if (!(rd_is_64 == rn_is_64 && rn_is_64 == rm_is_64)) {
+Instruction Encoder::create_add_reg(Reg xd, Reg xn, Reg xm) {
+    check_general(xd, "ADD");
+    check_general(xn, "ADD");
+    check_general(xm, "ADD");
+    if (!(xd.is_64bit() == xn.is_64bit() && xn.is_64bit() == xm.is_64bit())) {
         throw std::invalid_argument("Mismatched register sizes. All operands for ADD (register) must be simultaneously 32-bit (W) or 64-bit (X).");
     }
 
-    // (B) Use the BitPatcher to construct the instruction word.
-    // Base opcode for 32-bit ADD (register) is 0x0B000000.
     BitPatcher patcher(0x0B000000);
 
-    if (rd_is_64) {
+    if (xd.is_64bit()) {
         patcher.patch(1, 31, 1); // sf bit
     }
 
-    patcher.patch(rd_num, 0, 5);  // Rd
-    patcher.patch(rn_num, 5, 5);  // Rn
-    patcher.patch(rm_num, 16, 5); // Rm
-
-    // (C) Format the assembly string for the Instruction object.
-    std::string assembly_text = "ADD " + xd + ", " + xn + ", " + xm;
+    patcher.patch(xd.encoding(), 0, 5);  // Rd
+    patcher.patch(xn.encoding(), 5, 5);  // Rn
+    patcher.patch(xm.encoding(), 16, 5); // Rm
 
-    // (D) Return the completed Instruction object, using the constructor from Encoder.h [cite: 2].
-    // For this simple instruction, no relocation is needed.
-    Instruction instr(patcher.get_value(), assembly_text);
+    Instruction instr;
+    instr.encoding = patcher.get_value();
+    instr.assembly_text = (AssemblyText() << "ADD " << xd << ", " << xn << ", " << xm).intern();
     instr.opcode = InstructionDecoder::OpType::ADD;
-    instr.dest_reg = Encoder::get_reg_encoding(xd);
-    instr.src_reg1 = Encoder::get_reg_encoding(xn);
-    instr.src_reg2 = Encoder::get_reg_encoding(xm);
+    instr.dest_reg = xd.encoding();
+    instr.src_reg1 = xn.encoding();
+    instr.src_reg2 = xm.encoding();
     return instr;
 }
+
+Instruction Encoder::create_add_reg(const std::string& xd, const std::string& xn, const std::string& xm) {
+    return create_add_reg(parse_register(xd), parse_register(xn), parse_register(xm));
+}
@@ -1,7 +1,6 @@
 #include "BitPatcher.h"
 #include "Encoder.h"
-#include <algorithm>
-#include <cctype>
+#include "AssemblyText.h"
 #include <stdexcept>
 #include <string>
 
@@ -27,83 +26,34 @@
  * @return An `Instruction` object containing the encoding and assembly text.
  * @throw std::invalid_argument for invalid registers or mismatched sizes.
  */
-Instruction Encoder::create_cmp_reg(const std::string& xn, const std::string& xm) {
-    // Helper lambda to parse register strings.
-    auto parse_register = [](const std::string& reg_str) -> std::pair<uint32_t, bool> {
-        if (reg_str.empty()) {
-            throw std::invalid_argument("Register string cannot be empty.");
-        }
-
-        std::string lower_reg = reg_str;
-        std::transform(lower_reg.begin(), lower_reg.end(), lower_reg.begin(), ::tolower);
-
-        bool is_64bit;
-        uint32_t reg_num;
-
-        if (lower_reg == "wzr") {
-            is_64bit = false;
-            reg_num = 31;
-        } else if (lower_reg == "xzr") {
-            is_64bit = true;
-            reg_num = 31;
-        } else if (lower_reg == "wsp") {
-            is_64bit = false;
-            reg_num = 31;
-        } else if (lower_reg == "sp") {
-            is_64bit = true;
-            reg_num = 31;
-        } else {
-            char prefix = lower_reg[0];
-            if (prefix == 'w') {
-                is_64bit = false;
-            } else if (prefix == 'x') {
-                is_64bit = true;
-            } else {
-                throw std::invalid_argument("Invalid register prefix in '" + reg_str + "'. Must be 'w' or 'x'.");
-            }
-
-            try {
-                reg_num = std::stoul(reg_str.substr(1));
-                if (reg_num > 31) {
-                     throw std::out_of_range("Register number out of range for '" + reg_str + "'.");
-                }
-            } catch (const std::logic_error&) {
-                throw std::invalid_argument("Invalid register format: '" + reg_str + "'.");
-            }
-        }
-        return {reg_num, is_64bit};
-    };
-
-    // (A) Self-checking: parse and validate registers.
-    auto [rn_num, rn_is_64] = parse_register(xn);
-    auto [rm_num, rm_is_64] = parse_register(xm);
-
-    if (rn_is_64 != rm_is_64) {
+Instruction Encoder::create_cmp_reg(Reg xn, Reg xm) {
+    check_general(xn, "CMP");
+    check_general(xm, "CMP");
+    if (xn.is_64bit() != xm.is_64bit()) {
         throw std::invalid_argument("Mismatched register sizes. Operands for CMP (register) must be the same size.");
     }
 
-    // (B) Use BitPatcher to construct the instruction word.
-    // The base opcode for a 32-bit SUBS (register) is 0x6B000000.
     BitPatcher patcher(0x6B000000);
 
-    if (rn_is_64) {
+    if (xn.is_64bit()) {
         patcher.patch(1, 31, 1); // Set the sf bit for 64-bit operation.
     }
 
-    // Patch the source registers `Rn` and `Rm`.
-    patcher.patch(rm_num, 16, 5);
-    patcher.patch(rn_num, 5, 5);
+    patcher.patch(xm.encoding(), 16, 5);
+    patcher.patch(xn.encoding(), 5, 5);
 
-    // Patch the destination register `Rd` to be the zero register (31).
+    // CMP is SUBS with the zero register as destination.
     patcher.patch(31, 0, 5);
 
-    // (C) Format the assembly string for the Instruction object.
-    std::string assembly_text = "CMP " + xn + ", " + xm;
-
-    // (D) Return the completed Instruction object. No relocation is needed.
-    Instruction instr(patcher.get_value(), assembly_text);
+    Instruction instr;
+    instr.encoding = patcher.get_value();
+    instr.assembly_text = (AssemblyText() << "CMP " << xn << ", " << xm).intern();
     instr.opcode = InstructionDecoder::OpType::CMP;
-    instr.src_reg1 = Encoder::get_reg_encoding(xn);
-    instr.src_reg2 = Encoder::get_reg_encoding(xm);
+    instr.src_reg1 = xn.encoding();
+    instr.src_reg2 = xm.encoding();
     return instr;
 }
+
+Instruction Encoder::create_cmp_reg(const std::string& xn, const std::string& xm) {
+    return create_cmp_reg(parse_register(xn), parse_register(xm));
+}
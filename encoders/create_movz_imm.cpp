@@ -1,7 +1,6 @@
 #include "BitPatcher.h"
 #include "Encoder.h"
-#include <algorithm>
-#include <cctype>
+#include "AssemblyText.h"
 #include <stdexcept>
 #include <string>
 
@@ -30,56 +29,18 @@
  * @return An `Instruction` object containing the encoding and other metadata.
  * @throw std::invalid_argument for invalid registers or invalid shift values.
  */
-Instruction Encoder::create_movz_imm(const std::string& xd, uint16_t immediate, int shift, RelocationType rel, const std::string& target) {
-    // (A) Self-checking: Validate the shift value.
+Instruction Encoder::create_movz_imm(Reg xd, uint16_t immediate, int shift) {
+    // (A) Self-checking: Validate the shift value and register.
     if (shift != 0 && shift != 16 && shift != 32 && shift != 48) {
         throw std::invalid_argument("Invalid shift for MOVZ. Must be 0, 16, 32, or 48.");
     }
 
-    // Helper lambda to parse the destination register.
-    auto parse_register = [](const std::string& reg_str) -> std::pair<uint32_t, bool> {
-        if (reg_str.empty()) {
-            throw std::invalid_argument("Register string cannot be empty.");
-        }
-
-        std::string lower_reg = reg_str;
-        std::transform(lower_reg.begin(), lower_reg.end(), lower_reg.begin(), ::tolower);
-
-        bool is_64bit;
-        uint32_t reg_num;
-
-        if (lower_reg == "wzr") {
-            is_64bit = false;
-            reg_num = 31;
-        } else if (lower_reg == "xzr") {
-            is_64bit = true;
-            reg_num = 31;
-        } else {
-            char prefix = lower_reg[0];
-            if (prefix == 'w') {
-                is_64bit = false;
-            } else if (prefix == 'x') {
-                is_64bit = true;
-            } else {
-                throw std::invalid_argument("Invalid register prefix in '" + reg_str + "'. Must be 'w' or 'x'.");
-            }
-
-            try {
-                reg_num = std::stoul(reg_str.substr(1));
-                if (reg_num > 31) {
-                     throw std::out_of_range("Register number out of range for '" + reg_str + "'.");
-                }
-            } catch (const std::logic_error&) {
-                throw std::invalid_argument("Invalid register format: '" + reg_str + "'.");
-            }
-        }
-        return {reg_num, is_64bit};
-    };
-
-    auto [rd_num, rd_is_64] = parse_register(xd);
+    if (!xd.valid() || (xd.cls != RegClass::X && xd.cls != RegClass::W)) {
+        throw std::invalid_argument(std::string("Invalid register '") + xd.name() + "' for MOVZ. Must be 'w' or 'x'.");
+    }
 
     // A 32-bit register cannot be shifted by 32 or 48.
-    if (!rd_is_64 && (shift == 32 || shift == 48)) {
+    if (!xd.is_64bit() && (shift == 32 || shift == 48)) {
         throw std::invalid_argument("Cannot use a shift of 32 or 48 with a 32-bit 'W' register.");
     }
 
@@ -88,7 +49,7 @@ Instruction Encoder::create_movz_imm(const std::string& xd, uint16_t immediate,
     BitPatcher patcher(0x52800000);
 
     // Set the size flag (sf) for a 64-bit register destination.
-    if (rd_is_64) {
+    if (xd.is_64bit()) {
         patcher.patch(1, 31, 1);
     }
 
@@ -100,19 +61,26 @@ Instruction Encoder::create_movz_imm(const std::string& xd, uint16_t immediate,
     patcher.patch(immediate, 5, 16);
 
     // Patch the destination register (Rd) into bits 0-4.
-    patcher.patch(rd_num, 0, 5);
+    patcher.patch(xd.encoding(), 0, 5);
 
     // (C) Format the assembly string for the Instruction object.
-    std::string assembly_text = "MOVZ " + xd + ", #" + std::to_string(immediate);
+    AssemblyText text;
+    text << "MOVZ " << xd << ", #" << immediate;
     if (shift > 0) {
-        assembly_text += ", LSL #" + std::to_string(shift);
+        text << ", LSL #" << shift;
     }
 
-    // (D) Return the completed Instruction object, including relocation info.
-    Instruction instr(patcher.get_value(), assembly_text);
+    // (D) Return the completed Instruction object.
+    Instruction instr;
+    instr.encoding = patcher.get_value();
+    instr.assembly_text = text.intern();
     instr.opcode = InstructionDecoder::OpType::MOVZ;
-    instr.dest_reg = Encoder::get_reg_encoding(xd);
+    instr.dest_reg = xd.encoding();
     instr.immediate = immediate;
     instr.uses_immediate = true;
     return instr;
 }
+
+Instruction Encoder::create_movz_imm(const std::string& xd, uint16_t immediate, int shift, RelocationType rel, const std::string& target) {
+    return create_movz_imm(parse_register(xd), immediate, shift);
+}
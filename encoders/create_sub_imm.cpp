@@ -1,7 +1,6 @@
 #include "BitPatcher.h"
 #include "Encoder.h"
-#include <algorithm>
-#include <cctype>
+#include "AssemblyText.h"
 #include <stdexcept>
 #include <string>
 
@@ -29,63 +28,16 @@
  * @return An `Instruction` object containing the encoding and assembly text.
  * @throw std::invalid_argument for invalid registers, mismatched sizes, or out-of-range immediates.
  */
-Instruction Encoder::create_sub_imm(const std::string& xd, const std::string& xn, int imm) {
+Instruction Encoder::create_sub_imm(Reg xd, Reg xn, int imm) {
     // (A) Self-checking: Validate the immediate value.
     if (imm < 0 || imm > 4095) {
         throw std::invalid_argument("Immediate for SUB must be an unsigned 12-bit value [0, 4095].");
     }
 
-    // Helper lambda to parse register strings.
-    auto parse_register = [](const std::string& reg_str) -> std::pair<uint32_t, bool> {
-        if (reg_str.empty()) {
-            throw std::invalid_argument("Register string cannot be empty.");
-        }
-
-        std::string lower_reg = reg_str;
-        std::transform(lower_reg.begin(), lower_reg.end(), lower_reg.begin(), ::tolower);
-
-        bool is_64bit;
-        uint32_t reg_num;
-
-        if (lower_reg == "wzr") {
-            is_64bit = false;
-            reg_num = 31;
-        } else if (lower_reg == "xzr") {
-            is_64bit = true;
-            reg_num = 31;
-        } else if (lower_reg == "wsp") {
-            is_64bit = false;
-            reg_num = 31;
-        } else if (lower_reg == "sp") {
-            is_64bit = true;
-            reg_num = 31;
-        } else {
-            char prefix = lower_reg[0];
-            if (prefix == 'w') {
-                is_64bit = false;
-            } else if (prefix == 'x') {
-                is_64bit = true;
-            } else {
-                throw std::invalid_argument("Invalid register prefix in '" + reg_str + "'. Must be 'w' or 'x'.");
-            }
-
-            try {
-                reg_num = std::stoul(reg_str.substr(1));
-                if (reg_num > 31) {
-                     throw std::out_of_range("Register number out of range for '" + reg_str + "'.");
-                }
-            } catch (const std::logic_error&) {
-                throw std::invalid_argument("Invalid register format: '" + reg_str + "'.");
-            }
-        }
-        return {reg_num, is_64bit};
-    };
-
-    // (B) Parse and validate registers.
-    auto [rd_num, rd_is_64] = parse_register(xd);
-    auto [rn_num, rn_is_64] = parse_register(xn);
-
-    if (rd_is_64 != rn_is_64) {
+    // (B) Validate registers.
+    check_general(xd, "SUB");
+    check_general(xn, "SUB");
+    if (xd.is_64bit() != xn.is_64bit()) {
         throw std::invalid_argument("Mismatched register sizes. Operands for SUB (immediate) must be the same size.");
     }
 
@@ -93,7 +45,7 @@ Instruction Encoder::create_sub_imm(const std::string& xd, const std::string& xn
     // Base opcode for 32-bit SUB (imm) is 0x51000000.
     BitPatcher patcher(0x51000000);
 
-    if (rd_is_64) {
+    if (xd.is_64bit()) {
         patcher.patch(1, 31, 1); // Set the sf bit for 64-bit operation.
     }
 
@@ -101,18 +53,21 @@ Instruction Encoder::create_sub_imm(const std::string& xd, const std::string& xn
     patcher.patch(static_cast<uint32_t>(imm), 10, 12);
 
     // Patch the source and destination registers.
-    patcher.patch(rn_num, 5, 5);
-    patcher.patch(rd_num, 0, 5);
-
-    // (D) Format the assembly string.
-    std::string assembly_text = "SUB " + xd + ", " + xn + ", #" + std::to_string(imm);
+    patcher.patch(xn.encoding(), 5, 5);
+    patcher.patch(xd.encoding(), 0, 5);
 
-    // (E) Return the completed Instruction object.
-    Instruction instr(patcher.get_value(), assembly_text);
+    // (D) Return the completed Instruction object.
+    Instruction instr;
+    instr.encoding = patcher.get_value();
+    instr.assembly_text = (AssemblyText() << "SUB " << xd << ", " << xn << ", #" << imm).intern();
     instr.opcode = InstructionDecoder::OpType::SUB;
-    instr.dest_reg = Encoder::get_reg_encoding(xd);
-    instr.src_reg1 = Encoder::get_reg_encoding(xn);
+    instr.dest_reg = xd.encoding();
+    instr.src_reg1 = xn.encoding();
     instr.immediate = imm;
     instr.uses_immediate = true;
     return instr;
 }
+
+Instruction Encoder::create_sub_imm(const std::string& xd, const std::string& xn, int imm) {
+    return create_sub_imm(parse_register(xd), parse_register(xn), imm);
+}
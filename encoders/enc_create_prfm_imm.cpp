@@ -0,0 +1,55 @@
+#include "Encoder.h"
+#include "AssemblyText.h"
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief Encodes the ARM64 'PRFM' (Prefetch Memory) instruction with an unsigned immediate offset.
+ * @details
+ * This function generates a `PRFM PLDL1KEEP, [<Xn>{, #imm}]` hint, which asks the
+ * core to start loading the cache line at Xn + imm into L1 for a later read.
+ * A prefetch never faults, so the address may lie past the end of the data.
+ *
+ * The encoding follows the "Load/Store Register (unsigned immediate)" format:
+ * - **size (bits 31-30)**: `11`.
+ * - **Family (bits 29-24)**: `0b111001`.
+ * - **opc (bits 23-22)**: `10` for PRFM.
+ * - **imm12 (bits 21-10)**: A 12-bit unsigned immediate, scaled by 8.
+ * - **Rn (bits 9-5)**: The base address register.
+ * - **Rt (bits 4-0)**: The prefetch operation; `00000` is PLDL1KEEP.
+ *
+ * @param xn The base address register (e.g., "x2", "sp").
+ * @param immediate The unsigned byte offset, a multiple of 8 in the range [0, 32760].
+ * @return An `Instruction` object.
+ * @throw std::invalid_argument for an invalid base register or an out-of-range/unaligned immediate.
+ */
+Instruction Encoder::create_prfm_imm(Reg xn, int immediate) {
+    check_general(xn, "PRFM");
+    if (!xn.is_64bit()) {
+        throw std::invalid_argument("PRFM base register must be a 64-bit 'X' register or SP.");
+    }
+    if (immediate % 8 != 0 || immediate < 0 || immediate > 32760) {
+        throw std::invalid_argument("Immediate value out of range or not aligned.");
+    }
+
+    AssemblyText text;
+    text << "PRFM PLDL1KEEP, [" << xn;
+    if (immediate != 0) {
+        text << ", #" << immediate;
+    }
+    text << "]";
+
+    Instruction instr;
+    instr.encoding = 0xF9800000 | ((immediate / 8) << 10) | (xn.encoding() << 5);
+    instr.assembly_text = text.intern();
+    instr.opcode = InstructionDecoder::OpType::PRFM;
+    instr.base_reg = xn.encoding();
+    instr.immediate = immediate;
+    instr.uses_immediate = true;
+    instr.is_mem_op = true;
+    return instr;
+}
+
+Instruction Encoder::create_prfm_imm(const std::string& xn, int immediate) {
+    return create_prfm_imm(parse_register(xn), immediate);
+}
@@ -1,7 +1,6 @@
 #include "BitPatcher.h"
 #include "Encoder.h"
-#include <algorithm>
-#include <cctype>
+#include "AssemblyText.h"
 #include <stdexcept>
 #include <string>
 
@@ -26,38 +25,10 @@
  * @return An `Instruction` object.
  * @throw std::invalid_argument for invalid registers, out-of-range/unaligned immediates, or using a 32-bit base register.
  */
-Instruction Encoder::create_str_imm(const std::string& xt, const std::string& xn, int immediate, const std::string& variable_name) {
-    auto parse_register = [](const std::string& reg_str) -> std::pair<uint32_t, bool> {
-        if (reg_str.empty()) {
-            throw std::invalid_argument("Register string cannot be empty.");
-        }
-        std::string lower_reg = reg_str;
-        std::transform(lower_reg.begin(), lower_reg.end(), lower_reg.begin(), ::tolower);
-        bool is_64bit;
-        uint32_t reg_num;
-        if (lower_reg == "wzr") { is_64bit = false; reg_num = 31;
-        } else if (lower_reg == "xzr") { is_64bit = true; reg_num = 31;
-        } else if (lower_reg == "wsp") { is_64bit = false; reg_num = 31;
-        } else if (lower_reg == "sp") { is_64bit = true; reg_num = 31;
-        } else {
-            char prefix = lower_reg[0];
-            if (prefix == 'w') is_64bit = false;
-            else if (prefix == 'x') is_64bit = true;
-            else throw std::invalid_argument("Invalid register prefix in '" + reg_str + "'. Must be 'w' or 'x'.");
-            try {
-                reg_num = std::stoul(reg_str.substr(1));
-                if (reg_num > 31) throw std::out_of_range("Register number out of range.");
-            } catch(...) {
-                throw std::invalid_argument("Invalid register format: '" + reg_str + "'.");
-            }
-        }
-        return {reg_num, is_64bit};
-    };
-
-    auto [rt_num, rt_is_64] = parse_register(xt);
-    auto [rn_num, rn_is_64] = parse_register(xn);
-
-    if (!rn_is_64) {
+Instruction Encoder::create_str_imm(Reg xt, Reg xn, int immediate, const std::string& variable_name) {
+    check_general(xt, "STR");
+    check_general(xn, "STR");
+    if (!xn.is_64bit()) {
         throw std::invalid_argument("STR base register must be a 64-bit 'X' register or SP.");
     }
 
@@ -65,7 +36,7 @@ Instruction Encoder::create_str_imm(const std::string& xt, const std::string& xn
     int scale;
     int max_offset;
 
-    if (rt_is_64) { // 64-bit STR
+    if (xt.is_64bit()) { // 64-bit STR
         base_opcode = 0xF9000000;
         scale = 8;
         max_offset = 32760;
@@ -84,26 +55,33 @@ Instruction Encoder::create_str_imm(const std::string& xt, const std::string& xn
 
     BitPatcher patcher(base_opcode);
     patcher.patch(imm12, 10, 12);
-    patcher.patch(rn_num, 5, 5);
-    patcher.patch(rt_num, 0, 5);
+    patcher.patch(xn.encoding(), 5, 5);
+    patcher.patch(xt.encoding(), 0, 5);
 
-    std::string assembly_text = "STR " + xt + ", [" + xn;
+    AssemblyText text;
+    text << "STR " << xt << ", [" << xn;
     if (immediate != 0) {
-        assembly_text += ", #" + std::to_string(immediate);
+        text << ", #" << immediate;
     }
-    assembly_text += "]";
+    text << "]";
 
     // Append the variable name to the comment if provided
-    if (!variable_name.empty() && assembly_text.find(variable_name) == std::string::npos) {
-        assembly_text += " ; " + variable_name;
+    if (!variable_name.empty() && !text.contains(variable_name)) {
+        text << " ; " << variable_name;
     }
 
-    Instruction instr(patcher.get_value(), assembly_text);
+    Instruction instr;
+    instr.encoding = patcher.get_value();
+    instr.assembly_text = text.intern();
     instr.opcode = InstructionDecoder::OpType::STR;
-    instr.src_reg1 = Encoder::get_reg_encoding(xt); // The register being stored
-    instr.base_reg = Encoder::get_reg_encoding(xn);
+    instr.src_reg1 = xt.encoding(); // The register being stored
+    instr.base_reg = xn.encoding();
     instr.immediate = immediate;
     instr.uses_immediate = true;
     instr.is_mem_op = true;
     return instr;
 }
+
+Instruction Encoder::create_str_imm(const std::string& xt, const std::string& xn, int immediate, const std::string& variable_name) {
+    return create_str_imm(parse_register(xt), parse_register(xn), immediate, variable_name);
+}
@@ -0,0 +1,40 @@
+#include "Encoder.h"
+#include "BitPatcher.h"
+#include <stdexcept>
+#include <string>
+
+// Implements Encoder::create_strb_imm for the STRB (store byte) instruction.
+// STRB Wt, [Xn, #imm12] -- stores the low byte of Wt to [Xn + imm12]
+
+Instruction Encoder::create_strb_imm(const std::string& wt, const std::string& xn, int immediate) {
+    if (immediate < 0 || immediate > 4095) {
+        throw std::invalid_argument("Immediate for STRB must be an unsigned 12-bit value [0, 4095].");
+    }
+
+    // Base opcode for STRB (unsigned immediate) is 0x39000000
+    BitPatcher patcher(0x39000000);
+
+    // Patch imm12 at bits [21:10]
+    patcher.patch(static_cast<uint32_t>(immediate), 10, 12);
+
+    // Patch Rn (base address register) at bits [9:5]
+    patcher.patch(get_reg_encoding(xn), 5, 5);
+
+    // Patch Rt (source register Wt) at bits [4:0]
+    patcher.patch(get_reg_encoding(wt), 0, 5);
+
+    std::string assembly_text = "STRB " + wt + ", [" + xn;
+    if (immediate != 0) {
+        assembly_text += ", #" + std::to_string(immediate);
+    }
+    assembly_text += "]";
+
+    Instruction instr(patcher.get_value(), assembly_text);
+    instr.opcode = InstructionDecoder::OpType::STRB;
+    instr.src_reg1 = Encoder::get_reg_encoding(wt);
+    instr.base_reg = Encoder::get_reg_encoding(xn);
+    instr.immediate = immediate;
+    instr.uses_immediate = true;
+    instr.is_mem_op = true;
+    return instr;
+}
@@ -1,8 +1,6 @@
 #include "Encoder.h"
 #include <string>
 #include <stdexcept>
-#include <algorithm>
-#include <cctype>
 
 /**
  * @brief Helper function to get the 5-bit integer encoding of a register name.
@@ -10,7 +8,8 @@
  * This function translates a register name string (e.g., "X0", "w1", "sp", "D0", "V0") into
  * its 5-bit hardware encoding (0-31). It is case-insensitive and handles aliases
  * for the stack pointer (SP) and zero register (WZR/XZR), as well as floating-point
- * and vector registers (D0-D31, V0-V31).
+ * and vector registers (D0-D31, V0-V31). Parsing goes through Reg::parse and
+ * does not allocate.
  *
  * @param reg_name The register name as a string.
  * @return The 5-bit integer encoding of the register.
@@ -20,43 +19,32 @@ uint32_t Encoder::get_reg_encoding(const std::string& reg_name) {
     if (reg_name.empty()) {
         throw std::invalid_argument("Register name cannot be empty.");
     }
-
-    // Convert to lowercase for case-insensitive matching.
-    std::string lower_reg = reg_name;
-    std::transform(lower_reg.begin(), lower_reg.end(), lower_reg.begin(), ::tolower);
-
-    // Handle aliases for register 31 first.
-    if (lower_reg == "wzr" || lower_reg == "xzr" || lower_reg == "wsp" || lower_reg == "sp") {
-        return 31;
+    Reg reg = Reg::parse(reg_name);
+    if (!reg.valid()) {
+        throw std::invalid_argument("Invalid register format: " + reg_name);
     }
+    return reg.encoding();
+}
 
-    // Check for a valid alphabetic prefix.
-    char prefix = lower_reg[0];
-    if (!std::isalpha(prefix)) {
-        throw std::invalid_argument("Invalid register prefix in '" + reg_name + "'. Must be a letter.");
+/**
+ * @brief Parses a register name for the string overloads of the encoders.
+ * @throw std::invalid_argument if the name is not a register.
+ */
+Reg Encoder::parse_register(const std::string& reg_name) {
+    Reg reg = Reg::parse(reg_name);
+    if (!reg.valid()) {
+        throw std::invalid_argument("Invalid register format: '" + reg_name + "'.");
     }
+    return reg;
+}
 
-    try {
-        // Handle different register types
-        if (prefix == 'd' || prefix == 'v') { // Added 'v' for vector registers
-            uint32_t reg_num = std::stoul(lower_reg.substr(1));
-            if (reg_num > 31) {
-                throw std::out_of_range("FP/Vector register number " + std::to_string(reg_num) + 
-                                      " is out of the valid range [0, 31].");
-            }
-            return reg_num;
-        } else if (prefix == 'w' || prefix == 'x') {
-            uint32_t reg_num = std::stoul(lower_reg.substr(1));
-            if (reg_num > 31) {
-                throw std::out_of_range("Register number " + std::to_string(reg_num) + 
-                                      " is out of the valid range [0, 31].");
-            }
-            return reg_num;
-        } else {
-            throw std::invalid_argument("Invalid register prefix in '" + reg_name + 
-                                     "'. Must be 'w', 'x', 'd', or 'v'.");
-        }
-    } catch (const std::logic_error&) {
-        throw std::invalid_argument("Invalid register format: " + reg_name);
+/**
+ * @brief Rejects anything but a general-purpose register (W, X, WSP, SP).
+ * @throw std::invalid_argument naming the register and the mnemonic.
+ */
+void Encoder::check_general(Reg reg, const char* mnemonic) {
+    if (!reg.valid() || !reg.is_general()) {
+        throw std::invalid_argument(std::string("Invalid register '") + reg.name() + "' for " + mnemonic +
+                                    ". Must be 'w' or 'x'.");
     }
-}
\ No newline at end of file
+}
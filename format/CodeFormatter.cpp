@@ -605,6 +605,11 @@ void CodeFormatter::visit(ConditionalBranchStatement& node) {
     write_line("IF " + format_expression(node.condition_expr.get()) + " GOTO " + node.targetLabel);
 }
 
+void CodeFormatter::visit(PrefetchStatement& node) {
+    write_indent();
+    write_line("PREFETCH " + format_expression(node.address_expr.get()));
+}
+
 // --- Expressions (for completeness, but handled in format_expression) ---
 void CodeFormatter::visit(NumberLiteral&) {}
 void CodeFormatter::visit(StringLiteral&) {}
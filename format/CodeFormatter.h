@@ -86,6 +86,7 @@ private:
     void visit(FreeStatement& node) override;
     void visit(LabelTargetStatement& node) override;
     void visit(ConditionalBranchStatement& node) override;
+    void visit(PrefetchStatement& node) override;
 
     std::stringstream output_;
     int indent_level_ = 0;
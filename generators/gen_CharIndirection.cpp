@@ -2,6 +2,7 @@
 #include "NewCodeGenerator.h"
 #include "LabelManager.h"
 #include "analysis/ASTAnalyzer.h"
+#include "runtime/runtime.h" // For BCPL_STRING_COMPACT
 
 
 void NewCodeGenerator::visit(CharIndirection& node) {
@@ -18,21 +19,60 @@ void NewCodeGenerator::visit(CharIndirection& node) {
     generate_expression_code(*node.index_expr);
     std::string index_reg = expression_result_reg_; // Holds the index (in bytes)
 
+    std::string effective_addr_reg = register_manager.get_free_register(*this);
+    std::string x_dest_reg = register_manager.get_free_register(*this); // Get X register
+    std::string w_dest_reg = "W" + x_dest_reg.substr(1); // Convert "Xn" to "Wn"
+
+    std::string compact_label;
+    std::string done_label;
+    if (compact_strings_) {
+        compact_label = label_manager_.create_label();
+        done_label = label_manager_.create_label();
+        emit_compact_string_test(string_base_reg, compact_label);
+    }
+
     // Scale index by 4 for 32-bit character access
     emit(Encoder::create_lsl_imm(index_reg, index_reg, 2)); // index_reg <<= 2
 
     // Add the offset to the base address to get the effective memory address
-    std::string effective_addr_reg = register_manager.get_free_register(*this);
     emit(Encoder::create_add_reg(effective_addr_reg, string_base_reg, index_reg));
-    register_manager.release_register(string_base_reg);
-    register_manager.release_register(index_reg);
 
     // Load the 32-bit character value from the effective address into a W register
-    std::string x_dest_reg = register_manager.get_free_register(*this); // Get X register
-    std::string w_dest_reg = "W" + x_dest_reg.substr(1); // Convert "Xn" to "Wn"
     emit(Encoder::create_ldr_word_imm(w_dest_reg, effective_addr_reg, 0)); // Load 32-bit value
+
+    if (compact_strings_) {
+        // Compact strings hold one Latin-1 byte per character.
+        emit(Encoder::create_branch_unconditional(done_label));
+        instruction_stream_.define_label(compact_label);
+        emit(Encoder::create_add_reg(effective_addr_reg, string_base_reg, index_reg));
+        emit(Encoder::create_ldrb_imm(w_dest_reg, effective_addr_reg, 0));
+        instruction_stream_.define_label(done_label);
+    }
+
+    register_manager.release_register(string_base_reg);
+    register_manager.release_register(index_reg);
     register_manager.release_register(effective_addr_reg);
 
-    expression_result_reg_ = w_dest_reg;
+    // Both loads zero-extend into the X register, which is what callers
+    // move into argument registers and combine with other X operands.
+    expression_result_reg_ = x_dest_reg;
     debug_print("Finished visiting CharIndirection node.");
 }
+
+// Branches to compact_label if the string at string_base_reg is compact:
+// the upper half of its length word is exactly BCPL_STRING_COMPACT >> 32.
+void NewCodeGenerator::emit_compact_string_test(const std::string& string_base_reg, const std::string& compact_label) {
+    std::string header_reg = register_manager_.acquire_scratch_reg(*this);
+    std::string flag_reg = register_manager_.acquire_scratch_reg(*this);
+    emit(Encoder::create_sub_imm(header_reg, string_base_reg, 8));
+    emit(Encoder::create_ldr_imm(header_reg, header_reg, 0, "Load string length word"));
+    emit(Encoder::opt_create_ubfx(header_reg, header_reg, 32, 32));
+    // The tag is not a bitmask immediate, so it is built with MOVZ/MOVK.
+    const uint32_t compact_tag = static_cast<uint32_t>(BCPL_STRING_COMPACT >> 32);
+    emit(Encoder::create_movz_imm(flag_reg, compact_tag & 0xFFFF, 0));
+    emit(Encoder::create_movk_imm(flag_reg, compact_tag >> 16, 16));
+    emit(Encoder::create_sub_reg(header_reg, header_reg, flag_reg));
+    emit(Encoder::opt_create_cbz(header_reg, compact_label));
+    register_manager_.release_register(flag_reg);
+    register_manager_.release_register(header_reg);
+}
@@ -138,6 +138,12 @@ void NewCodeGenerator::visit(FunctionCall& node) {
         return;
     }
 
+    // --- Special case for the MAP_* hash map functions ---
+    if (function_name.rfind("MAP_", 0) == 0 && RuntimeManager::instance().is_function_registered(function_name)) {
+        generate_map_call(function_name, node.arguments);
+        return;
+    }
+
     // --- Special case for MAP(list, function) ---
     if (function_name == "MAP" && node.arguments.size() == 2) {
         // 1. Evaluate the list argument (goes into X0)
@@ -195,11 +201,11 @@ void NewCodeGenerator::visit(FunctionCall& node) {
             temp_reg = register_manager_.acquire_spillable_fp_temp_reg(*this);
             emit(Encoder::create_fmov_reg(temp_reg, expression_result_reg_));
         } else {
-            temp_reg = register_manager_.acquire_spillable_temp_reg(*this);
-            emit(Encoder::create_mov_reg(temp_reg, expression_result_reg_));
+            temp_reg = hold_call_argument(expression_result_reg_);
         }
         arg_result_regs.push_back(temp_reg);
     }
+    reload_pushed_arguments(arg_result_regs);
 
     // 1. Determine if the target is a float function based on its return type
     bool is_float_call = false;
@@ -394,3 +400,80 @@ void NewCodeGenerator::visit(FunctionCall& node) {
         debug_print("Function call to '" + target_func_name + "' returned integer value in X0");
     }
 }
+
+// Keeps an evaluated integer argument while the remaining arguments are
+// generated. They may call out, so it moves to a callee-saved temporary;
+// when every callee-saved register holds a live value it is pushed instead,
+// and an empty name stands in for it until reload_pushed_arguments.
+std::string NewCodeGenerator::hold_call_argument(const std::string& value_reg) {
+    register_manager_.release_register(value_reg);
+    std::string temp_reg = register_manager_.acquire_spillable_temp_reg(*this);
+    if (!Reg::parse(temp_reg).is_callee_saved()) {
+        register_manager_.release_register(temp_reg);
+        emit_push_reg(this, value_reg);
+        return "";
+    }
+    if (temp_reg != value_reg) {
+        emit(Encoder::create_mov_reg(temp_reg, value_reg));
+    }
+    return temp_reg;
+}
+
+// Pops the arguments hold_call_argument pushed, last first, into scratch
+// registers. Nothing calls out between here and the call itself.
+void NewCodeGenerator::reload_pushed_arguments(std::vector<std::string>& arg_regs) {
+    for (size_t i = arg_regs.size(); i-- > 0;) {
+        if (!arg_regs[i].empty()) continue;
+        arg_regs[i] = register_manager_.acquire_scratch_reg(*this);
+        emit_pop_reg(this, arg_regs[i]);
+    }
+}
+
+// Calls one of the MAP_* runtime functions. A keyed call passes the key's
+// atom type, as decided by the analyzer, in the register after the key.
+// Keys and values are raw 64-bit patterns, so floats are moved with FMOV
+// instead of being converted.
+void NewCodeGenerator::generate_map_call(const std::string& name, std::vector<ExprPtr>& arguments) {
+    bool keyed = ASTAnalyzer::is_map_keyed_call(name);
+    size_t expected = name == "MAP_NEW" ? 0 : name == "MAP_PUT" ? 3 : keyed ? 2 : 1;
+    if (arguments.size() != expected) {
+        throw std::runtime_error(name + " expects " + std::to_string(expected) + " argument(s).");
+    }
+
+    // Evaluate every argument before loading X0-X3; an argument may call out.
+    std::vector<std::string> arg_regs;
+    for (const auto& arg_expr : arguments) {
+        generate_expression_code(*arg_expr);
+        std::string value_reg = expression_result_reg_;
+        if (register_manager_.is_fp_register(value_reg)) {
+            value_reg = register_manager_.acquire_scratch_reg(*this);
+            emit(Encoder::create_fmov_reg(value_reg, expression_result_reg_));
+        }
+        arg_regs.push_back(hold_call_argument(value_reg));
+    }
+    reload_pushed_arguments(arg_regs);
+
+    // MAP_PUT(map, key, value) becomes BCPL_MAP_PUT(map, key, type, value).
+    int next_arg = 0;
+    for (size_t i = 0; i < arg_regs.size(); ++i) {
+        if (keyed && i == 2) next_arg++;
+        std::string dest_reg = "X" + std::to_string(next_arg++);
+        emit(Encoder::create_mov_reg(dest_reg, arg_regs[i]));
+        register_manager_.release_register(arg_regs[i]);
+        register_manager_.mark_register_as_used(dest_reg);
+    }
+    if (keyed) {
+        int64_t key_type = ASTAnalyzer::getInstance().get_map_key_type(arguments[1].get());
+        emit(Encoder::create_movz_movk_abs64("X2", key_type, ""));
+        register_manager_.mark_register_as_used("X2");
+    }
+
+    emit(Encoder::create_branch_with_link(name));
+
+    if (RuntimeManager::instance().get_function(name).type == FunctionType::FLOAT) {
+        expression_result_reg_ = "D0";
+    } else {
+        expression_result_reg_ = "X0";
+    }
+    register_manager_.mark_register_as_used(expression_result_reg_);
+}
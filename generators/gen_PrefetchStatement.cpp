@@ -0,0 +1,25 @@
+#include "NewCodeGenerator.h"
+#include "AST.h"
+
+void NewCodeGenerator::visit(PrefetchStatement& node) {
+    debug_print("Visiting PrefetchStatement node.");
+    if (!node.address_expr) return;
+
+    // Fold `base + k` into the PRFM offset when k fits the scaled immediate.
+    Expression* base = node.address_expr.get();
+    int offset = 0;
+    if (auto* add = dynamic_cast<BinaryOp*>(base)) {
+        auto* literal = dynamic_cast<NumberLiteral*>(add->right.get());
+        if (add->op == BinaryOp::Operator::Add && literal &&
+            literal->literal_type == NumberLiteral::LiteralType::Integer &&
+            literal->int_value >= 0 && literal->int_value <= 32760 && literal->int_value % 8 == 0) {
+            base = add->left.get();
+            offset = static_cast<int>(literal->int_value);
+        }
+    }
+
+    generate_expression_code(*base);
+    std::string address_reg = expression_result_reg_;
+    emit(Encoder::create_prfm_imm(address_reg, offset));
+    register_manager_.release_register(address_reg);
+}
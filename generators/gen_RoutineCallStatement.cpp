@@ -31,95 +31,6 @@ void NewCodeGenerator::visit(RoutineCallStatement& node) {
         has_symbol = lookup_symbol(routine_name, symbol);
     }
 
-    // Local helper function to save caller-saved registers
-    // Now returns the vector of saved registers and handles stack alignment.
-    auto saveCallerSavedRegisters = [&](std::vector<std::string>& saved_regs) -> bool {
-        debug_print("Saving caller-saved registers...");
-        // Use the specialized method to reset only caller-saved registers
-        // without affecting the routine address cache in X19/X20
-        register_manager_.reset_caller_saved_registers();
-        saved_regs = register_manager_.get_in_use_caller_saved_registers(); // Get and store the exact list
-        int register_count = saved_regs.size();
-        bool align_stack = (register_count % 2 != 0); // Need to align stack if odd number of regs
-
-        std::stringstream saved_regs_ss;
-        saved_regs_ss << "Registers to save: [";
-        for (size_t i = 0; i < saved_regs.size(); ++i) {
-            saved_regs_ss << saved_regs[i] << (i == saved_regs.size() - 1 ? "" : ", ");
-        }
-        saved_regs_ss << "]";
-        debug_print(saved_regs_ss.str());
-
-        // Store pairs of registers using STP (Store Pair) instruction with pre-indexed addressing
-        for (size_t i = 0; i < saved_regs.size(); i += 2) {
-            std::string reg1 = saved_regs[i];
-            std::string reg2 = (i + 1 < saved_regs.size()) ? saved_regs[i + 1] : "ZR"; // Pair with ZR if odd number
-            // FIX 2a: Reverted to create_stp_pre_imm as per your Encoder.h
-            emit(Encoder::create_stp_pre_imm(reg1, reg2, "SP", -16));
-            debug_print("Emitting STP " + reg1 + ", " + reg2 + ", [SP, #-16]!");
-        }
-
-        // Apply final 16-byte alignment if an odd number of actual 8-byte registers were pushed
-        // (i.e., if the last STP used ZR and the stack wasn't already 16-byte aligned by the STPs themselves)
-        // This is necessary if the total bytes pushed by STPs (which are always multiples of 16)
-        // still leaves the stack unaligned relative to the *initial* SP if it was not 16-byte aligned.
-        // Or, more simply, if the _count_ of actual registers is odd, an extra 16 bytes are effectively consumed.
-        if (align_stack) {
-            emit(Encoder::create_sub_imm("SP", "SP", 16));
-            debug_print("Emitting SUB SP, SP, #16 (stack alignment for odd register count).");
-        }
-        debug_print("Finished saving caller-saved registers. Stack aligned: " + std::string(align_stack ? "true" : "false"));
-        return align_stack;
-    };
-
-    // Local helper function to restore caller-saved registers
-    // FIX 3: Removed duplicate definition and fixed signature.
-    // FIX 4: Changed signature to take only the saved_regs vector.
-    auto restoreCallerSavedRegisters = [&](bool align_stack_needed_from_save, const std::vector<std::string>& saved_regs) {
-        debug_print("Restoring caller-saved registers...");
-
-        // Restore stack alignment if it was adjusted during saving
-        if (align_stack_needed_from_save) {
-            emit(Encoder::create_add_imm("SP", "SP", 16));
-            debug_print("Emitting ADD SP, SP, #16 (restoring stack alignment).");
-        }
-
-        std::stringstream restored_regs_ss;
-        restored_regs_ss << "Registers to restore: [";
-        // Iterate backwards through the saved_regs list to restore in reverse order
-        for (int i = saved_regs.size() - 1; i >= 0; --i) {
-            restored_regs_ss << saved_regs[i] << (i == 0 ? "" : ", ");
-        }
-        restored_regs_ss << "]";
-        debug_print(restored_regs_ss.str());
-
-        // Restore pairs of registers using LDP (Load Pair) instruction with post-indexed addressing
-        // Iterate backwards by 2 to match STP pushes.
-        for (int i = saved_regs.size() - 1; i >= 0; i -= 2) {
-            // Ensure we have at least two registers for LDP, or handle the single one if list size is odd.
-            // This robustly handles the case where saved_regs.size() is 1 (e.g., [X10])
-            std::string reg1;
-            std::string reg2;
-
-            if (i == 0 && saved_regs.size() % 2 != 0) { // If only one register left and original count was odd
-                reg1 = saved_regs[0]; // The single remaining register
-                reg2 = "ZR"; // Paired with ZR during STP, so we load 'reg1' and effectively discard ZR from the pair slot
-            } else {
-                // Ensure i-1 is valid for pairing
-                if (i - 1 < 0) {
-                     throw std::runtime_error("Error: Invalid register index during LDP restoration loop.");
-                }
-                reg1 = saved_regs[i - 1];
-                reg2 = saved_regs[i];
-            }
-            // FIX 2b: Reverted to create_ldp_post_imm as per your Encoder.h
-            emit(Encoder::create_ldp_post_imm(reg1, reg2, "SP", 16));
-            debug_print("Emitting LDP " + reg1 + ", " + reg2 + ", [SP], #16");
-        }
-        debug_print("Finished restoring caller-saved registers.");
-    };
-
-
     // Local helper function to evaluate arguments and store them in safe, temporary registers.
     auto evaluateArguments = [&](std::vector<std::string>& arg_result_regs) {
         debug_print("Evaluating routine arguments...");
@@ -281,13 +192,20 @@ void NewCodeGenerator::visit(RoutineCallStatement& node) {
 
     // --- Main Logic for RoutineCallStatement ---
 
-    // Variable to hold the list of registers actually saved
-    std::vector<std::string> actual_saved_caller_saved_regs;
-    bool align_stack_needed_after_save = false; // Flag returned by save, passed to restore
+    // 1. Scratch registers hold temporaries of earlier statements, which are
+    //    dead by now. No allocated variable needs saving: the allocator only
+    //    leaves a parameter in its argument register when no call follows
+    //    while it is live, and gives everything else callee-saved registers.
+    //    The routine address cache in X19/X20 is kept.
+    register_manager_.reset_caller_saved_registers();
 
-    // 1. Save in-use caller-saved registers to the stack
-    align_stack_needed_after_save = saveCallerSavedRegisters(actual_saved_caller_saved_regs);
 
+    // MAP_PUT and friends pass key types the generic path does not know about.
+    if (!routine_name.empty() && routine_name.rfind("MAP_", 0) == 0 &&
+        RuntimeManager::instance().is_function_registered(routine_name)) {
+        generate_map_call(routine_name, node.arguments);
+        return;
+    }
 
     // 2. Evaluate all arguments first and store results in a vector of safe, temporary registers.
     std::vector<std::string> arg_result_regs;
@@ -321,11 +239,7 @@ void NewCodeGenerator::visit(RoutineCallStatement& node) {
         handleGeneralRoutineCall(node.routine_expr.get());
     }
 
-    // 6. Restore in-use caller-saved registers from the stack
-    // Pass the exact list that was saved and the alignment flag.
-    restoreCallerSavedRegisters(align_stack_needed_after_save, actual_saved_caller_saved_regs);
-
-    // 7. Handle the return value
+    // 6. Handle the return value
     debug_print("Handling return value...");
     if (is_float_call) {
         expression_result_reg_ = "D0"; // Float return value is in D0
@@ -135,7 +135,9 @@ void NewCodeGenerator::visit(UnaryOp& node) {
         emit(Encoder::create_str_imm("XZR", header_reg, 8, "Clear tail pointer if it was the removed node")); // Store NULL
         instruction_stream_.define_label(not_tail_label);
 
-        // Move the old head pointer to X0 and call the fast freelist return function.
+        // Pass the old head in X0 and the header in X1 (so the runtime can
+        // drop the list's index), then call the fast freelist return function.
+        emit(Encoder::create_mov_reg("X1", header_reg));
         emit(Encoder::create_mov_reg("X0", old_head_reg));
         emit(Encoder::create_branch_with_link("returnNodeToFreelist"));
 
@@ -257,6 +259,11 @@ void NewCodeGenerator::visit(UnaryOp& node) {
             emit(Encoder::create_sub_imm(base_addr_reg, payload_ptr_reg, 8));
             emit(Encoder::create_ldr_imm(dest_reg, base_addr_reg, 0, "Load vector/table/string length"));
             register_manager_.release_register(base_addr_reg);
+            if (operand_type == VarType::POINTER_TO_STRING) {
+                // The length is the lower half of the word; the upper half
+                // holds the runtime's tag or the compact string flag.
+                emit(Encoder::opt_create_ubfx(dest_reg, dest_reg, 0, 32));
+            }
 
         } else if (
             operand_type == VarType::POINTER_TO_ANY_LIST ||
@@ -2,11 +2,6 @@
 #include "LexerDebug.h"
 #include <cctype>
 
-Token Lexer::peek() const {
-    Lexer temp_lexer = *this;
-    return temp_lexer.get_next_token();
-}
-
 char Lexer::advance() {
     if (!is_at_end()) {
         char current_char = source_[position_++];
@@ -69,25 +64,17 @@ void Lexer::skip_whitespace_and_comments() {
 }
 
 Token Lexer::make_token(TokenType type) const {
-    Token token = {type, "", line_, column_};
+    Token token = {type, {}, line_, column_};
     if (trace_enabled_) {
         LexerTrace("Made token: " + token.to_string());
     }
     return token;
 }
 
-Token Lexer::make_token_with_value(TokenType type, const std::string& value) const {
-    Token token = {type, value, line_, column_};
-     if (trace_enabled_) {
-        LexerTrace("Made token with value: " + token.to_string());
-    }
-    return token;
-}
-
-Token Lexer::make_error_token(const std::string& message) const {
-    Token token = {TokenType::Error, message, line_, column_};
+Token Lexer::make_error_token(std::string message) {
+    Token token = {TokenType::Error, keep_text(std::move(message)), line_, column_};
      if (trace_enabled_) {
         LexerTrace("Made ERROR token: " + token.to_string());
     }
     return token;
-}
\ No newline at end of file
+}
@@ -1,72 +1,96 @@
 #include "Lexer.h"
+#include "InternedString.h"
 #include <cctype>
 #include <string>
 
 Token Lexer::scan_identifier_or_keyword() {
-    std::string value;
+    size_t start = position_;
     int start_col = column_;
-    while (std::isalnum(peek_char()) || peek_char() == '_') {
-        value += advance();
+    // Names never span lines, so scan the source directly and move the
+    // column once. Keywords are spelled with A-Z and '_' only; anything else
+    // skips the keyword lookup.
+    bool maybe_keyword = true;
+    while (position_ < source_.size()) {
+        unsigned char c = static_cast<unsigned char>(source_[position_]);
+        if (!std::isalnum(c) && c != '_') break;
+        maybe_keyword = maybe_keyword && (std::isupper(c) || c == '_');
+        ++position_;
     }
-
-    auto it = keywords_.find(value);
-    if (it != keywords_.end()) {
-        return {it->second, value, line_, start_col};
+    column_ += static_cast<int>(position_ - start);
+    std::string_view text = source_from(start);
+
+    // Identifiers and keywords are interned, so each distinct name is stored
+    // once and its view outlives the Lexer.
+    std::string_view name = InternedString(text).str();
+    if (maybe_keyword) {
+        auto it = keywords_.find(text);
+        if (it != keywords_.end()) {
+            return {it->second, name, line_, start_col};
+        }
     }
-    return {TokenType::Identifier, value, line_, start_col};
+    return {TokenType::Identifier, name, line_, start_col};
 }
 
 Token Lexer::scan_number() {
-    std::string value;
+    size_t start = position_;
     int start_col = column_;
-    bool is_float = false;
 
     if (peek_char() == '#') {
-        value += advance();
+        advance();
         if (peek_char() == 'X' || peek_char() == 'x') {
-            value += advance();
+            advance();
             while (std::isxdigit(peek_char())) {
-                value += advance();
+                advance();
             }
-            return {TokenType::NumberLiteral, value, line_, start_col};
+            return {TokenType::NumberLiteral, source_from(start), line_, start_col};
         }
         while (peek_char() >= '0' && peek_char() <= '7') {
-            value += advance();
+            advance();
         }
-        return {TokenType::NumberLiteral, value, line_, start_col};
+        return {TokenType::NumberLiteral, source_from(start), line_, start_col};
     }
 
     while (std::isdigit(peek_char())) {
-        value += advance();
+        advance();
     }
 
     if (peek_char() == '.') {
-        is_float = true;
-        value += advance();
+        advance();
         while (std::isdigit(peek_char())) {
-            value += advance();
+            advance();
         }
     }
 
     if (peek_char() == 'e' || peek_char() == 'E') {
-        is_float = true;
-        value += advance();
+        advance();
         if (peek_char() == '+' || peek_char() == '-') {
-            value += advance();
+            advance();
         }
         while (std::isdigit(peek_char())) {
-            value += advance();
+            advance();
         }
     }
 
-    return {TokenType::NumberLiteral, value, line_, start_col};
+    return {TokenType::NumberLiteral, source_from(start), line_, start_col};
 }
 
 Token Lexer::scan_string() {
-    std::string value;
     int start_col = column_;
     advance();
+    size_t start = position_;
+
+    // A literal without escapes is a slice of the source; only one that
+    // needs decoding is copied.
+    while (peek_char() != '"' && peek_char() != '*' && !is_at_end()) {
+        advance();
+    }
+    if (peek_char() == '"') {
+        std::string_view value = source_from(start);
+        advance();
+        return {TokenType::StringLiteral, value, line_, start_col};
+    }
 
+    std::string value(source_from(start));
     while (peek_char() != '"' && !is_at_end()) {
         char c = advance();
         if (c == '*') {
@@ -91,11 +115,11 @@ Token Lexer::scan_string() {
     }
 
     advance();
-    return {TokenType::StringLiteral, value, line_, start_col};
+    return {TokenType::StringLiteral, keep_text(std::move(value)), line_, start_col};
 }
 
 Token Lexer::scan_char() {
-    std::string value;
+    std::string_view value;
     int start_col = column_;
     advance();
 
@@ -106,11 +130,11 @@ Token Lexer::scan_char() {
     char c = advance();
     if (c == '*') {
         switch (peek_char()) {
-            case 'n': case 'N': value += '\n'; advance(); break;
-            default: value += advance(); break;
+            case 'n': case 'N': value = "\n"; advance(); break;
+            default: advance(); value = source_from(position_ - 1); break;
         }
     } else {
-        value += c;
+        value = source_from(position_ - 1);
     }
 
     if (peek_char() != '\'') {
@@ -119,4 +143,4 @@ Token Lexer::scan_char() {
     advance();
 
     return {TokenType::CharLiteral, value, line_, start_col};
-}
\ No newline at end of file
+}
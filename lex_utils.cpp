@@ -50,5 +50,5 @@ std::string to_string(TokenType type) {
 }
 
 std::string Token::to_string() const {
-    return "Token(" + ::to_string(type) + ", '" + value + "', L" + std::to_string(line) + " C" + std::to_string(column) + ")";
+    return "Token(" + ::to_string(type) + ", '" + std::string(value) + "', L" + std::to_string(line) + " C" + std::to_string(column) + ")";
 }
\ No newline at end of file
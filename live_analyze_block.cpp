@@ -44,8 +44,9 @@ void LivenessAnalysisPass::analyze_block(BasicBlock* block) {
         ++stmt_idx;
     }
 
-    use_sets_[block] = current_use_set_;
-    def_sets_[block] = current_def_set_;
+    BlockSets& sets = block_sets_[block];
+    sets.use = current_use_set_;
+    sets.def = current_def_set_;
 
     if (trace_enabled_) {
         std::cout << "[LivenessAnalysisPass] Exiting analyze_block for block: " << block->id << std::endl;
@@ -0,0 +1,19 @@
+#include "LivenessAnalysisPass.h"
+#include <algorithm>
+#include <unordered_set>
+
+std::vector<BasicBlock*> LivenessAnalysisPass::compute_block_order(const ControlFlowGraph& cfg) {
+    std::vector<BasicBlock*> order = cfg.get_blocks_in_rpo();
+
+    // Blocks not reachable from the entry still get sets, after the rest.
+    std::unordered_set<BasicBlock*> reached(order.begin(), order.end());
+    std::vector<BasicBlock*> unreached;
+    for (const auto& block_pair : cfg.blocks) {
+        BasicBlock* block = block_pair.second.get();
+        if (block && !reached.count(block)) unreached.push_back(block);
+    }
+    std::sort(unreached.begin(), unreached.end(),
+              [](const BasicBlock* a, const BasicBlock* b) { return a->id < b->id; });
+    order.insert(order.end(), unreached.begin(), unreached.end());
+    return order;
+}
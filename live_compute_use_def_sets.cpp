@@ -5,6 +5,9 @@ void LivenessAnalysisPass::compute_use_def_sets() {
     if (trace_enabled_) {
         std::cout << "[LivenessAnalysisPass] Entering compute_use_def_sets()" << std::endl;
     }
+    block_sets_.clear();
+    functions_.clear();
+    function_index_.clear();
     size_t cfg_count = 0;
     for (const auto& pair : cfgs_) {
         ++cfg_count;
@@ -17,6 +20,19 @@ void LivenessAnalysisPass::compute_use_def_sets() {
         if (trace_enabled_) {
             std::cout << "[LivenessAnalysisPass] CFG #" << cfg_count << " for function '" << pair.first << "' has " << pair.second->blocks.size() << " blocks." << std::endl;
         }
+        // Number this function's variables and fix its block order.
+        function_index_[pair.first] = functions_.size();
+        functions_.emplace_back();
+        FunctionInfo& info = functions_.back();
+        info.name = pair.first;
+        info.block_order = compute_block_order(*pair.second);
+        for (size_t i = 0; i < info.block_order.size(); ++i) {
+            BlockSets& sets = block_sets_[info.block_order[i]];
+            sets.function = functions_.size() - 1;
+            sets.order = i;
+        }
+        current_function_ = &info;
+
         size_t block_count = 0;
         for (const auto& block_pair : pair.second->blocks) {
             ++block_count;
@@ -40,6 +56,7 @@ void LivenessAnalysisPass::compute_use_def_sets() {
             }
         }
     }
+    current_function_ = nullptr;
     if (trace_enabled_) {
         std::cout << "[LivenessAnalysisPass] Exiting compute_use_def_sets()" << std::endl;
     }
@@ -1,6 +1,6 @@
 #include "LivenessAnalysisPass.h"
 
-const std::set<std::string>& LivenessAnalysisPass::get_in_set(BasicBlock* block) const {
-    auto it = in_sets_.find(block);
-    return (it != in_sets_.end()) ? it->second : empty_set_;
+std::set<std::string> LivenessAnalysisPass::get_in_set(BasicBlock* block) const {
+    auto it = block_sets_.find(block);
+    return (it != block_sets_.end()) ? to_names(it->second, it->second.in) : std::set<std::string>();
 }
\ No newline at end of file
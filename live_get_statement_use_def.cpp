@@ -0,0 +1,17 @@
+#include "LivenessAnalysisPass.h"
+
+void LivenessAnalysisPass::get_statement_use_def(const std::string& function_name, Statement& stmt,
+                                                 BitVector& use, BitVector& def) {
+    use.clear();
+    def.clear();
+    auto it = function_index_.find(function_name);
+    if (it == function_index_.end()) return;
+
+    current_function_ = &functions_[it->second];
+    current_use_set_.clear();
+    current_def_set_.clear();
+    stmt.accept(*this);
+    use = current_use_set_;
+    def = current_def_set_;
+    current_function_ = nullptr;
+}
@@ -7,16 +7,17 @@ void LivenessAnalysisPass::print_results() const {
         std::cout << "-------------------------------------------\n";
         for (const auto& block_pair : cfg_pair.second->blocks) {
             BasicBlock* b = block_pair.second.get();
+            const BlockSets& sets = block_sets_.at(b);
             std::cout << "Block ID: " << b->id << "\n";
             
             // Print Use set
             std::cout << "  Use: { ";
-            for(const auto& var : use_sets_.at(b)) std::cout << var << " ";
+            for(const auto& var : to_names(sets, sets.use)) std::cout << var << " ";
             std::cout << "}\n";
 
             // Print Def set
             std::cout << "  Def: { ";
-            for(const auto& var : def_sets_.at(b)) std::cout << var << " ";
+            for(const auto& var : to_names(sets, sets.def)) std::cout << var << " ";
             std::cout << "}\n";
 
             // Print In set
@@ -2,70 +2,71 @@
 #include <iostream>
 #include <exception>
 
+// Liveness flows backwards, so each function's worklist is seeded with its
+// blocks in postorder (the reverse postorder of the reversed CFG): a block is
+// normally visited after its successors. When a block's in-set changes only
+// its predecessors are queued again.
 void LivenessAnalysisPass::run_data_flow_analysis() {
     if (trace_enabled_) {
         std::cout << "[LivenessAnalysisPass] Entering run_data_flow_analysis()" << std::endl;
     }
-    bool changed = true;
-    int iteration = 0;
     try {
-        while (changed) {
-            changed = false;
-            iteration++;
-            if (trace_enabled_) {
-                std::cout << "[LivenessAnalysisPass] Data-flow iteration " << iteration << std::endl;
+        for (const FunctionInfo& info : functions_) {
+            const std::vector<BasicBlock*>& order = info.block_order;
+            size_t variable_count = info.variables.size();
+
+            std::vector<size_t> worklist;
+            std::vector<bool> queued(order.size(), true);
+            worklist.reserve(order.size());
+            for (size_t i = 0; i < order.size(); ++i) {
+                BlockSets& sets = block_sets_[order[i]];
+                sets.in.reserve_bits(variable_count);
+                sets.out.reserve_bits(variable_count);
+                // The worklist is a stack, so push in RPO to pop in postorder.
+                worklist.push_back(i);
             }
-            for (const auto& cfg_pair : cfgs_) {
-                if (!cfg_pair.second) {
-                    if (trace_enabled_) {
-                        std::cout << "[LivenessAnalysisPass] Warning: CFG for function '" << cfg_pair.first << "' is null (data flow)." << std::endl;
-                    }
-                    continue;
-                }
-                const auto& blocks = cfg_pair.second->blocks;
-                // Iterate through blocks (reverse post-order is optimal, but any order works)
-                for (const auto& block_pair : blocks) {
-                    BasicBlock* b = block_pair.second.get();
-                    if (!b) {
+
+            size_t visits = 0;
+            while (!worklist.empty()) {
+                size_t position = worklist.back();
+                worklist.pop_back();
+                queued[position] = false;
+                ++visits;
+
+                BasicBlock* b = order[position];
+                BlockSets& sets = block_sets_[b];
+
+                // 1. out[B] = U in[S] for all successors S
+                sets.out.clear();
+                for (BasicBlock* successor : b->successors) {
+                    if (!successor) {
                         if (trace_enabled_) {
-                            std::cout << "[LivenessAnalysisPass] Warning: Null BasicBlock in function '" << cfg_pair.first << "' (data flow)." << std::endl;
+                            std::cout << "[LivenessAnalysisPass] Warning: Null successor in block " << b->id << std::endl;
                         }
                         continue;
                     }
+                    auto it = block_sets_.find(successor);
+                    if (it != block_sets_.end()) sets.out.union_with(it->second.in);
+                }
 
-                    if (trace_enabled_) {
-                        std::cout << "[LivenessAnalysisPass] Processing block: " << b->id << " in function: " << cfg_pair.first << std::endl;
-                    }
-
-                    // 1. Calculate out[B] = U in[S] for all successors S
-                    std::set<std::string> new_out_set;
-                    for (BasicBlock* successor : b->successors) {
-                        if (!successor) {
-                            if (trace_enabled_) {
-                                std::cout << "[LivenessAnalysisPass] Warning: Null successor in block " << b->id << std::endl;
-                            }
-                            continue;
+                // 2. in[B] = use[B] U (out[B] - def[B]); requeue predecessors on change.
+                if (sets.in.assign_transfer(sets.use, sets.out, sets.def)) {
+                    for (BasicBlock* predecessor : b->predecessors) {
+                        auto it = block_sets_.find(predecessor);
+                        if (it == block_sets_.end() || it->second.function != sets.function) continue;
+                        size_t pred_position = it->second.order;
+                        if (!queued[pred_position]) {
+                            queued[pred_position] = true;
+                            worklist.push_back(pred_position);
                         }
-                        new_out_set.insert(in_sets_[successor].begin(), in_sets_[successor].end());
-                    }
-                    out_sets_[b] = new_out_set;
-
-                    // 2. Calculate in[B] = use[B] U (out[B] - def[B])
-                    std::set<std::string> out_minus_def = out_sets_[b];
-                    for (const auto& def_var : def_sets_[b]) {
-                        out_minus_def.erase(def_var);
-                    }
-                    
-                    std::set<std::string> new_in_set = use_sets_[b];
-                    new_in_set.insert(out_minus_def.begin(), out_minus_def.end());
-
-                    // Check if the 'in' set has changed
-                    if (in_sets_[b] != new_in_set) {
-                        in_sets_[b] = new_in_set;
-                        changed = true;
                     }
                 }
             }
+
+            if (trace_enabled_) {
+                std::cout << "[LivenessAnalysisPass] Function '" << info.name << "': " << order.size()
+                          << " blocks, " << variable_count << " variables, " << visits << " block visits" << std::endl;
+            }
         }
     } catch (const std::exception& ex) {
         std::cerr << "[LivenessAnalysisPass] Exception in run_data_flow_analysis: " << ex.what() << std::endl;
@@ -77,4 +78,4 @@ void LivenessAnalysisPass::run_data_flow_analysis() {
     if (trace_enabled_) {
         std::cout << "[LivenessAnalysisPass] Exiting run_data_flow_analysis()" << std::endl;
     }
-}
\ No newline at end of file
+}
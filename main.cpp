@@ -53,11 +53,13 @@
 #include "analysis/ASTAnalyzer.h"
 #include "passes/ManifestResolutionPass.h"
 #include "LivenessAnalysisPass.h"
+#include "RegisterAllocationPass.h"
 #include "CFGBuilderPass.h"
 #include "analysis/SymbolTableBuilder.h"
 #include "runtime.h"
 #include "version.h"
 #include "PeepholeOptimizer.h"
+#include "PassTimer.h"
 
 // --- Formatter ---
 #include "format/CodeFormatter.h"
@@ -81,12 +83,14 @@ bool parse_arguments(int argc, char* argv[], bool& run_jit, bool& generate_asm,
                     bool& trace_runtime, bool& trace_symbols, bool& trace_heap,
                     bool& trace_preprocessor, bool& enable_preprocessor,
                     bool& dump_jit_stack, bool& enable_peephole, bool& enable_stack_canaries,
-                    bool& format_code,
+                    bool& compact_strings,
+                    bool& format_code, bool& time_passes, std::string& time_passes_json,
                     std::string& input_filepath, std::string& call_entry_name, int& offset_instructions,
                     std::vector<std::string>& include_paths);
 void handle_static_compilation(bool exec_mode, const std::string& base_name, const InstructionStream& instruction_stream, const DataGenerator& data_generator, bool enable_debug_output);
 void* handle_jit_compilation(void* jit_data_memory_base, InstructionStream& instruction_stream, int offset_instructions, bool enable_debug_output);
 void handle_jit_execution(void* code_buffer_base, const std::string& call_entry_name, bool dump_jit_stack, bool enable_debug_output);
+void report_pass_timings(const std::string& json_path);
 
 // =================================================================================
 // Main Execution Logic
@@ -105,6 +109,7 @@ int main(int argc, char* argv[]) {
     bool enable_preprocessor = true;  // Enabled by default
     bool trace_preprocessor = false;
     bool enable_stack_canaries = false;  // Disabled by default
+    bool compact_strings = false;        // Latin-1 string storage (--compact-strings)
 
     // Granular tracing flags for different compiler passes
     bool trace_lexer = false;
@@ -123,6 +128,8 @@ int main(int argc, char* argv[]) {
     g_jit_breakpoint_offset = 0;
     std::vector<std::string> include_paths;
     bool format_code = false; // Add this flag
+    bool time_passes = false;
+    std::string time_passes_json; // JSON report path for --time-passes-json
 
     if (enable_tracing) {
         std::cout << "Debug: About to parse arguments\n";
@@ -132,9 +139,9 @@ int main(int argc, char* argv[]) {
                             trace_lexer, trace_parser, trace_ast, trace_cfg, trace_codegen,
                             trace_optimizer, trace_liveness, trace_runtime, trace_symbols, trace_heap,
                             trace_preprocessor, enable_preprocessor, dump_jit_stack, enable_peephole,
-                            enable_stack_canaries,
+                            enable_stack_canaries, compact_strings,
                             // Insert format_code in the argument list
-                            format_code,
+                            format_code, time_passes, time_passes_json,
                             input_filepath, call_entry_name, g_jit_breakpoint_offset, include_paths)) {
             if (enable_tracing) {
                 std::cout << "Debug: parse_arguments returned false\n";
@@ -158,10 +165,14 @@ int main(int argc, char* argv[]) {
     HeapManager::getInstance().setTraceEnabled(enable_tracing || trace_heap);
     if (enable_tracing || trace_runtime) {
         RuntimeManager::instance().enableTracing();
+        bcpl_set_runtime_trace(1);
     }
 
+    PassTimer::instance().set_enabled(time_passes);
+
     // Apply stack canary setting
     CallFrameManager::setStackCanariesEnabled(enable_stack_canaries);
+    bcpl_set_compact_strings(compact_strings ? 1 : 0);
 
     // Print version if any tracing is enabled
     if (enable_tracing || trace_lexer || trace_parser || trace_ast || trace_cfg ||
@@ -173,6 +184,7 @@ int main(int argc, char* argv[]) {
     SignalHandler::setup();
 
     try {
+        auto preprocess_timing = PassTimer::instance().time("Preprocessor");
         if (enable_preprocessor) {
             Preprocessor preprocessor;
             preprocessor.enableDebug(trace_preprocessor);
@@ -193,6 +205,7 @@ int main(int argc, char* argv[]) {
         } else {
             g_source_code = read_file_content(input_filepath);
         }
+        preprocess_timing.stop();
 
         if (enable_tracing) {
             std::cout << "Compiling this source Code:\n" << g_source_code << std::endl;
@@ -206,9 +219,11 @@ int main(int argc, char* argv[]) {
         }
 
         // --- Parsing and AST Construction ---
+        auto parse_timing = PassTimer::instance().time("Lexer/Parser");
         Lexer lexer(g_source_code, enable_tracing || trace_lexer);
         Parser parser(lexer, enable_tracing || trace_parser);
         ProgramPtr ast = parser.parse_program();
+        parse_timing.stop();
         // ** NEW ERROR HANDLING BLOCK **
         if (!parser.getErrors().empty()) {
             std::cerr << "\nCompilation failed due to the following syntax error(s):" << std::endl;
@@ -239,30 +254,42 @@ int main(int argc, char* argv[]) {
         // --- Semantic and Optimization Passes ---
         static std::unordered_map<std::string, int64_t> g_global_manifest_constants;
         if (enable_tracing || trace_optimizer) std::cout << "Applying Manifest Resolution Pass...\n";
-        ManifestResolutionPass manifest_pass(g_global_manifest_constants);
-        ast = manifest_pass.apply(std::move(ast));
+        {
+            auto timing = PassTimer::instance().time("Manifest Resolution");
+            ManifestResolutionPass manifest_pass(g_global_manifest_constants);
+            ast = manifest_pass.apply(std::move(ast));
+        }
 
         // ---  Build Symbol Table ---
         if (enable_tracing || trace_symbols) std::cout << "Building symbol table...\n";
+        auto symbol_timing = PassTimer::instance().time("Symbol Table Builder");
         SymbolTableBuilder symbol_table_builder(enable_tracing || trace_symbols);
         std::unique_ptr<SymbolTable> symbol_table = symbol_table_builder.build(*ast);
 
         // Register runtime functions in symbol table
         if (enable_tracing || trace_symbols || trace_runtime) std::cout << "Registering runtime functions in symbol table...\n";
         RuntimeSymbols::registerAll(*symbol_table);
+        symbol_timing.stop();
 
 
 
         if (enable_opt) {
             if (enable_tracing || trace_optimizer) std::cout << "Optimization enabled. Applying passes...\n";
-            ConstantFoldingPass constant_folding_pass(g_global_manifest_constants);
-            ast = constant_folding_pass.apply(std::move(ast));
-            StrengthReductionPass strength_reduction_pass(trace_optimizer);
-            strength_reduction_pass.run(*ast);
+            {
+                auto timing = PassTimer::instance().time("Constant Folding");
+                ConstantFoldingPass constant_folding_pass(g_global_manifest_constants);
+                ast = constant_folding_pass.apply(std::move(ast));
+            }
+            {
+                auto timing = PassTimer::instance().time("Strength Reduction");
+                StrengthReductionPass strength_reduction_pass(trace_optimizer);
+                strength_reduction_pass.run(*ast);
+            }
 
             // (CSE pass removed; now handled after CFG construction)
 
             // Loop-Invariant Code Motion Pass (LICM)
+            auto licm_timing = PassTimer::instance().time("Loop-Invariant Code Motion");
             ASTAnalyzer& analyzer = ASTAnalyzer::getInstance();
             LoopInvariantCodeMotionPass licm_pass(
                 g_global_manifest_constants,
@@ -283,6 +310,7 @@ int main(int argc, char* argv[]) {
         }
 
 // Now that we have a symbol table, pass it to the analyzer
+auto analyzer_timing = PassTimer::instance().time("AST Analyzer");
 analyzer.analyze(*ast, symbol_table.get());
 // --- Synchronize improved type info from analyzer to symbol table ---
 for (const auto& func_pair : analyzer.get_function_metrics()) {
@@ -304,13 +332,17 @@ if (enable_tracing || trace_symbols) {
 }
 
 analyzer.transform(*ast);
+analyzer_timing.stop();
 if (enable_tracing || trace_ast) std::cout << "AST transformation complete.\n";
 
 
 
         if (enable_tracing || trace_cfg) std::cout << "Building Control Flow Graphs...\n";
         CFGBuilderPass cfg_builder(enable_tracing || trace_cfg);
-        cfg_builder.build(*ast);
+        {
+            auto timing = PassTimer::instance().time("CFG Builder");
+            cfg_builder.build(*ast);
+        }
         if (enable_tracing || trace_cfg) {
             const auto& cfgs = cfg_builder.get_cfgs();
             for (const auto& pair : cfgs) {
@@ -321,6 +353,7 @@ if (enable_tracing || trace_ast) std::cout << "AST transformation complete.\n";
         // --- Local Optimization Pass (CSE/LVN) ---
         if (enable_opt) {
             if (enable_tracing || trace_optimizer) std::cout << "Applying Local Optimization Pass (CSE/LVN)...\n";
+            auto timing = PassTimer::instance().time("Local Optimization");
             LocalOptimizationPass local_opt_pass;
             local_opt_pass.run(cfg_builder.get_cfgs(), *symbol_table, analyzer);
         }
@@ -328,6 +361,7 @@ if (enable_tracing || trace_ast) std::cout << "AST transformation complete.\n";
 
         if (enable_tracing || trace_liveness) std::cout << "Running Liveness Analysis...\n";
         LivenessAnalysisPass liveness_analyzer(cfg_builder.get_cfgs(), enable_tracing || trace_liveness);
+        auto liveness_timing = PassTimer::instance().time("Liveness Analysis");
         liveness_analyzer.run();
         if (enable_tracing || trace_liveness) {
             liveness_analyzer.print_results();
@@ -336,6 +370,7 @@ if (enable_tracing || trace_ast) std::cout << "AST transformation complete.\n";
 
         if (enable_tracing || trace_liveness) std::cout << "Updating register pressure from liveness data...\n";
         auto pressure_results = liveness_analyzer.calculate_register_pressure();
+        liveness_timing.stop();
 
         // Get a mutable reference to the analyzer's metrics
         auto& function_metrics = ASTAnalyzer::getInstance().get_function_metrics_mut();
@@ -350,6 +385,16 @@ if (enable_tracing || trace_ast) std::cout << "AST transformation complete.\n";
         }
 
 
+        if (enable_tracing || trace_liveness) std::cout << "Running Register Allocation...\n";
+        RegisterAllocationPass register_allocation(cfg_builder.get_cfgs(), liveness_analyzer, enable_tracing || trace_liveness);
+        {
+            auto timing = PassTimer::instance().time("Register Allocation");
+            register_allocation.run();
+        }
+        if (enable_tracing || trace_liveness) {
+            register_allocation.print_results();
+        }
+
         // --- Dump persistent symbol log before code generation if tracing is enabled ---
         if (enable_tracing || trace_symbols) {
             SymbolLogger::getInstance().dumpLog();
@@ -358,6 +403,7 @@ if (enable_tracing || trace_ast) std::cout << "AST transformation complete.\n";
         // --- Code Generation ---
         InstructionStream instruction_stream(LabelManager::instance(), enable_tracing || trace_codegen);
         DataGenerator data_generator(enable_tracing || trace_codegen);
+        data_generator.set_compact_strings(compact_strings);
         RegisterManager& register_manager = RegisterManager::getInstance();
         LabelManager& label_manager = LabelManager::instance();
         int debug_level = (enable_tracing || trace_codegen) ? 5 : 0;
@@ -387,7 +433,12 @@ if (enable_tracing || trace_ast) std::cout << "AST transformation complete.\n";
             std::move(symbol_table), // <-- Pass the populated symbol table
             run_jit // <-- Pass is_jit_mode: true for JIT, false for static/exec
         );
-        code_generator.generate_code(*ast);
+        code_generator.set_register_allocation(&register_allocation);
+        code_generator.set_compact_strings(compact_strings);
+        {
+            auto timing = PassTimer::instance().time("Code Generation");
+            code_generator.generate_code(*ast);
+        }
         if (enable_tracing || trace_codegen) std::cout << "Code generation complete.\n";
 
         // Populate the JIT data segment with initial values for globals
@@ -395,6 +446,7 @@ if (enable_tracing || trace_ast) std::cout << "AST transformation complete.\n";
 
 
         if (enable_peephole) {
+            auto timing = PassTimer::instance().time("Peephole Optimizer");
             PeepholeOptimizer peephole_optimizer(enable_tracing || trace_codegen);
             peephole_optimizer.optimize(instruction_stream);
         }
@@ -403,6 +455,7 @@ if (enable_tracing || trace_ast) std::cout << "AST transformation complete.\n";
         if (generate_asm || exec_mode) {
             // FIX: Strip the file extension to get the base name.
             std::string base_name = input_filepath.substr(0, input_filepath.find_last_of('.'));
+            auto timing = PassTimer::instance().time("Assembly Output");
             handle_static_compilation(exec_mode, base_name, instruction_stream, data_generator, enable_tracing || trace_codegen);
         }
 
@@ -413,6 +466,9 @@ if (enable_tracing || trace_ast) std::cout << "AST transformation complete.\n";
         if (run_jit) {
             void* code_buffer_base = handle_jit_compilation(jit_data_memory_base, instruction_stream, g_jit_breakpoint_offset, enable_tracing || trace_codegen);
 
+            // Compilation is over; report before the program runs.
+            report_pass_timings(time_passes_json);
+
             // --- Populate the runtime function pointer table before populating the data segment and executing code ---
             RuntimeManager::instance().populate_function_pointer_table(jit_data_memory_base);
 
@@ -439,6 +495,8 @@ if (enable_tracing || trace_ast) std::cout << "AST transformation complete.\n";
         return 1;
     }
 
+    if (!run_jit) report_pass_timings(time_passes_json);
+
     if (enable_tracing || trace_runtime || trace_heap) {
         print_runtime_metrics();
     }
@@ -461,7 +519,8 @@ bool parse_arguments(int argc, char* argv[], bool& run_jit, bool& generate_asm,
                     bool& trace_runtime, bool& trace_symbols, bool& trace_heap,
                     bool& trace_preprocessor, bool& enable_preprocessor,
                     bool& dump_jit_stack, bool& enable_peephole, bool& enable_stack_canaries,
-                    bool& format_code,
+                    bool& compact_strings,
+                    bool& format_code, bool& time_passes, std::string& time_passes_json,
                     std::string& input_filepath, std::string& call_entry_name, int& offset_instructions,
                     std::vector<std::string>& include_paths) {
     if (enable_tracing) {
@@ -495,7 +554,18 @@ bool parse_arguments(int argc, char* argv[], bool& run_jit, bool& generate_asm,
         else if (arg == "--no-preprocessor") enable_preprocessor = false;
         else if (arg == "--dump-jit-stack") dump_jit_stack = true;
         else if (arg == "--stack-canaries") enable_stack_canaries = true;
+        else if (arg == "--compact-strings") compact_strings = true;
         else if (arg == "--format") format_code = true;
+        else if (arg == "--time-passes") time_passes = true;
+        else if (arg == "--time-passes-json") {
+            if (i + 1 < argc) {
+                time_passes = true;
+                time_passes_json = argv[++i];
+            } else {
+                std::cerr << "Error: --time-passes-json requires a file path argument" << std::endl;
+                return false;
+            }
+        }
         else if (arg == "--nopt") enable_opt = false;
         else if (arg == "-I" || arg == "--include-path") {
             if (i + 1 < argc) include_paths.push_back(argv[++i]);
@@ -533,6 +603,7 @@ bool parse_arguments(int argc, char* argv[], bool& run_jit, bool& generate_asm,
                       << "  --nopeep               : Disable peephole optimizer.\n"
                       << "  --no-preprocessor      : Disable GET directive processing.\n"
                       << "  --stack-canaries       : Enable stack canaries for buffer overflow detection.\n"
+                      << "  --compact-strings      : Store strings that fit in Latin-1 at one byte per character.\n"
                       << "  -I path, --include-path path : Add directory to include search path for GET directives.\n"
                       << "                          Multiple -I flags can be specified for additional paths.\n"
                       << "                          Search order: 1) Current file's directory 2) Specified include paths\n"
@@ -540,6 +611,9 @@ bool parse_arguments(int argc, char* argv[], bool& run_jit, bool& generate_asm,
                       << "  --call name, -c name   : JIT-call the routine with the given label.\n"
                       << "  --break label[+/-off]  : Insert a BRK #0 instruction at the specified label, with optional offset.\n"
                       << "  --format               : Format BCPL source code and output to stdout.\n"
+                      << "  --time-passes          : Report wall time and peak RSS per compiler pass, and allocations\n"
+                      << "                           in builds made with ./build.sh --count-allocations.\n"
+                      << "  --time-passes-json file: Also write the pass timing report to file as JSON.\n"
                       << "  --help, -h             : Display this help message.\n"
                       << "\n"
                       << "Tracing Options (for debugging and development):\n"
@@ -621,12 +695,15 @@ void* handle_jit_compilation(void* jit_data_memory_base, InstructionStream& inst
     Linker jit_linker;
 
     // Linker runs and assigns final virtual addresses to every instruction
+    auto link_timing = PassTimer::instance().time("Linker");
     std::vector<Instruction> finalized_jit_instructions = jit_linker.process(
         instruction_stream, LabelManager::instance(), RuntimeManager::instance(),
         reinterpret_cast<size_t>(code_buffer_base),
         code_buffer_base, // rodata_base is unused by linker, but pass for consistency
         jit_data_memory_base, enable_debug_output);
+    link_timing.stop();
 
+    auto commit_timing = PassTimer::instance().time("Code Buffer Commit");
     if (enable_debug_output) std::cout << "Populating JIT memory according to linker layout...\n";
 
     // --- START OF FIX ---
@@ -720,6 +797,9 @@ void handle_jit_execution(void* code_buffer_base, const std::string& call_entry_
 
     int64_t jit_result = g_jit_executor->execute(jit_func);
 
+    // Program output is buffered by the runtime; emit it before our own messages.
+    bcpl_flush_output();
+
     if (RuntimeManager::instance().isTracingEnabled()) {
         std::cout << "[JITExecutor] Execution completed. Result: " << jit_result << std::endl;
     }
@@ -730,6 +810,23 @@ void handle_jit_execution(void* code_buffer_base, const std::string& call_entry_
 /**
  * @brief Reads the entire content of a file into a string.
  */
+/**
+ * @brief Prints the --time-passes report to stderr and writes the JSON form if a path was given.
+ */
+void report_pass_timings(const std::string& json_path) {
+    PassTimer& timer = PassTimer::instance();
+    if (!timer.is_enabled()) return;
+    timer.print_report(std::cerr);
+    if (!json_path.empty()) {
+        std::ofstream json(json_path);
+        if (!json) {
+            std::cerr << "Error: Could not open " << json_path << " for the pass timing report." << std::endl;
+            return;
+        }
+        timer.write_json(json);
+    }
+}
+
 std::string read_file_content(const std::string& filepath) {
     std::ifstream file(filepath);
     if (!file.is_open()) {
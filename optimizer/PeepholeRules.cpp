@@ -0,0 +1,307 @@
+#include "PeepholeRules.h"
+#include "../InstructionDecoder.h"
+#include "../InstructionComparator.h"
+
+namespace PeepholeRules {
+namespace {
+
+// The rule table. Earlier rules take priority over later ones.
+constexpr Rule kRules[] = {
+    // --- Constant Folding and Simplification ---
+
+    // ADD Xd, Xn, #0 -> MOV Xd, Xn
+    {"Identity operation elimination (ADD/SUB #0 to MOV)",
+     {OpType::ADD},
+     {uses_immediate(0), value_is(imm(0), 0)},
+     {mov_reg(dest(0), src1(0))}},
+    // SUB Xd, Xn, #0 -> MOV Xd, Xn
+    {"Identity operation elimination (ADD/SUB #0 to MOV)",
+     {OpType::SUB},
+     {uses_immediate(0), value_is(imm(0), 0)},
+     {mov_reg(dest(0), src1(0))}},
+    // MOV Xn, Xn -> (nothing)
+    {"Redundant move elimination (MOV Xn, Xn)",
+     {OpType::MOV},
+     {equal(dest(0), src1(0))},
+     {}},
+
+    // MOV Xt, Xv; ADD Xt, Xt, Xm -> ADD Xt, Xv, Xm
+    // Register variables are read through such copies. The ALU op overwrites
+    // Xt, so the copy is dead and the op can read Xv itself. Only the 64-bit
+    // ORR form of MOV and the unshifted 64-bit register forms are rewritten.
+    {"Copy folded into ALU operand (MOV+ADD/SUB/MUL)",
+     {OpType::MOV, OpType::ADD},
+     {encoding_bits(0, 0xFFE0FFE0u, 0xAA0003E0u), encoding_bits(1, 0xFFE0FC00u, 0x8B000000u),
+      same_register(dest(1), dest(0)), same_register(src1(1), dest(0)), different_register(src2(1), dest(0))},
+     {alu_reg(dest(1), src1(0), src2(1))}},
+    {"Copy folded into ALU operand (MOV+ADD/SUB/MUL)",
+     {OpType::MOV, OpType::SUB},
+     {encoding_bits(0, 0xFFE0FFE0u, 0xAA0003E0u), encoding_bits(1, 0xFFE0FC00u, 0xCB000000u),
+      same_register(dest(1), dest(0)), same_register(src1(1), dest(0)), different_register(src2(1), dest(0))},
+     {alu_reg(dest(1), src1(0), src2(1))}},
+    {"Copy folded into ALU operand (MOV+ADD/SUB/MUL)",
+     {OpType::MOV, OpType::MUL},
+     {encoding_bits(0, 0xFFE0FFE0u, 0xAA0003E0u), encoding_bits(1, 0xFFE0FC00u, 0x9B007C00u),
+      same_register(dest(1), dest(0)), same_register(src1(1), dest(0)), different_register(src2(1), dest(0))},
+     {alu_reg(dest(1), src1(0), src2(1))}},
+
+    // --- Address Calculation and Fusion ---
+
+    // ADRP Xd, label; ADD Xd, Xd, :lo12:label -> ADR Xd, label
+    {"ADR fusion (ADRP+ADD to ADR)",
+     {OpType::ADRP, OpType::ADD},
+     {equal(dest(0), dest(1)), equal(src1(1), dest(0)), present(label(0)), present(label(1)),
+      equal(label(0), label(1))},
+     {adr(dest(0), label(0))}},
+
+    // --- Strength Reduction ---
+
+    // MOVZ Xt, #2^k; MUL Xd, Xn, Xt -> MOVZ Xt, #2^k; LSL Xd, Xn, #k
+    // The MOVZ is kept because nothing here knows whether Xt is still live.
+    // Only the 64-bit MUL form with an unshifted MOVZ is rewritten.
+    {"Multiply by power of two converted to shift",
+     {OpType::MOVZ, OpType::MUL},
+     {power_of_two(imm(0)), encoding_bits(0, 0x00600000u, 0), encoding_bits(1, 0x80000000u, 0x80000000u),
+      same_register(src2(1), dest(0))},
+     {keep(0), lsl_imm(dest(1), src1(1), imm(0))}},
+
+    // --- Memory Optimization ---
+
+    // LDR Rd, [Xn, #o]; LDR Rt, [Xn, #o] -> LDR Rd, [Xn, #o]; MOV Rt, Rd
+    // Rd must not feed the second address (LDR X1, [X2]; LDR X3, [X1]).
+    {"Redundant load elimination (LDR Rd, [..]; LDR Rd, [..] => LDR Rd, [..])",
+     {OpType::LDR, OpType::LDR},
+     {same_register(base(0), base(1)), equal(imm(0), imm(1)), different_register(dest(0), base(1)),
+      different_register(dest(0), src2(1))},
+     {keep(0), mov_reg(dest(1), dest(0))}},
+    // STR Rt, [Xn, #o]; LDR Rt, [Xn, #o] -> STR Rt, [Xn, #o]
+    {"Load-after-store elimination (STR+LDR to STR)",
+     {OpType::STR, OpType::LDR},
+     {same_register(base(0), base(1)), equal(imm(0), imm(1)), same_register(src1(0), dest(1))},
+     {keep(0)}},
+    // STR Ra, [Xn, #o]; STR Rb, [Xn, #o] -> STR Rb, [Xn, #o]
+    {"Dead store elimination (STR+STR to STR)",
+     {OpType::STR, OpType::STR},
+     {same_register(base(0), base(1)), equal(imm(0), imm(1))},
+     {keep(1)}},
+};
+
+constexpr size_t kRuleCount = sizeof(kRules) / sizeof(kRules[0]);
+
+// Sort key for the second level of the tree: single-instruction rules
+// first, then longer rules grouped by their second opcode.
+constexpr int secondKey(const Rule& rule) {
+    return ruleLength(rule) < 2 ? 0 : static_cast<int>(rule.opcodes[1]) + 1;
+}
+
+constexpr size_t tableSize() {
+    size_t size = 0;
+    for (size_t i = 0; i < kRuleCount; ++i) {
+        size_t op = static_cast<size_t>(kRules[i].opcodes[0]) + 1;
+        if (op > size) size = op;
+    }
+    return size;
+}
+
+constexpr size_t kTableSize = tableSize();
+
+// Two-level decision tree over the first two opcodes of a window.
+struct RuleTree {
+    // Rule indices ordered by (first opcode, second key, priority).
+    uint16_t order[kRuleCount] = {};
+    // [begin, end) of the rules in 'order' starting with each opcode.
+    uint16_t begin[kTableSize] = {};
+    uint16_t end[kTableSize] = {};
+};
+
+constexpr bool sortsBefore(size_t a, size_t b) {
+    auto first_a = static_cast<int>(kRules[a].opcodes[0]);
+    auto first_b = static_cast<int>(kRules[b].opcodes[0]);
+    if (first_a != first_b) return first_a < first_b;
+    if (secondKey(kRules[a]) != secondKey(kRules[b])) return secondKey(kRules[a]) < secondKey(kRules[b]);
+    return a < b;
+}
+
+constexpr RuleTree buildTree() {
+    RuleTree tree;
+    for (size_t i = 0; i < kRuleCount; ++i) {
+        // Insertion sort keeps equal keys in priority order.
+        size_t j = i;
+        while (j > 0 && sortsBefore(i, tree.order[j - 1])) {
+            tree.order[j] = tree.order[j - 1];
+            --j;
+        }
+        tree.order[j] = static_cast<uint16_t>(i);
+    }
+    for (size_t i = 0; i < kRuleCount; ++i) {
+        size_t op = static_cast<size_t>(kRules[tree.order[i]].opcodes[0]);
+        if (tree.begin[op] == tree.end[op]) tree.begin[op] = static_cast<uint16_t>(i);
+        tree.end[op] = static_cast<uint16_t>(i + 1);
+    }
+    return tree;
+}
+
+constexpr RuleTree kTree = buildTree();
+
+static_assert(kRuleCount < UINT16_MAX, "RuleTree indices are 16-bit");
+
+int64_t valueOf(const Instruction* window, Field field) {
+    const Instruction& instr = window[field.instr];
+    switch (field.operand) {
+        case Operand::Dest:  return instr.dest_reg;
+        case Operand::Src1:  return instr.src_reg1;
+        case Operand::Src2:  return instr.src_reg2;
+        case Operand::Base:  return instr.base_reg;
+        case Operand::Imm:   return instr.immediate;
+        case Operand::Label: return instr.target_label.id();
+        case Operand::Cond:  return static_cast<int64_t>(instr.cond);
+    }
+    return 0;
+}
+
+bool satisfies(const Constraint& constraint, const Instruction* window) {
+    switch (constraint.test) {
+        case Test::None:
+            return true;
+        case Test::UsesImmediate:
+            return window[constraint.a.instr].uses_immediate;
+        case Test::RegisterForm:
+            return !window[constraint.a.instr].uses_immediate;
+        case Test::ValueIs:
+            return valueOf(window, constraint.a) == constraint.value;
+        case Test::Equal:
+            return valueOf(window, constraint.a) == valueOf(window, constraint.b);
+        case Test::SameRegister:
+            return InstructionComparator::areSameRegister(static_cast<int>(valueOf(window, constraint.a)),
+                                                          static_cast<int>(valueOf(window, constraint.b)));
+        case Test::DifferentRegister:
+            return !InstructionComparator::areSameRegister(static_cast<int>(valueOf(window, constraint.a)),
+                                                           static_cast<int>(valueOf(window, constraint.b)));
+        case Test::PowerOfTwo: {
+            int64_t value = valueOf(window, constraint.a);
+            return value > 0 && (value & (value - 1)) == 0;
+        }
+        case Test::Present:
+            return valueOf(window, constraint.a) != 0;
+        case Test::EncodingBits:
+            return (window[constraint.a.instr].encoding & constraint.mask) == static_cast<uint32_t>(constraint.value);
+    }
+    return false;
+}
+
+bool ruleMatches(const Rule& rule, const Instruction* window, size_t available) {
+    size_t length = ruleLength(rule);
+    if (length > available) return false;
+    for (size_t i = 0; i < length; ++i) {
+        if (window[i].opcode != rule.opcodes[i]) return false;
+    }
+    for (const Constraint& constraint : rule.constraints) {
+        if (!satisfies(constraint, window)) return false;
+    }
+    return true;
+}
+
+int log2Of(int64_t value) {
+    int shift = 0;
+    while (value > 1) {
+        value >>= 1;
+        ++shift;
+    }
+    return shift;
+}
+
+// Replacements are built from 64-bit general-purpose register numbers.
+Reg registerOf(const Instruction* window, Field field) {
+    return Reg::x(static_cast<unsigned>(valueOf(window, field)));
+}
+
+} // namespace
+
+size_t ruleCount() {
+    return kRuleCount;
+}
+
+const char* ruleDescription(size_t rule) {
+    return kRules[rule].description;
+}
+
+bool forEachMatch(const std::vector<Instruction>& instructions, size_t pos,
+                  const std::function<bool(size_t rule, size_t length)>& visit) {
+    const Instruction* window = instructions.data() + pos;
+    size_t available = instructions.size() - pos;
+
+    size_t first = static_cast<size_t>(window[0].opcode);
+    if (first >= kTableSize) return false;
+    size_t begin = kTree.begin[first];
+    size_t end = kTree.end[first];
+
+    // Single-instruction rules sit at the front of the range...
+    size_t single_end = begin;
+    while (single_end < end && secondKey(kRules[kTree.order[single_end]]) == 0) ++single_end;
+
+    // ...followed by one group per second opcode.
+    size_t group = single_end;
+    size_t group_end = single_end;
+    if (available > 1) {
+        int key = static_cast<int>(window[1].opcode) + 1;
+        while (group < end && secondKey(kRules[kTree.order[group]]) < key) ++group;
+        group_end = group;
+        while (group_end < end && secondKey(kRules[kTree.order[group_end]]) == key) ++group_end;
+    }
+
+    // Both groups are in priority order; merge them so the table order decides.
+    size_t single = begin;
+    while (single < single_end || group < group_end) {
+        size_t rule;
+        if (group >= group_end || (single < single_end && kTree.order[single] < kTree.order[group])) {
+            rule = kTree.order[single++];
+        } else {
+            rule = kTree.order[group++];
+        }
+        if (ruleMatches(kRules[rule], window, available) && visit(rule, ruleLength(kRules[rule]))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<Instruction> rewrite(size_t rule, const std::vector<Instruction>& instructions, size_t pos) {
+    const Instruction* window = instructions.data() + pos;
+    std::vector<Instruction> replacements;
+    for (const Replacement& replacement : kRules[rule].replacements) {
+        switch (replacement.emit) {
+            case Emit::None:
+                break;
+            case Emit::Keep:
+                replacements.push_back(window[replacement.a.instr]);
+                break;
+            case Emit::MovReg:
+                replacements.push_back(Encoder::create_mov_reg(registerOf(window, replacement.a),
+                                                               registerOf(window, replacement.b)));
+                break;
+            case Emit::LslImm:
+                replacements.push_back(Encoder::create_lsl_imm(registerOf(window, replacement.a),
+                                                               registerOf(window, replacement.b),
+                                                               log2Of(valueOf(window, replacement.c))));
+                break;
+            case Emit::Adr:
+                replacements.push_back(Encoder::create_adr(registerOf(window, replacement.a).str(),
+                                                           window[replacement.b.instr].target_label));
+                break;
+            case Emit::AluReg: {
+                Reg d = registerOf(window, replacement.a);
+                Reg n = registerOf(window, replacement.b);
+                Reg m = registerOf(window, replacement.c);
+                switch (window[replacement.a.instr].opcode) {
+                    case OpType::ADD: replacements.push_back(Encoder::create_add_reg(d, n, m)); break;
+                    case OpType::SUB: replacements.push_back(Encoder::create_sub_reg(d, n, m)); break;
+                    default:          replacements.push_back(Encoder::create_mul_reg(d, n, m)); break;
+                }
+                break;
+            }
+        }
+    }
+    return replacements;
+}
+
+} // namespace PeepholeRules
@@ -0,0 +1,122 @@
+#pragma once
+#include "../Encoder.h"
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+// Declarative peephole rules.
+//
+// A rule is a short opcode sequence, a list of operand constraints over the
+// matched window and a list of replacement instructions, all written as a
+// constexpr table in PeepholeRules.cpp. The table is compiled at build time
+// into a decision tree keyed on the first two opcodes, so matching costs the
+// same however many rules there are. Adding a rule is one table entry.
+namespace PeepholeRules {
+
+using InstructionDecoder::OpType;
+
+constexpr size_t kMaxRuleLength = 3;
+constexpr size_t kMaxConstraints = 6;
+
+// An operand of one instruction in the matched window.
+enum class Operand : uint8_t { Dest, Src1, Src2, Base, Imm, Label, Cond };
+
+struct Field {
+    uint8_t instr = 0;
+    Operand operand = Operand::Dest;
+};
+
+constexpr Field dest(uint8_t i) { return {i, Operand::Dest}; }
+constexpr Field src1(uint8_t i) { return {i, Operand::Src1}; }
+constexpr Field src2(uint8_t i) { return {i, Operand::Src2}; }
+constexpr Field base(uint8_t i) { return {i, Operand::Base}; }
+constexpr Field imm(uint8_t i) { return {i, Operand::Imm}; }
+constexpr Field label(uint8_t i) { return {i, Operand::Label}; }
+constexpr Field cond(uint8_t i) { return {i, Operand::Cond}; }
+
+enum class Test : uint8_t {
+    None,
+    UsesImmediate,     // a.instr has an immediate operand
+    RegisterForm,      // a.instr has no immediate operand
+    ValueIs,           // a == value
+    Equal,             // a == b
+    SameRegister,      // a and b name the same register
+    DifferentRegister, // a and b do not name the same register
+    PowerOfTwo,        // a is a positive power of two
+    Present,           // a is a non-empty label
+    EncodingBits       // (encoding of a.instr & mask) == value
+};
+
+struct Constraint {
+    Test test = Test::None;
+    Field a;
+    Field b;
+    int64_t value = 0;
+    uint32_t mask = 0;
+};
+
+constexpr Constraint uses_immediate(uint8_t i) { return {Test::UsesImmediate, imm(i), {}, 0, 0}; }
+constexpr Constraint register_form(uint8_t i) { return {Test::RegisterForm, imm(i), {}, 0, 0}; }
+constexpr Constraint value_is(Field a, int64_t value) { return {Test::ValueIs, a, {}, value, 0}; }
+constexpr Constraint equal(Field a, Field b) { return {Test::Equal, a, b, 0, 0}; }
+constexpr Constraint same_register(Field a, Field b) { return {Test::SameRegister, a, b, 0, 0}; }
+constexpr Constraint different_register(Field a, Field b) { return {Test::DifferentRegister, a, b, 0, 0}; }
+constexpr Constraint power_of_two(Field a) { return {Test::PowerOfTwo, a, {}, 0, 0}; }
+constexpr Constraint present(Field a) { return {Test::Present, a, {}, 0, 0}; }
+constexpr Constraint encoding_bits(uint8_t i, uint32_t mask, uint32_t value) {
+    return {Test::EncodingBits, {i, Operand::Dest}, {}, value, mask};
+}
+
+enum class Emit : uint8_t {
+    None,
+    Keep,   // a.instr unchanged
+    MovReg, // MOV a, b
+    LslImm, // LSL a, b, #log2(c)
+    Adr,    // ADR a, label b
+    AluReg  // a.instr's ADD, SUB or MUL as OP a, b, c
+};
+
+struct Replacement {
+    Emit emit = Emit::None;
+    Field a;
+    Field b;
+    Field c;
+};
+
+constexpr Replacement keep(uint8_t i) { return {Emit::Keep, {i, Operand::Dest}, {}, {}}; }
+constexpr Replacement mov_reg(Field d, Field s) { return {Emit::MovReg, d, s, {}}; }
+constexpr Replacement lsl_imm(Field d, Field s, Field power) { return {Emit::LslImm, d, s, power}; }
+constexpr Replacement adr(Field d, Field l) { return {Emit::Adr, d, l, {}}; }
+constexpr Replacement alu_reg(Field d, Field n, Field m) { return {Emit::AluReg, d, n, m}; }
+
+// Opcodes are listed in order; unused trailing slots stay UNKNOWN.
+// An empty replacement list deletes the matched instructions.
+struct Rule {
+    const char* description = "";
+    OpType opcodes[kMaxRuleLength] = {};
+    Constraint constraints[kMaxConstraints] = {};
+    Replacement replacements[kMaxRuleLength] = {};
+};
+
+constexpr size_t ruleLength(const Rule& rule) {
+    size_t length = 0;
+    while (length < kMaxRuleLength && rule.opcodes[length] != OpType::UNKNOWN) ++length;
+    return length;
+}
+
+// Number of rules in the table.
+size_t ruleCount();
+
+// Description of a rule, for statistics and tracing.
+const char* ruleDescription(size_t rule);
+
+// Calls visit(rule, length) for each rule matching at pos, highest priority
+// first, until visit returns true. Returns true if a visit accepted a match.
+bool forEachMatch(const std::vector<Instruction>& instructions, size_t pos,
+                  const std::function<bool(size_t rule, size_t length)>& visit);
+
+// Builds the replacement instructions for a rule that matched at pos.
+std::vector<Instruction> rewrite(size_t rule, const std::vector<Instruction>& instructions, size_t pos);
+
+} // namespace PeepholeRules
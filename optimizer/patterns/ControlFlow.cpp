@@ -6,35 +6,6 @@
 
 namespace PeepholePatterns {
 
-// Compare Zero Branch Pattern: Optimize CMP Xn, #0; B.cond label
-std::unique_ptr<InstructionPattern> createCompareZeroBranchPattern() {
-    return std::make_unique<InstructionPattern>(
-        2, // Pattern size: 2 instructions (CMP followed by B.cond)
-        [](const std::vector<Instruction>& instrs, size_t pos) -> MatchResult {
-            if (pos + 1 >= instrs.size()) return {false, 0};
-            const auto& cmp_instr = instrs[pos];
-            const auto& branch_instr = instrs[pos + 1];
-
-            if (InstructionDecoder::getOpcode(cmp_instr) != InstructionDecoder::OpType::CMP)
-                return {false, 0};
-            if (InstructionDecoder::getOpcode(branch_instr) != InstructionDecoder::OpType::B_COND)
-                return {false, 0};
-
-            // Only optimize CMP Xn, #0
-            if (!InstructionDecoder::usesImmediate(cmp_instr) || InstructionDecoder::getImmediate(cmp_instr) != 0)
-                return {false, 0};
-
-            return {true, 2};
-        },
-        [](const std::vector<Instruction>& instrs, size_t pos) -> std::vector<Instruction> {
-            // For now, just return the original instructions.
-            // In a more advanced optimizer, you could replace with CBZ/CBNZ if the condition matches.
-            return {instrs[pos], instrs[pos + 1]};
-        },
-        "Compare zero branch pattern (CMP Xn, #0; B.cond label)"
-    );
-}
-
 // Branch Chaining Pattern: B label1 ... label1: B label2  =>  B label2 ... label1: B label2
 std::unique_ptr<InstructionPattern> createBranchChainingPattern() {
     return std::make_unique<InstructionPattern>(
@@ -97,7 +68,8 @@ std::unique_ptr<InstructionPattern> createBranchChainingPattern() {
             // If something went wrong, return the original instruction
             return { branch_instr };
         },
-        "Branch chaining (eliminate intermediate unconditional branch)"
+        "Branch chaining (eliminate intermediate unconditional branch)",
+        InstructionPattern::OpcodeList{InstructionDecoder::OpType::B}
     );
 }
 
@@ -57,7 +57,7 @@ DeclPtr Parser::parse_declaration() {
  */
 DeclPtr Parser::parse_label_declaration() {
     TraceGuard guard(*this, "parse_label_declaration");
-    std::string name = current_token_.value;
+    std::string name(current_token_.value);
     consume(TokenType::Identifier, "Expect identifier for label name.");
     consume(TokenType::Colon, "Expect ':' after label name.");
     auto command = parse_statement();
@@ -74,12 +74,12 @@ DeclPtr Parser::parse_manifest_declaration() {
 
     // For simplicity, this parser handles only the first manifest constant.
     // A full implementation would loop until the closing brace.
-    std::string name = current_token_.value;
+    std::string name(current_token_.value);
     consume(TokenType::Identifier, "Expect identifier in manifest declaration.");
     consume(TokenType::Equal, "Expect '=' in manifest declaration.");
 
     // Note: A real compiler would need more robust error handling for stoll.
-    long long value = std::stoll(current_token_.value);
+    long long value = std::stoll(std::string(current_token_.value));
     consume(TokenType::NumberLiteral, "Expect a number for manifest value.");
 
     // Skip other potential manifest constants in the block for this simple parser.
@@ -99,7 +99,7 @@ DeclPtr Parser::parse_static_declaration() {
     consume(TokenType::Static, "Expect 'STATIC'.");
     consume(TokenType::LBrace, "Expect '$(' after STATIC.");
 
-    std::string name = current_token_.value;
+    std::string name(current_token_.value);
     consume(TokenType::Identifier, "Expect identifier in static declaration.");
     consume(TokenType::Equal, "Expect '=' in static declaration.");
     auto initializer = parse_expression();
@@ -123,10 +123,10 @@ DeclPtr Parser::parse_global_declaration() {
     consume(TokenType::LBrace, "Expect '$(' after GLOBAL.");
 
     do {
-        std::string name = current_token_.value;
+        std::string name(current_token_.value);
         consume(TokenType::Identifier, "Expect identifier in global declaration.");
         consume(TokenType::Colon, "Expect ':' separating global name and offset.");
-        int offset = std::stoi(current_token_.value);
+        int offset = std::stoi(std::string(current_token_.value));
         consume(TokenType::NumberLiteral, "Expect number for global offset.");
         globals.push_back({name, offset});
 
@@ -71,6 +71,7 @@ int Parser::get_token_precedence(TokenType type) {
         case TokenType::LParen:
         case TokenType::VecIndirection:
         case TokenType::CharIndirection:
+        case TokenType::CharVectorIndirection:
         case TokenType::FloatVecIndirection:
         case TokenType::Bitfield: // Bitfield operator has high precedence
             return 9;
@@ -124,7 +125,7 @@ ExprPtr Parser::parse_expression(int precedence) {
             left = std::make_unique<FunctionCall>(std::move(left), std::move(args));
         } else if (type == TokenType::VecIndirection) { // Vector Access
             left = std::make_unique<VectorAccess>(std::move(left), parse_expression(9));
-        } else if (type == TokenType::CharIndirection) { // Character Indirection
+        } else if (type == TokenType::CharIndirection || type == TokenType::CharVectorIndirection) { // Character Indirection
             left = std::make_unique<CharIndirection>(std::move(left), parse_expression(9));
         } else if (type == TokenType::FloatVecIndirection) { // Float Vector Indirection
             left = std::make_unique<FloatVectorIndirection>(std::move(left), parse_expression(9));
@@ -220,7 +221,7 @@ ExprPtr Parser::parse_primary_expression() {
     // --- END OF NEW LOGIC ---
 
     if (match(TokenType::NumberLiteral)) {
-        const std::string& val_str = previous_token_.value;
+        std::string val_str(previous_token_.value);
         if (val_str.find('.') != std::string::npos || val_str.find('e') != std::string::npos || val_str.find('E') != std::string::npos) {
             return std::make_unique<NumberLiteral>(std::stod(val_str));
         } else {
@@ -228,7 +229,7 @@ ExprPtr Parser::parse_primary_expression() {
         }
     }
     if (match(TokenType::StringLiteral)) {
-        return std::make_unique<StringLiteral>(previous_token_.value);
+        return std::make_unique<StringLiteral>(std::string(previous_token_.value));
     }
     if (match(TokenType::CharLiteral)) {
         return std::make_unique<CharLiteral>(previous_token_.value[0]);
@@ -280,7 +281,7 @@ ExprPtr Parser::parse_primary_expression() {
     }
     // --- Identifier/function call rule ---
     if (check(TokenType::Identifier)) {
-        auto var = std::make_unique<VariableAccess>(current_token_.value);
+        auto var = std::make_unique<VariableAccess>(std::string(current_token_.value));
         advance();
         return var;
     }
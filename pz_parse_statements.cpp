@@ -39,7 +39,7 @@ StmtPtr Parser::parse_primary_statement() {
 
     // Check for a label target as the start of a statement.
     if (check(TokenType::Identifier) && lexer_.peek().type == TokenType::Colon) {
-        std::string label_name = current_token_.value;
+        std::string label_name(current_token_.value);
         consume(TokenType::Identifier, "Expect identifier for label name.");
         consume(TokenType::Colon, "Expect ':' after label name.");
         return std::make_unique<LabelTargetStatement>(label_name);
@@ -88,14 +88,14 @@ StmtPtr Parser::parse_foreach_statement() {
     std::string loop_var_name, type_var_name;
 
     // Read the first identifier. It could be the loop variable `e` or the type variable `T`.
-    std::string first_var = current_token_.value;
+    std::string first_var(current_token_.value);
     consume(TokenType::Identifier, "Expect at least one variable name after FOREACH.");
 
     // Look ahead to see if there's a comma, which indicates the two-variable form.
     if (match(TokenType::Comma)) {
         // This is the "FOREACH T, V" form.
         type_var_name = first_var; // The first variable was the type.
-        loop_var_name = current_token_.value; // The second variable is the value.
+        loop_var_name = std::string(current_token_.value); // The second variable is the value.
         consume(TokenType::Identifier, "Expect value variable name after comma.");
     } else {
         // This is the single-variable "FOREACH e" form.
@@ -227,7 +227,7 @@ StmtPtr Parser::parse_let_statement() {
 
     std::vector<std::string> names;
     do {
-        names.push_back(current_token_.value);
+        names.emplace_back(current_token_.value);
         consume(TokenType::Identifier, "Expect identifier in LET declaration.");
     } while (match(TokenType::Comma));
 
@@ -315,7 +315,7 @@ StmtPtr Parser::parse_while_statement() {
 StmtPtr Parser::parse_for_statement() {
     TraceGuard guard(*this, "parse_for_statement");
     consume(TokenType::For, "Expect 'FOR'.");
-    std::string var_name = current_token_.value;
+    std::string var_name(current_token_.value);
     consume(TokenType::Identifier, "Expect loop variable name.");
     consume(TokenType::Equal, "Expect '=' after loop variable.");
     auto start_expr = parse_expression();
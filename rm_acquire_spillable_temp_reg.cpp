@@ -4,30 +4,36 @@
 #include <stdexcept>
 
 std::string RegisterManager::acquire_spillable_temp_reg(NewCodeGenerator& code_gen) {
-    // First, try to find a free register in the variable pool.
+    // First, try to find a free register in the variable pool. Registers the
+    // allocation pass bound for the whole function are never free.
     std::string reg = find_free_register(VARIABLE_REGS);
     if (!reg.empty()) {
         registers[reg] = {IN_USE_VARIABLE, "_temp_", false}; // Bind to a temporary name
-        variable_reg_lru_order_.push_front(reg);
         return reg;
     }
 
-    // If no registers are free, spill the least recently used one.
-    std::string victim_reg = variable_reg_lru_order_.back();
-    variable_reg_lru_order_.pop_back();
-    std::string spilled_var = registers.at(victim_reg).bound_to;
+    // If no registers are free, spill the least recently used cached variable.
+    // Temporaries are not in the LRU list: they hold live values until released.
+    if (!variable_reg_lru_order_.empty()) {
+        std::string victim_reg = variable_reg_lru_order_.back();
+        variable_reg_lru_order_.pop_back();
+        std::string spilled_var = registers.at(victim_reg).bound_to;
 
-    if (registers.at(victim_reg).dirty) {
-        Instruction spill_instr = generate_spill_code(victim_reg, spilled_var, *code_gen.get_current_frame_manager());
-        code_gen.emit(spill_instr);
-    }
+        if (registers.at(victim_reg).dirty) {
+            Instruction spill_instr = generate_spill_code(victim_reg, spilled_var, *code_gen.get_current_frame_manager());
+            code_gen.emit(spill_instr);
+        }
 
-    variable_to_reg_map.erase(spilled_var);
-    spilled_variables_.insert(spilled_var);
+        variable_to_reg_map.erase(spilled_var);
+        spilled_variables_.insert(spilled_var);
 
-    // Assign the now-free register for our temporary use.
-    registers[victim_reg] = {IN_USE_VARIABLE, "_temp_", false};
-    variable_reg_lru_order_.push_front(victim_reg);
+        // Assign the now-free register for our temporary use.
+        registers[victim_reg] = {IN_USE_VARIABLE, "_temp_", false};
+        return victim_reg;
+    }
 
-    return victim_reg;
-}
\ No newline at end of file
+    // Every callee-saved register holds a live value. Fall back to a
+    // caller-saved scratch register; a caller that keeps the value across a
+    // call must check Reg::is_callee_saved() and save it itself.
+    return acquire_scratch_reg(code_gen);
+}
@@ -0,0 +1,5 @@
+#include "RegisterManager.h"
+
+void RegisterManager::bind_allocated_register(const std::string& reg_name, const std::string& variable_name) {
+    registers[reg_name] = {IN_USE_ALLOCATED, variable_name, false};
+}
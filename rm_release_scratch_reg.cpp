@@ -1,7 +1,11 @@
 #include "RegisterManager.h"
 
 void RegisterManager::release_scratch_reg(const std::string& reg_name) {
-    if (registers.count(reg_name) && registers.at(reg_name).status == IN_USE_SCRATCH) {
+    if (!registers.count(reg_name)) return;
+    const RegisterInfo& info = registers.at(reg_name);
+    // Spillable temporaries are released like scratch registers; a register
+    // caching a named variable stays bound until it is evicted.
+    if (info.status == IN_USE_SCRATCH || (info.status == IN_USE_VARIABLE && info.bound_to == "_temp_")) {
         registers[reg_name] = {FREE, "", false};
     }
-}
\ No newline at end of file
+}
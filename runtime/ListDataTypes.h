@@ -14,7 +14,7 @@
 // This structure for data nodes remains the same.
 typedef struct ListAtom {
     int32_t type;
-    int32_t pad;
+    int32_t pad;     // Run length on a run's first atom (see LIST_FLAG_CONTIGUOUS), otherwise 0.
     union {
         int64_t int_value;
         double float_value;
@@ -23,13 +23,49 @@ typedef struct ListAtom {
     struct ListAtom* next;
 } ListAtom;
 
+// Atoms between consecutive checkpoints in a ListIndex.
+#define LIST_INDEX_STRIDE 8
+
+// Positional index over a list's atom chain, built lazily by
+// BCPL_LIST_GET_NTH. checkpoints[i] is the atom at position
+// i * LIST_INDEX_STRIDE, so any element is at most LIST_INDEX_STRIDE - 1
+// hops from a checkpoint. Appends leave existing checkpoints valid; an
+// index whose 'head' no longer matches the list is rebuilt.
+typedef struct ListIndex {
+    ListAtom* head;          // list head the checkpoints were built from
+    int64_t   count;         // checkpoints filled in
+    int64_t   capacity;      // checkpoints allocated
+    ListAtom* checkpoints[1];
+} ListIndex;
+
 // **NEW:** A dedicated, unambiguous structure for the list header.
+// ListHeader.flags bits.
+// Set while the atoms are laid out in address order in runs averaging at
+// least LIST_CONTIGUOUS_MIN_RUN atoms, so FOREACH can step through the list
+// by sizeof(ListAtom) and only occasionally fall back to the 'next' pointer.
+// A run's first atom holds in 'pad' how many atoms follow it at the next
+// addresses in list order; FOREACH steps exactly that many before chasing
+// 'next' again, so the flag never depends on where an atom happens to sit.
+#define LIST_FLAG_CONTIGUOUS 1
+// Set on every header the runtime creates. Read-only list literals use the
+// shorter ListLiteralHeader, which has no index or length at the ListHeader
+// offsets and whose flags word is always 0.
+#define LIST_FLAG_RUNTIME 2
+#define LIST_CONTIGUOUS_MIN_RUN 64
+// How many atoms ahead of the cursor FOREACH prefetches while inside a run.
+#define LIST_FOREACH_PREFETCH_ATOMS 16
+
 typedef struct ListHeader {
     int32_t  type;       // **ALWAYS** set to ATOM_SENTINEL
-    int32_t  pad;
+    int32_t  flags;      // LIST_FLAG_* bits
     int64_t  length;     // Dedicated 8 bytes for length.
     ListAtom* head;      // 8-byte pointer to the first data node.
     ListAtom* tail;      // 8-byte pointer to the last data node for O(1) appends.
+    ListIndex* index;    // Runtime-only; lazily built by BCPL_LIST_GET_NTH, may be NULL.
+    int64_t  runs;       // Runtime-only; runs of address-adjacent atoms appended so far.
+    void*    strings;    // Runtime-only; one string block holding the records of string atoms
+                         // (see SPLIT), released with the list. May be NULL.
+    ListAtom* run_head;  // Runtime-only; first atom of the run the tail belongs to.
 } ListHeader;
 
 // A helper struct to mirror the layout of read-only list literals
@@ -46,5 +82,6 @@ typedef struct ListLiteralHeader {
 #define LIST_ATOM_TYPE_OFFSET   offsetof(ListAtom, type)
 #define LIST_ATOM_VALUE_OFFSET  offsetof(ListAtom, value)
 #define LIST_ATOM_NEXT_OFFSET   offsetof(ListAtom, next)
+#define LIST_HEADER_FLAGS_OFFSET offsetof(ListHeader, flags)
 
 #endif // LIST_DATA_TYPES_H
\ No newline at end of file
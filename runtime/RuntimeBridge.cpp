@@ -3,6 +3,7 @@
 
 #include "RuntimeBridge.h"
 #include "runtime.h"
+#include "../HeapManager/heap_manager_defs.h"
 #include "../RuntimeManager.h"
 #include <iostream>
 #include <string>
@@ -29,7 +30,7 @@ extern "C" {
     // Free list helpers
     void BCPL_FREE_CELLS(void);
     void* get_g_free_list_head_address(void);
-    void returnNodeToFreelist_runtime(void*);
+    void returnNodeToFreelist_runtime(void*, void*);
 }
 
 
@@ -50,6 +51,8 @@ void register_runtime_functions() {
     register_runtime_function("BCPL_ALLOC_CHARS", 1, reinterpret_cast<void*>(bcpl_alloc_chars));
     register_runtime_function("MALLOC", 1, reinterpret_cast<void*>(bcpl_alloc_words)); // Alias for compatibility
     register_runtime_function("FREEVEC", 1, reinterpret_cast<void*>(bcpl_free));
+    register_runtime_function("ARENA_PUSH", 0, reinterpret_cast<void*>(ARENA_PUSH));
+    register_runtime_function("ARENA_POP", 0, reinterpret_cast<void*>(ARENA_POP));
     register_runtime_function("BCPL_FREE_LIST", 1, reinterpret_cast<void*>(bcpl_free_list));
     register_runtime_function("BCPL_LIST_GET_HEAD_AS_INT", 1, reinterpret_cast<void*>(BCPL_LIST_GET_HEAD_AS_INT));
     register_runtime_function("BCPL_LIST_GET_HEAD_AS_FLOAT", 1, reinterpret_cast<void*>(BCPL_LIST_GET_HEAD_AS_FLOAT), FunctionType::FLOAT);
@@ -85,6 +88,7 @@ void register_runtime_functions() {
     // List copy functions
     register_runtime_function("COPYLIST", 1, reinterpret_cast<void*>(BCPL_SHALLOW_COPY_LIST));
     register_runtime_function("DEEPCOPYLIST", 1, reinterpret_cast<void*>(BCPL_DEEP_COPY_LIST));
+    register_runtime_function("COMPACTLIST", 1, reinterpret_cast<void*>(COMPACTLIST));
     // Register the new function for handling list literals
     register_runtime_function("DEEPCOPYLITERALLIST", 1, reinterpret_cast<void*>(BCPL_DEEP_COPY_LITERAL_LIST));
     register_runtime_function("REVERSE", 1, reinterpret_cast<void*>(BCPL_REVERSE_LIST));
@@ -102,15 +106,39 @@ void register_runtime_functions() {
     register_runtime_function("PACKSTRING", 1, reinterpret_cast<void*>(PACKSTRING));
     register_runtime_function("UNPACKSTRING", 1, reinterpret_cast<void*>(UNPACKSTRING));
     
+    // Hash map functions. The code generator passes each key's atom type
+    // after the key, so the keyed calls take one more argument than in source.
+    register_runtime_function("MAP_NEW", 0, reinterpret_cast<void*>(BCPL_MAP_NEW));
+    register_runtime_function("MAP_FREE", 1, reinterpret_cast<void*>(BCPL_MAP_FREE));
+    register_runtime_function("MAP_PUT", 4, reinterpret_cast<void*>(BCPL_MAP_PUT));
+    register_runtime_function("MAP_GET", 3, reinterpret_cast<void*>(BCPL_MAP_GET));
+    register_runtime_function("MAP_GETF", 3, reinterpret_cast<void*>(BCPL_MAP_GET_FLOAT), FunctionType::FLOAT);
+    register_runtime_function("MAP_HAS", 3, reinterpret_cast<void*>(BCPL_MAP_HAS));
+    register_runtime_function("MAP_DEL", 3, reinterpret_cast<void*>(BCPL_MAP_DEL));
+    register_runtime_function("MAP_SIZE", 1, reinterpret_cast<void*>(BCPL_MAP_SIZE));
+    register_runtime_function("MAP_KEYS", 1, reinterpret_cast<void*>(BCPL_MAP_KEYS));
+
+    // String builder functions
+    register_runtime_function("STRBUILDER", 0, reinterpret_cast<void*>(BCPL_SB_NEW));
+    register_runtime_function("SB_FREE", 1, reinterpret_cast<void*>(BCPL_SB_FREE));
+    register_runtime_function("SB_APPEND", 2, reinterpret_cast<void*>(BCPL_SB_APPEND));
+    register_runtime_function("SB_APPENDC", 2, reinterpret_cast<void*>(BCPL_SB_APPEND_CHAR));
+    register_runtime_function("SB_APPENDN", 2, reinterpret_cast<void*>(BCPL_SB_APPEND_INT));
+    register_runtime_function("SB_LENGTH", 1, reinterpret_cast<void*>(BCPL_SB_LENGTH));
+    register_runtime_function("TOSTRING", 1, reinterpret_cast<void*>(BCPL_SB_TOSTRING));
+
     // File I/O functions
     register_runtime_function("SLURP", 1, reinterpret_cast<void*>(SLURP));
     register_runtime_function("SPIT", 2, reinterpret_cast<void*>(SPIT));
+    register_runtime_function("FOPEN", 1, reinterpret_cast<void*>(FOPEN));
+    register_runtime_function("READLINE", 2, reinterpret_cast<void*>(READLINE));
+    register_runtime_function("FCLOSE", 1, reinterpret_cast<void*>(FCLOSE));
     
     // System functions
     register_runtime_function("FINISH", 0, reinterpret_cast<void*>(finish));
     
     // Register fast freelist return for TL
-    register_runtime_function("returnNodeToFreelist", 1, reinterpret_cast<void*>(returnNodeToFreelist_runtime));
+    register_runtime_function("returnNodeToFreelist", 2, reinterpret_cast<void*>(returnNodeToFreelist_runtime));
 
     if (manager.isTracingEnabled()) {
         std::cout << "Registered " << manager.get_registered_functions().size() 
@@ -139,6 +167,7 @@ extern "C" void initialize_freelist();
 
 void initialize_runtime() {
     initialize_freelist(); // Pre-allocate freelist nodes at startup
+    register_runtime_metrics_reporter(bcpl_print_list_metrics);
     if (RuntimeManager::instance().isTracingEnabled()) {
         std::cout << "BCPL Runtime v" << BCPL_RUNTIME_VERSION << " initialized" << std::endl;
     }
@@ -81,6 +81,24 @@ void* bcpl_alloc_chars(int64_t num_chars) {
     return ptr;
 }
 
+void* bcpl_alloc_compact_chars(int64_t num_chars) {
+    if (num_chars < 0) {
+        std::cerr << "ERROR: Attempted to allocate compact string with "
+                  << num_chars << " chars" << std::endl;
+        return nullptr;
+    }
+    return HeapManager::getInstance().allocCompactString(num_chars);
+}
+
+void* bcpl_resize_chars(void* payload, int64_t num_chars) {
+    if (num_chars < 0) {
+        std::cerr << "ERROR: Attempted to resize string to "
+                  << num_chars << " chars" << std::endl;
+        return nullptr;
+    }
+    return HeapManager::getInstance().resizeString(payload, num_chars);
+}
+
 void bcpl_free(void* ptr) {
     if (!ptr) return;
     
@@ -91,4 +109,12 @@ void bcpl_free(void* ptr) {
     HeapManager::getInstance().free(ptr);
 }
 
+void ARENA_PUSH(void) {
+    HeapManager::getInstance().arenaPush();
+}
+
+void ARENA_POP(void) {
+    HeapManager::getInstance().arenaPop();
+}
+
 } // extern "C"
\ No newline at end of file
@@ -14,10 +14,28 @@ ListAtom* g_free_list_head = NULL;
 ListHeader* g_header_free_list_head = NULL;
 
 // === Freelist Metrics and Constants ===
+// List atoms are carved from LIST_CHUNK_BYTES chunks aligned to their own
+// size, so the chunk owning any atom is found by masking its address. Each
+// chunk counts how many of its atoms are on the freelist; a chunk whose
+// atoms are all free can be handed back to the OS.
+#define LIST_CHUNK_BYTES (256 * 1024)
+
+typedef struct ListChunk {
+    struct ListChunk* prev;
+    struct ListChunk* next;
+    size_t free_nodes;     // Atoms of this chunk currently on the freelist
+    size_t releasing;      // Set while releaseEmptyChunks is unlinking it
+} ListChunk;
+
+static const size_t LIST_CHUNK_NODES = (LIST_CHUNK_BYTES - sizeof(ListChunk)) / sizeof(ListAtom);
+static const size_t HEADER_FREELIST_CHUNK_SIZE = 2048; // 2k headers
+
 static size_t g_freelist_node_count = 0;
 static size_t g_total_nodes_allocated_from_heap = 0;
-static const size_t INITIAL_FREELIST_CHUNK_SIZE = 8192; // 8k nodes
-static const size_t HEADER_FREELIST_CHUNK_SIZE = INITIAL_FREELIST_CHUNK_SIZE / 4; // 2048 headers
+static ListChunk* g_list_chunks = NULL;   // Every chunk currently allocated
+static size_t g_list_chunk_count = 0;
+static size_t g_empty_chunk_count = 0;    // Chunks whose atoms are all free
+static size_t g_list_chunks_released = 0;
 
 // === Freelist Management ===
 
@@ -56,23 +74,115 @@ static void returnHeaderToFreelist(ListHeader* header) {
 }
 // --- END NEW ---
 
+static inline ListChunk* chunkOf(const ListAtom* node) {
+    return (ListChunk*)((uintptr_t)node & ~(uintptr_t)(LIST_CHUNK_BYTES - 1));
+}
+
+static inline ListAtom* chunkNodes(ListChunk* chunk) {
+    return (ListAtom*)(chunk + 1);
+}
+
+// Bookkeeping for an atom leaving the freelist.
+static inline void noteNodeTaken(ListAtom* node) {
+    ListChunk* chunk = chunkOf(node);
+    if (chunk->free_nodes-- == LIST_CHUNK_NODES) g_empty_chunk_count--;
+    g_freelist_node_count--;
+}
+
+// Bookkeeping for an atom joining the freelist.
+static inline void noteNodeFreed(ListAtom* node) {
+    ListChunk* chunk = chunkOf(node);
+    if (++chunk->free_nodes == LIST_CHUNK_NODES) g_empty_chunk_count++;
+    g_freelist_node_count++;
+}
+
+// Allocates a chunk with none of its atoms on the freelist yet.
+static ListChunk* allocateChunk() {
+    void* memory;
+    if (posix_memalign(&memory, LIST_CHUNK_BYTES, LIST_CHUNK_BYTES) != 0) {
+        exit(1); // Out of memory
+    }
+    ListChunk* chunk = (ListChunk*)memory;
+    chunk->prev = NULL;
+    chunk->next = g_list_chunks;
+    chunk->free_nodes = 0;
+    chunk->releasing = 0;
+    if (g_list_chunks) g_list_chunks->prev = chunk;
+    g_list_chunks = chunk;
+    g_list_chunk_count++;
+    g_total_nodes_allocated_from_heap += LIST_CHUNK_NODES;
+    return chunk;
+}
+
+// Threads atoms [first, LIST_CHUNK_NODES) of a chunk onto the freelist in
+// address order, so consecutive pops hand out adjacent atoms.
+static void pushChunkNodes(ListChunk* chunk, size_t first) {
+    ListAtom* nodes = chunkNodes(chunk);
+    for (size_t i = first; i < LIST_CHUNK_NODES - 1; ++i) {
+        nodes[i].next = &nodes[i + 1];
+    }
+    nodes[LIST_CHUNK_NODES - 1].next = g_free_list_head;
+    g_free_list_head = &nodes[first];
+    chunk->free_nodes += LIST_CHUNK_NODES - first;
+    g_freelist_node_count += LIST_CHUNK_NODES - first;
+    if (chunk->free_nodes == LIST_CHUNK_NODES) g_empty_chunk_count++;
+}
+
 // Pre-allocate a new chunk of nodes and add them to the freelist.
 static void replenishFreelist() {
-    size_t nodes_to_alloc = INITIAL_FREELIST_CHUNK_SIZE;
-    ListAtom* new_chunk = (ListAtom*)malloc(sizeof(ListAtom) * nodes_to_alloc);
-    if (!new_chunk) {
-        exit(1); // Out of memory
+    pushChunkNodes(allocateChunk(), 0);
+}
+
+// Returns fully free chunks to the OS, keeping 'keep' of them as a reserve
+// against bursty reuse. Their atoms are unlinked in one pass over the freelist.
+static void releaseEmptyChunks(size_t keep) {
+    if (g_empty_chunk_count <= keep) return;
+
+    size_t kept = 0;
+    for (ListChunk* chunk = g_list_chunks; chunk; chunk = chunk->next) {
+        if (chunk->free_nodes != LIST_CHUNK_NODES) continue;
+        if (kept < keep) {
+            kept++;
+        } else {
+            chunk->releasing = 1;
+        }
+    }
+
+    ListAtom** link = &g_free_list_head;
+    while (*link) {
+        if (chunkOf(*link)->releasing) {
+            *link = (*link)->next;
+        } else {
+            link = &(*link)->next;
+        }
     }
-    g_total_nodes_allocated_from_heap += nodes_to_alloc;
-    // Link all the new nodes together in a chain.
-    for (size_t i = 0; i < nodes_to_alloc - 1; ++i) {
-        new_chunk[i].next = &new_chunk[i + 1];
+
+    ListChunk* chunk = g_list_chunks;
+    while (chunk) {
+        ListChunk* next = chunk->next;
+        if (chunk->releasing) {
+            if (chunk->prev) chunk->prev->next = next;
+            else g_list_chunks = next;
+            if (next) next->prev = chunk->prev;
+            g_freelist_node_count -= LIST_CHUNK_NODES;
+            g_total_nodes_allocated_from_heap -= LIST_CHUNK_NODES;
+            g_empty_chunk_count--;
+            g_list_chunk_count--;
+            g_list_chunks_released++;
+            free(chunk);
+        }
+        chunk = next;
+    }
+}
+
+// Releases empty chunks once they hold at least a quarter of the freelist,
+// so each sweep of the freelist is paid for by the atoms it gives back.
+// One empty chunk is always kept in reserve.
+static void maybeReleaseEmptyChunks() {
+    if (g_empty_chunk_count > 1 &&
+        g_empty_chunk_count * LIST_CHUNK_NODES * 4 >= g_freelist_node_count) {
+        releaseEmptyChunks(1);
     }
-    new_chunk[nodes_to_alloc - 1].next = NULL; // Last node points to null.
-    // Prepend this new chunk to the (potentially empty) existing freelist.
-    new_chunk[nodes_to_alloc - 1].next = g_free_list_head;
-    g_free_list_head = new_chunk;
-    g_freelist_node_count += nodes_to_alloc;
 }
 
 // Get a node from the freelist, replenishing if necessary.
@@ -82,7 +192,7 @@ static ListAtom* getNodeFromFreelist() {
     }
     ListAtom* node = g_free_list_head;
     g_free_list_head = g_free_list_head->next;
-    g_freelist_node_count--;
+    noteNodeTaken(node);
     return node;
 }
 
@@ -91,7 +201,34 @@ static void returnNodeToFreelist(ListAtom* node) {
     if (!node) return;
     node->next = g_free_list_head;
     g_free_list_head = node;
-    g_freelist_node_count++;
+    noteNodeFreed(node);
+}
+
+// Links a fresh node after the list's tail, tracking LIST_FLAG_CONTIGUOUS.
+// Nodes popped from a fresh chunk, or from a freed list spliced back in
+// order, are adjacent, so a list built in one go breaks its run only at
+// chunk boundaries and keeps the flag. The caller bumps 'length' afterwards.
+static inline void linkNodeAtTail(ListHeader* header, ListAtom* node) {
+    node->pad = 0;
+    if (header->head == NULL) {
+        header->head = node;
+        header->runs = 1;
+        header->run_head = node;
+    } else {
+        if (node == header->tail + 1 && header->run_head) {
+            header->run_head->pad++;
+        } else {
+            header->runs++;
+            header->run_head = node;
+        }
+        header->tail->next = node;
+    }
+    header->tail = node;
+    if (header->runs * LIST_CONTIGUOUS_MIN_RUN <= header->length + 1) {
+        header->flags |= LIST_FLAG_CONTIGUOUS;
+    } else {
+        header->flags &= ~LIST_FLAG_CONTIGUOUS;
+    }
 }
 
 // Freelist initializer for runtime startup.
@@ -126,10 +263,28 @@ extern "C" void initialize_freelist() {
         return HeapManager::getInstance().allocString(num_chars);
     }
 
+    void* bcpl_alloc_compact_chars(int64_t num_chars) {
+        if (num_chars < 0) return nullptr;
+        return HeapManager::getInstance().allocCompactString(num_chars);
+    }
+
+    void* bcpl_resize_chars(void* payload, int64_t num_chars) {
+        if (num_chars < 0) return nullptr;
+        return HeapManager::getInstance().resizeString(payload, num_chars);
+    }
+
     void bcpl_free(void* ptr) {
         if (!ptr) return;
         HeapManager::getInstance().free(ptr);
     }
+
+    void ARENA_PUSH(void) {
+        HeapManager::getInstance().arenaPush();
+    }
+
+    void ARENA_POP(void) {
+        HeapManager::getInstance().arenaPop();
+    }
 #else
 
 extern "C" {
@@ -155,7 +310,7 @@ extern "C" {
             return NULL;
         }
         // Store the number of characters in the first 8 bytes
-        ptr[0] = num_chars;
+        ptr[0] = (uint64_t)num_chars | BCPL_STRING_TRUSTED;
         uint32_t* payload = (uint32_t*)(ptr + 1);
         // Add the null terminator at the end of the string
         payload[num_chars] = 0;
@@ -163,6 +318,33 @@ extern "C" {
         return (void*)payload;
     }
 
+    void* bcpl_alloc_compact_chars(int64_t num_chars) {
+        if (num_chars < 0) return NULL;
+        // Length word with the compact flag, one byte per character, then the terminator
+        uint64_t* ptr = (uint64_t*)malloc(sizeof(uint64_t) + num_chars + 1);
+        if (!ptr) {
+            return NULL;
+        }
+        ptr[0] = (uint64_t)num_chars | BCPL_STRING_COMPACT;
+        uint8_t* payload = (uint8_t*)(ptr + 1);
+        payload[num_chars] = 0;
+        return (void*)payload;
+    }
+
+    void* bcpl_resize_chars(void* payload, int64_t num_chars) {
+        if (num_chars < 0) return NULL;
+        if (!payload) return bcpl_alloc_chars(num_chars);
+        size_t total_size = sizeof(uint64_t) + (num_chars + 1) * sizeof(uint32_t);
+        uint64_t* ptr = (uint64_t*)realloc(((uint64_t*)payload) - 1, total_size);
+        if (!ptr) {
+            return NULL;
+        }
+        ptr[0] = (uint64_t)num_chars | BCPL_STRING_TRUSTED;
+        uint32_t* resized = (uint32_t*)(ptr + 1);
+        resized[num_chars] = 0;
+        return (void*)resized;
+    }
+
     void bcpl_free(void* payload) {
         if (!payload) {
             return;
@@ -172,26 +354,60 @@ extern "C" {
         uint64_t* original_ptr = ((uint64_t*)payload) - 1;
         free(original_ptr);
     }
+
+    // Regions need the HeapManager; without it blocks stay on the malloc heap.
+    void ARENA_PUSH(void) {}
+    void ARENA_POP(void) {}
 }
 #endif
 
 extern "C" {
 
+// Discards a list's positional index, if it has one.
+static void dropListIndex(ListHeader* header) {
+    free(header->index);
+    header->index = NULL;
+}
+
 // Frees a BCPL list (linked list of ListAtom nodes)
 void bcpl_free_list(ListHeader* header) {
     if (!header) return;
+    dropListIndex(header);
+
+    // Release what the atoms point to, then splice the whole chain onto the
+    // freelist in list order. Pushing atoms one at a time would reverse them,
+    // and the next list built from them would no longer be contiguous.
+    // Strings stored in the list's own string block go with the block.
+    const char* strings_begin = (const char*)header->strings;
+    const char* strings_end = strings_begin;
+    if (strings_begin) {
+        strings_end += (((const uint64_t*)strings_begin)[-1] & BCPL_STRING_LENGTH_MASK) * sizeof(uint32_t);
+    }
 
-    ListAtom* head = header->head;
-    while (head) {
-        ListAtom* next = head->next;
+    ListAtom* last = NULL;
+    for (ListAtom* atom = header->head; atom; atom = atom->next) {
         // If the atom holds a pointer to heap memory, free it
-        if (head->type == ATOM_STRING || head->type == ATOM_LIST_POINTER) {
-            if (head->value.ptr_value) {
-                bcpl_free(head->value.ptr_value);
+        if (atom->type == ATOM_STRING || atom->type == ATOM_LIST_POINTER) {
+            const char* p = (const char*)atom->value.ptr_value;
+            // An atom pointing into the string block holds a record's base
+            // pointer (SPLIT, MAP_KEYS), not an allocation of its own; the
+            // block is freed once below.
+            if (p && !(p >= strings_begin && p < strings_end)) {
+                bcpl_free(atom->value.ptr_value);
             }
         }
-        returnNodeToFreelist(head);
-        head = next;
+        noteNodeFreed(atom);
+        last = atom;
+    }
+    if (last) {
+        last->next = g_free_list_head;
+        g_free_list_head = header->head;
+        maybeReleaseEmptyChunks();
+    }
+
+    if (header->strings) {
+        bcpl_free(header->strings);
+        header->strings = NULL;
     }
 
     // Return the header to the freelist instead of calling free()
@@ -264,19 +480,65 @@ extern "C" void* BCPL_LIST_GET_REST(void* header_ptr) {
     return header->head ? (void*)header->head->next : NULL;
 }
 
-// Returns a pointer to the NTH list node (0-based), or NULL if out of bounds
+// Extends the header's index until it holds checkpoint 'wanted'. Returns
+// that checkpoint, or NULL if the list is too short or memory runs out.
+static ListAtom* listIndexCheckpoint(ListHeader* header, int64_t wanted) {
+    ListIndex* index = header->index;
+    if (index && index->head != header->head) {
+        index->count = 0; // The head was replaced; rebuild from scratch.
+        index->head = header->head;
+    }
+    if (!index || index->capacity <= wanted) {
+        int64_t capacity = index ? index->capacity * 2 : 16;
+        int64_t expected = header->length / LIST_INDEX_STRIDE + 1;
+        if (capacity < expected) capacity = expected;
+        if (capacity <= wanted) capacity = wanted + 1;
+        size_t bytes = sizeof(ListIndex) + (size_t)(capacity - 1) * sizeof(ListAtom*);
+        ListIndex* grown = (ListIndex*)realloc(index, bytes);
+        if (!grown) return NULL;
+        if (!index) {
+            grown->head = header->head;
+            grown->count = 0;
+        }
+        grown->capacity = capacity;
+        header->index = index = grown;
+    }
+
+    if (index->count == 0) {
+        if (!header->head) return NULL;
+        index->checkpoints[0] = header->head;
+        index->count = 1;
+    }
+    while (index->count <= wanted) {
+        ListAtom* current = index->checkpoints[index->count - 1];
+        for (int i = 0; i < LIST_INDEX_STRIDE && current; ++i) {
+            current = current->next;
+        }
+        if (!current) return NULL;
+        index->checkpoints[index->count++] = current;
+    }
+    return index->checkpoints[wanted];
+}
+
+// Returns a pointer to the NTH list node (0-based), or NULL if out of bounds.
+// Positions past the first stride in a runtime list go through the list's
+// checkpoint index, so an indexed loop over a list costs O(1) per element
+// instead of O(n). Read-only literals have no index and are walked.
 extern "C" void* BCPL_LIST_GET_NTH(void* header_ptr, int64_t n) {
     ListHeader* header = (ListHeader*)header_ptr;
     if (!header || header->type != ATOM_SENTINEL || n < 0) {
         return NULL;
     }
     ListAtom* current = header->head;
-    int64_t idx = 0;
-    while (current && idx < n) {
+    if (n >= LIST_INDEX_STRIDE && (header->flags & LIST_FLAG_RUNTIME)) {
+        current = listIndexCheckpoint(header, n / LIST_INDEX_STRIDE);
+        n %= LIST_INDEX_STRIDE;
+    }
+    while (current && n > 0) {
         current = current->next;
-        ++idx;
+        --n;
     }
-    return (idx == n && current) ? (void*)current : NULL;
+    return current;
 }
 
 // C-compatible function for runtime bridge: returns the next node after the head
@@ -295,10 +557,14 @@ extern "C" void* BCPL_LIST_GET_TAIL(void* header_ptr) {
 ListHeader* BCPL_LIST_CREATE_EMPTY(void) {
     ListHeader* header = getHeaderFromFreelist(); // Use the freelist
     header->type = ATOM_SENTINEL;
-    header->pad = 0;
+    header->flags = LIST_FLAG_RUNTIME;
     header->length = 0;
     header->head = NULL;
     header->tail = NULL;
+    header->index = NULL;
+    header->runs = 0;
+    header->strings = NULL;
+    header->run_head = NULL;
     return header;
 }
 
@@ -311,13 +577,7 @@ void BCPL_LIST_APPEND_LIST_TYPED(ListHeader* header, ListHeader* list_to_append)
     new_node->value.ptr_value = list_to_append;
     new_node->next = NULL;
 
-    if (header->head == NULL) {
-        header->head = new_node;
-        header->tail = new_node;
-    } else {
-        header->tail->next = new_node;
-        header->tail = new_node;
-    }
+    linkNodeAtTail(header, new_node);
     header->length++;
 }
 
@@ -336,13 +596,7 @@ void BCPL_LIST_APPEND_INT(ListHeader* header, int64_t value) {
     new_node->value.int_value = value;
     new_node->next = NULL;
 
-    if (header->head == NULL) {
-        header->head = new_node;
-        header->tail = new_node;
-    } else {
-        header->tail->next = new_node;
-        header->tail = new_node;
-    }
+    linkNodeAtTail(header, new_node);
     header->length++;
 }
 
@@ -356,13 +610,7 @@ void BCPL_LIST_APPEND_FLOAT(ListHeader* header, double value) {
     new_node->value.float_value = value;
     new_node->next = NULL;
 
-    if (header->head == NULL) {
-        header->head = new_node;
-        header->tail = new_node;
-    } else {
-        header->tail->next = new_node;
-        header->tail = new_node;
-    }
+    linkNodeAtTail(header, new_node);
     header->length++;
 }
 
@@ -376,13 +624,7 @@ void BCPL_LIST_APPEND_STRING(ListHeader* header, uint32_t* value) {
     new_node->value.ptr_value = value;
     new_node->next = NULL;
 
-    if (header->head == NULL) {
-        header->head = new_node;
-        header->tail = new_node;
-    } else {
-        header->tail->next = new_node;
-        header->tail = new_node;
-    }
+    linkNodeAtTail(header, new_node);
     header->length++;
 }
 
@@ -416,10 +658,14 @@ ListHeader* BCPL_DEEP_COPY_LITERAL_LIST(ListLiteralHeader* literal_header) {
 
     ListHeader* new_header = (ListHeader*)malloc(sizeof(ListHeader));
     new_header->type = ATOM_SENTINEL;
-    new_header->pad = 0;
-    new_header->length = literal_header->length;
+    new_header->flags = LIST_FLAG_RUNTIME;
+    new_header->length = 0;
     new_header->head = NULL;
     new_header->tail = NULL;
+    new_header->index = NULL;
+    new_header->runs = 0;
+    new_header->strings = NULL;
+    new_header->run_head = NULL;
 
     ListAtom* current_original = literal_header->head;
 
@@ -445,13 +691,8 @@ ListHeader* BCPL_DEEP_COPY_LITERAL_LIST(ListLiteralHeader* literal_header) {
         }
 
         // Append the new node using the head/tail pointers.
-        if (new_header->head == NULL) {
-            new_header->head = new_node;
-            new_header->tail = new_node;
-        } else {
-            new_header->tail->next = new_node;
-            new_header->tail = new_node;
-        }
+        linkNodeAtTail(new_header, new_node);
+        new_header->length++;
 
         current_original = current_original->next;
     }
@@ -494,13 +735,7 @@ extern "C" ListHeader* BCPL_LIST_FILTER(ListHeader* original_header, PredicateFu
             new_node->next = NULL;
 
             // Append the new node to our new list (O(1) operation).
-            if (new_header->head == NULL) {
-                new_header->head = new_node;
-                new_header->tail = new_node;
-            } else {
-                new_header->tail->next = new_node;
-                new_header->tail = new_node;
-            }
+            linkNodeAtTail(new_header, new_node);
             new_header->length++;
         }
         current_original = current_original->next;
@@ -513,22 +748,134 @@ extern "C" ListHeader* BCPL_LIST_FILTER(ListHeader* original_header, PredicateFu
 // (Already defined above with correct logic)
 
     // Fast freelist return for use by code generator (TL)
-    void returnNodeToFreelist_runtime(ListAtom* node) {
+    // Called by the inline destructive TL after it unlinks the head node.
+    // The header's index was built from the old head and is discarded, and
+    // if the node started a run, the rest of the run now starts at node + 1.
+    void returnNodeToFreelist_runtime(ListAtom* node, ListHeader* header) {
+        if (header) {
+            dropListIndex(header);
+            if (node->pad > 0) {
+                (node + 1)->pad = node->pad - 1;
+            }
+            if (header->run_head == node) {
+                header->run_head = node->pad > 0 ? node + 1 : NULL;
+            }
+        }
         returnNodeToFreelist(node);
     }
 } // extern "C"
 
-// Free all nodes in the global free list
+// Returns every list chunk whose atoms are all on the freelist to the OS.
 extern "C" void BCPL_FREE_CELLS(void) {
-    ListAtom* current = g_free_list_head;
-    while (current) {
-        ListAtom* next = current->next;
-        free(current);
-        current = next;
+    releaseEmptyChunks(0);
+}
+
+// Counts the address-adjacent atoms at the head of the freelist, up to 'limit'.
+static size_t freelistRunLength(size_t limit) {
+    size_t run = 0;
+    for (ListAtom* atom = g_free_list_head; atom && run < limit; atom = atom->next) {
+        run++;
+        if (atom->next != atom + 1) break;
     }
-    g_free_list_head = NULL;
-    g_freelist_node_count = 0;
-    g_total_nodes_allocated_from_heap = 0;
+    return run;
+}
+
+/**
+ * @brief Rebuilds a list's atoms densely, in list order.
+ * A list that is already one run keeps its atoms and only has its run
+ * length and LIST_FLAG_CONTIGUOUS recomputed. Otherwise the atoms are
+ * copied into the run at the head of the freelist when it is long enough,
+ * and into fresh chunks when it is not. The old atoms go back to the
+ * freelist and any chunks left fully free are released. The header is
+ * reused, so references to the list stay valid; pointers to its individual
+ * atoms do not.
+ */
+extern "C" ListHeader* COMPACTLIST(ListHeader* header) {
+    if (!header || header->type != ATOM_SENTINEL || !header->head) return header;
+
+    size_t count = 0;
+    bool dense = true;
+    for (ListAtom* atom = header->head; atom; atom = atom->next) {
+        if (atom->next && atom->next != atom + 1) dense = false;
+        count++;
+    }
+
+    ListAtom* old_head = header->head;
+    header->head = NULL;
+    header->tail = NULL;
+    header->runs = 0;
+    header->run_head = NULL;
+    header->flags &= ~LIST_FLAG_CONTIGUOUS;
+    header->length = 0;
+
+    if (dense) {
+        ListAtom* atom = old_head;
+        while (atom) {
+            ListAtom* next = atom->next;
+            atom->next = NULL;
+            linkNodeAtTail(header, atom);
+            header->length++;
+            atom = next;
+        }
+        return header;
+    }
+
+    dropListIndex(header);
+    bool from_freelist = freelistRunLength(count) == count;
+    ListChunk* chunk = NULL;
+    size_t used = LIST_CHUNK_NODES;
+    for (ListAtom* atom = old_head; atom; atom = atom->next) {
+        ListAtom* node;
+        if (from_freelist) {
+            node = getNodeFromFreelist();
+        } else {
+            if (used == LIST_CHUNK_NODES) {
+                chunk = allocateChunk();
+                used = 0;
+            }
+            node = &chunkNodes(chunk)[used++];
+        }
+        node->type = atom->type;
+        node->pad = 0;
+        node->value = atom->value;
+        node->next = NULL;
+        linkNodeAtTail(header, node);
+        header->length++;
+    }
+    // The rest of the last chunk feeds the next appends, still in order.
+    if (chunk && used < LIST_CHUNK_NODES) {
+        pushChunkNodes(chunk, used);
+    }
+
+    // The values now belong to the new atoms; recycle the old ones as-is.
+    ListAtom* last = old_head;
+    noteNodeFreed(last);
+    while (last->next) {
+        last = last->next;
+        noteNodeFreed(last);
+    }
+    last->next = g_free_list_head;
+    g_free_list_head = old_head;
+    maybeReleaseEmptyChunks();
+    return header;
+}
+
+// Reports list freelist occupancy for print_runtime_metrics.
+extern "C" void bcpl_list_freelist_stats(size_t* chunks, size_t* total_nodes, size_t* free_nodes,
+                                         size_t* empty_chunks, size_t* chunks_released) {
+    *chunks = g_list_chunk_count;
+    *total_nodes = g_total_nodes_allocated_from_heap;
+    *free_nodes = g_freelist_node_count;
+    *empty_chunks = g_empty_chunk_count;
+    *chunks_released = g_list_chunks_released;
+}
+
+extern "C" void bcpl_print_list_metrics(void) {
+    size_t chunks, total_nodes, free_nodes, empty_chunks, chunks_released;
+    bcpl_list_freelist_stats(&chunks, &total_nodes, &free_nodes, &empty_chunks, &chunks_released);
+    printf("List chunks: %zu (%zu fully free, %zu released)\n", chunks, empty_chunks, chunks_released);
+    printf("List freelist occupancy: %zu of %zu atoms free (%.1f%%)\n", free_nodes, total_nodes,
+           total_nodes ? 100.0 * (double)free_nodes / (double)total_nodes : 0.0);
 }
 
 // Expose the address of the global free list pointer
@@ -553,6 +900,7 @@ extern "C" ListHeader* BCPL_REVERSE_LIST(ListHeader* original_header) {
 
         // Shallow copy the data from the original node
         new_node->type = current_original->type;
+        new_node->pad = 0;
         new_node->value = current_original->value;
 
         // --- Prepend to the new list ---
@@ -634,13 +982,7 @@ ListHeader* BCPL_SHALLOW_COPY_LIST(ListHeader* original_header) {
         new_node->next = NULL;
 
         // Append the new node to our new list (this is an O(1) operation)
-        if (new_header->head == NULL) {
-            new_header->head = new_node;
-            new_header->tail = new_node;
-        } else {
-            new_header->tail->next = new_node;
-            new_header->tail = new_node;
-        }
+        linkNodeAtTail(new_header, new_node);
         new_header->length++;
 
         current_original = current_original->next;
@@ -675,13 +1017,7 @@ extern "C" ListHeader* BCPL_CONCAT_LISTS(ListHeader* list1_header, ListHeader* l
             new_node->next = NULL;
 
             // Append the new node to our new list (O(1) operation)
-            if (new_header->head == NULL) {
-                new_header->head = new_node;
-                new_header->tail = new_node;
-            } else {
-                new_header->tail->next = new_node;
-                new_header->tail = new_node;
-            }
+            linkNodeAtTail(new_header, new_node);
             new_header->length++;
             
             current_original = current_original->next;
@@ -740,13 +1076,7 @@ ListHeader* BCPL_DEEP_COPY_LIST(ListHeader* original_header) {
         }
 
         // Append the new node to our new list (O(1) operation)
-        if (new_header->head == NULL) {
-            new_header->head = new_node;
-            new_header->tail = new_node;
-        } else {
-            new_header->tail->next = new_node;
-            new_header->tail = new_node;
-        }
+        linkNodeAtTail(new_header, new_node);
         new_header->length++;
 
         current_original = current_original->next;
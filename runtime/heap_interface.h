@@ -2,6 +2,7 @@
 #define HEAP_INTERFACE_H
 
 #include <stdint.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -22,6 +23,7 @@ ListHeader* BCPL_REVERSE_LIST(ListHeader* original_header);
 ListAtom*   BCPL_FIND_IN_LIST(ListHeader* header, int64_t value_bits, int64_t type_tag);
 ListHeader* BCPL_SHALLOW_COPY_LIST(ListHeader* original_header);
 ListHeader* BCPL_DEEP_COPY_LIST(ListHeader* original_header);
+ListHeader* COMPACTLIST(ListHeader* header);
 ListAtom*   bcpl_list_get_rest(ListHeader* header);
 int64_t     list_get_head_as_int(ListHeader* header);
 
@@ -41,6 +43,12 @@ ListHeader* BCPL_LIST_CREATE_EMPTY(void);
  */
 void BCPL_LIST_APPEND_STRING(ListHeader* header, uint32_t* value);
 
+/**
+ * Code points taken by a UTF-32 string of `length` characters laid out as a
+ * [length][characters][0] record in a list's string block (see SPLIT).
+ */
+size_t bcpl_string_record_chars(size_t length);
+
 // Internal (typed) versions for use within the runtime:
 double   list_get_head_as_float(ListHeader* header);
 int64_t  list_get_atom_type(ListHeader* header);
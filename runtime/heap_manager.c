@@ -34,7 +34,7 @@ void* BCPL_ALLOC_CHARS(int64_t num_chars) {
     size_t total_size = sizeof(uint64_t) + ((num_chars + 1) * sizeof(uint32_t)); // +1 for null terminator
     uint64_t* block = (uint64_t*)malloc(total_size);
     if (!block) return NULL;
-    block[0] = num_chars;
+    block[0] = (uint64_t)num_chars | BCPL_STRING_TRUSTED;
     uint32_t* payload = (uint32_t*)(block + 1);
     payload[num_chars] = 0; // Null terminate
     return (void*)payload;
@@ -50,7 +50,7 @@ void* bcpl_alloc_chars(int64_t num_chars) {
     }
     
     // Store the size in the header
-    str[0] = num_chars;
+    str[0] = (uint64_t)num_chars | BCPL_STRING_TRUSTED;
     
     // Get a pointer to the data section
     uint32_t* payload = (uint32_t*)(str + 1);
@@ -65,6 +65,41 @@ void* bcpl_alloc_chars(int64_t num_chars) {
     return (void*)payload;
 }
 
+void* bcpl_alloc_compact_chars(int64_t num_chars) {
+    if (num_chars < 0) return NULL;
+
+    // Compact strings are [size | BCPL_STRING_COMPACT][bytes...][0]
+    uint64_t* str = (uint64_t*)malloc(sizeof(uint64_t) + num_chars + 1);
+    if (!str) {
+        fprintf(stderr, "ERROR: Failed to allocate compact string with %lld chars\n",
+                (long long)num_chars);
+        return NULL;
+    }
+
+    str[0] = (uint64_t)num_chars | BCPL_STRING_COMPACT;
+    uint8_t* payload = (uint8_t*)(str + 1);
+    memset(payload, 0, num_chars + 1);
+    return (void*)payload;
+}
+
+void* bcpl_resize_chars(void* payload, int64_t num_chars) {
+    if (num_chars < 0) return NULL;
+    if (!payload) return bcpl_alloc_chars(num_chars);
+
+    size_t total_size = sizeof(uint64_t) + (num_chars + 1) * sizeof(uint32_t);
+    uint64_t* str = (uint64_t*)realloc((uint64_t*)payload - 1, total_size);
+    if (!str) {
+        fprintf(stderr, "ERROR: Failed to resize string to %lld chars\n",
+                (long long)num_chars);
+        return NULL;
+    }
+
+    str[0] = (uint64_t)num_chars | BCPL_STRING_TRUSTED;
+    uint32_t* resized = (uint32_t*)(str + 1);
+    resized[num_chars] = 0;
+    return (void*)resized;
+}
+
 void bcpl_free(void* ptr) {
     if (!ptr) return;
     
@@ -74,6 +109,10 @@ void bcpl_free(void* ptr) {
     free(actual_block);
 }
 
+// Regions need the HeapManager; the standalone allocator keeps using malloc.
+void ARENA_PUSH(void) {}
+void ARENA_POP(void) {}
+
 // Include the shared implementations
 #include "runtime_core.inc"
 #include "runtime_string_utils.inc"
@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -58,6 +59,25 @@ void* bcpl_alloc_words(int64_t num_words, const char* func, const char* var);
  */
 void* bcpl_alloc_chars(int64_t num_chars);
 
+/**
+ * Resizes a character string buffer from bcpl_alloc_chars, keeping its
+ * contents. The length prefix becomes num_chars and the buffer may move.
+ *
+ * @param payload   String to resize, or NULL to allocate a new one
+ * @param num_chars New number of characters (excluding null terminator)
+ * @return          Pointer to the resized string, or NULL on failure
+ */
+void* bcpl_resize_chars(void* payload, int64_t num_chars);
+
+/**
+ * Allocates a compact (Latin-1) string buffer: one byte per character,
+ * with BCPL_STRING_COMPACT set in the length prefix. Free with bcpl_free.
+ *
+ * @param num_chars Number of characters (excluding null terminator)
+ * @return          Pointer to the allocated string, or NULL on failure
+ */
+void* bcpl_alloc_compact_chars(int64_t num_chars);
+
 /**
  * Frees memory allocated by bcpl_alloc_words or bcpl_alloc_chars.
  *
@@ -65,6 +85,19 @@ void* bcpl_alloc_chars(int64_t num_chars);
  */
 void bcpl_free(void* ptr);
 
+/**
+ * Opens an allocation region. Until the matching ARENA_POP, vectors and
+ * strings are bump-allocated from the region instead of the heap.
+ * Regions nest; FREEVEC on a region block is ignored.
+ */
+void ARENA_PUSH(void);
+
+/**
+ * Closes the innermost allocation region, releasing every vector and
+ * string allocated in it at once.
+ */
+void ARENA_POP(void);
+
 //=============================================================================
 // Core I/O and System
 //=============================================================================
@@ -97,6 +130,28 @@ void WRITEN(int64_t n);
  */
 void WRITEC(int64_t ch);
 
+/**
+ * Writes any buffered WRITES/WRITEN/WRITEF/WRITEC output to stdout.
+ * Called automatically before RDCH, on FINISH and at exit.
+ */
+void bcpl_flush_output(void);
+
+/**
+ * Enables or disables runtime diagnostics on stderr (--trace-runtime).
+ *
+ * @param enabled Non-zero to enable tracing
+ */
+void bcpl_set_runtime_trace(int enabled);
+
+/**
+ * Enables or disables compact string storage (--compact-strings). While
+ * enabled, SLURP and READLINE return compact strings for text whose code
+ * points all fit in one byte.
+ *
+ * @param enabled Non-zero to enable compact strings
+ */
+void bcpl_set_compact_strings(int enabled);
+
 /**
  * Reads a single character from standard input.
  *
@@ -109,6 +164,46 @@ int64_t RDCH(void);
  */
 void finish(void);
 
+//=============================================================================
+// Compact strings
+//=============================================================================
+
+/**
+ * Marks a UTF-32 length word the runtime or the compiler wrote. It sits in
+ * the upper half of the word, above the length. Only a tagged length (or a
+ * compact one) is trusted by the string functions; any other word in front
+ * of a string, such as an element before a pointer into a vector, may hold
+ * anything, and those strings are measured by scanning for the terminator.
+ */
+#define BCPL_STRING_TRUSTED ((uint64_t)0x42535452 << 32)
+
+/**
+ * A string is normally UTF-32: [length][32-bit characters][0]. A compact
+ * string carries BCPL_STRING_COMPACT in the upper half of its length word
+ * (the trusted tag with bit 63 set) and stores one Latin-1 byte per
+ * character followed by a zero byte. Compact strings are only created with
+ * --compact-strings, or from other compact strings (SPLIT, JOIN). The
+ * string functions accept either form; results that may need wider
+ * characters are UTF-32. A compact string cannot hold a character above
+ * 0xFF: storing one is an error.
+ */
+#define BCPL_STRING_COMPACT (BCPL_STRING_TRUSTED | ((uint64_t)1 << 63))
+
+/** The length in a string's length word, without its tag or flag. */
+#define BCPL_STRING_LENGTH_MASK ((uint64_t)0xFFFFFFFF)
+
+/**
+ * Tests whether a non-NULL string payload is compact: the upper half of its
+ * length word is exactly the compact tag. A negative number or any other
+ * value in front of a pointer into a vector is not mistaken for it. The
+ * word is read with memcpy, since such a pointer need not be 8-byte aligned.
+ */
+static inline int bcpl_string_is_compact(const void* s) {
+    uint64_t word;
+    memcpy(&word, (const char*)s - sizeof(word), sizeof(word));
+    return (word >> 32) == (BCPL_STRING_COMPACT >> 32);
+}
+
 //=============================================================================
 // String Utilities
 //=============================================================================
@@ -155,7 +250,8 @@ int64_t STRCMP(const uint32_t* s1, const uint32_t* s2);
  *
  * @param dst Pointer to the destination BCPL string
  * @param src Pointer to the source BCPL string
- * @return    Pointer to the destination string
+ * @return    Pointer to the destination string, or NULL if dst is compact
+ *            and src has a character above 0xFF (dst is left unchanged)
  * @note BCPL strings are represented as pointers to arrays of 32-bit Unicode code points (UTF-32).
  */
 uint32_t* STRCOPY(uint32_t* dst, const uint32_t* src);
@@ -180,12 +276,188 @@ uint32_t* SLURP(uint32_t* filename_str);
  */
 void SPIT(uint32_t* bcpl_string, uint32_t* filename_str);
 
+/**
+ * Opens a file for streaming, line-by-line reading.
+ *
+ * @param filename_str Pointer to a BCPL string containing the filename
+ * @return             Reader handle, or 0 if the file cannot be opened
+ */
+int64_t FOPEN(uint32_t* filename_str);
+
+/**
+ * Reads the next line from a reader, without its line terminator.
+ *
+ * @param handle Reader handle from FOPEN
+ * @param buffer 0 to allocate a new string, or a string to reuse
+ * @return       The line (possibly a new string if 'buffer' was too small), or NULL at end of file
+ */
+uint32_t* READLINE(int64_t handle, uint32_t* buffer);
+
+/**
+ * Closes a reader opened by FOPEN.
+ *
+ * @param handle Reader handle from FOPEN
+ */
+void FCLOSE(int64_t handle);
+
+//=============================================================================
+// Hash maps
+//=============================================================================
+
+/**
+ * Open-addressing hash map from int, float or string keys to 64-bit values.
+ * A key is passed as its value bits plus its atom type (ATOM_INT, ATOM_FLOAT
+ * or ATOM_STRING); for strings the bits are the payload pointer. The code
+ * generator supplies the type from the key expression's static type.
+ */
+typedef struct BCPLMap BCPLMap;
+
+/**
+ * Creates an empty map.
+ *
+ * @return Pointer to the new map, or NULL on failure
+ */
+BCPLMap* BCPL_MAP_NEW(void);
+
+/**
+ * Frees a map and its copies of string keys.
+ *
+ * @param map Map from BCPL_MAP_NEW
+ */
+void BCPL_MAP_FREE(BCPLMap* map);
+
+/**
+ * Inserts a key or replaces its value. String keys are copied.
+ *
+ * @param map      Map from BCPL_MAP_NEW
+ * @param key_bits Integer key, float key bits or string payload pointer
+ * @param key_type ATOM_INT, ATOM_FLOAT or ATOM_STRING
+ * @param value    Value to store (float values as their bits)
+ */
+void BCPL_MAP_PUT(BCPLMap* map, int64_t key_bits, int64_t key_type, int64_t value);
+
+/**
+ * Looks up a key.
+ *
+ * @return The stored value, or 0 if the key is absent
+ */
+int64_t BCPL_MAP_GET(BCPLMap* map, int64_t key_bits, int64_t key_type);
+
+/**
+ * Looks up a key whose value was stored from a float.
+ *
+ * @return The stored value, or 0.0 if the key is absent
+ */
+double BCPL_MAP_GET_FLOAT(BCPLMap* map, int64_t key_bits, int64_t key_type);
+
+/**
+ * Tests whether a key is present.
+ *
+ * @return 1 if present, 0 otherwise
+ */
+int64_t BCPL_MAP_HAS(BCPLMap* map, int64_t key_bits, int64_t key_type);
+
+/**
+ * Removes a key.
+ *
+ * @return 1 if the key was present, 0 otherwise
+ */
+int64_t BCPL_MAP_DEL(BCPLMap* map, int64_t key_bits, int64_t key_type);
+
+/**
+ * Returns the number of keys in a map.
+ */
+int64_t BCPL_MAP_SIZE(BCPLMap* map);
+
+/**
+ * Returns a new list of the map's keys, in no particular order, for
+ * iterating with FOREACH. String keys are fresh strings.
+ */
+struct ListHeader* BCPL_MAP_KEYS(BCPLMap* map);
+
+//=============================================================================
+// String builders
+//=============================================================================
+
+/**
+ * Accumulates a string in a buffer that grows geometrically, so building a
+ * string from n pieces costs O(n) rather than O(n^2) with repeated
+ * concatenation. The buffer is a string from bcpl_alloc_chars, which
+ * BCPL_SB_TOSTRING hands over without copying.
+ */
+typedef struct BCPLStringBuilder BCPLStringBuilder;
+
+/**
+ * Creates an empty string builder.
+ *
+ * @return Pointer to the new builder, or NULL on failure
+ */
+BCPLStringBuilder* BCPL_SB_NEW(void);
+
+/**
+ * Frees a builder and its buffer without producing a string.
+ *
+ * @param sb Builder from BCPL_SB_NEW
+ */
+void BCPL_SB_FREE(BCPLStringBuilder* sb);
+
+/**
+ * Appends a string.
+ *
+ * @param sb  Builder from BCPL_SB_NEW
+ * @param str String payload to append
+ */
+void BCPL_SB_APPEND(BCPLStringBuilder* sb, uint32_t* str);
+
+/**
+ * Appends one character.
+ *
+ * @param sb Builder from BCPL_SB_NEW
+ * @param ch Unicode code point to append
+ */
+void BCPL_SB_APPEND_CHAR(BCPLStringBuilder* sb, int64_t ch);
+
+/**
+ * Appends an integer in decimal.
+ *
+ * @param sb Builder from BCPL_SB_NEW
+ * @param n  Integer to append
+ */
+void BCPL_SB_APPEND_INT(BCPLStringBuilder* sb, int64_t n);
+
+/**
+ * Returns the number of characters appended so far.
+ */
+int64_t BCPL_SB_LENGTH(BCPLStringBuilder* sb);
+
+/**
+ * Finishes a builder. Returns its buffer as a string and frees the builder,
+ * which must not be used again. Free the string with bcpl_free.
+ *
+ * @param sb Builder from BCPL_SB_NEW
+ * @return   Pointer to the string payload
+ */
+uint32_t* BCPL_SB_TOSTRING(BCPLStringBuilder* sb);
+
 /**
  * Prints runtime memory allocation metrics.
  * Shows counts of allocations, frees, and memory usage.
  */
 void print_runtime_metrics(void);
 
+/**
+ * Reports list atom freelist occupancy: chunks allocated, atoms they hold,
+ * atoms currently free, fully free chunks, and chunks released to the OS.
+ */
+void bcpl_list_freelist_stats(size_t* chunks, size_t* total_nodes, size_t* free_nodes,
+                              size_t* empty_chunks, size_t* chunks_released);
+
+/**
+ * Prints the list freelist lines of print_runtime_metrics. The JIT registers
+ * it with register_runtime_metrics_reporter at startup.
+ */
+void bcpl_print_list_metrics(void);
+
 #ifdef __cplusplus
 }
 #endif
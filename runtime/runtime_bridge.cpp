@@ -8,6 +8,7 @@
 #include <iostream>
 #include <string>
 #include <cstring>
+#include <cstdarg>
 
 // In JIT mode, we don't include the heap allocation functions from runtime.c
 // as they are provided by heap_c_bridge.cpp. However, we do include all the
@@ -51,10 +52,11 @@ std::string bcpl_string_to_cpp(const uint32_t* bcpl_string) {
     if (!bcpl_string) return "";
     
     std::string result;
+    int compact = bcpl_string_is_compact(bcpl_string);
     
     // Convert each character to UTF-8
-    for (size_t i = 0; bcpl_string[i] != 0; i++) {
-        uint32_t ch = bcpl_string[i];
+    for (size_t i = 0; any_string_char(bcpl_string, compact, i) != 0; i++) {
+        uint32_t ch = any_string_char(bcpl_string, compact, i);
         
         if (ch < 0x80) {
             // ASCII
@@ -89,11 +91,26 @@ void log_error(const char* file, int line, const char* message) {
 
 // Write formatted text to stdout (C++ version of WRITEF)
 void write_formatted(const char* format, ...) {
-    va_list args;
+    char text[1024];
+    va_list args, retry;
     va_start(args, format);
-    vprintf(format, args);
+    va_copy(retry, args);
+    int len = vsnprintf(text, sizeof(text), format, args);
     va_end(args);
-    fflush(stdout);
+    if (len <= 0) {
+        va_end(retry);
+        return;
+    }
+    // Route through the runtime output buffer so ordering with WRITES holds
+    if (static_cast<size_t>(len) < sizeof(text)) {
+        output_bytes(text, static_cast<size_t>(len));
+    } else {
+        // Too long for the stack buffer: format again into one that fits.
+        std::string long_text(static_cast<size_t>(len) + 1, '\0');
+        vsnprintf(&long_text[0], long_text.size(), format, retry);
+        output_bytes(long_text.data(), static_cast<size_t>(len));
+    }
+    va_end(retry);
 }
 
 } // namespace runtime
@@ -0,0 +1,299 @@
+#include "runtime.h"
+#include "ListDataTypes.h"
+#include "heap_interface.h"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+extern "C" {
+    void BCPL_LIST_APPEND_INT(ListHeader* header, int64_t value);
+    void BCPL_LIST_APPEND_FLOAT(ListHeader* header, double value);
+}
+
+// Open-addressing hash map behind MAP_NEW/MAP_PUT/MAP_GET/MAP_DEL.
+//
+// Slots are probed linearly from the key's hash. Deletion shifts the
+// following entries of the cluster back, so there are no tombstones and a
+// lookup stops at the first empty slot. The table doubles once it is three
+// quarters full.
+//
+// A key is its 64-bit value plus its atom type (ATOM_INT, ATOM_FLOAT or
+// ATOM_STRING), so the integer 1 and the float 1.0 are different keys.
+// String keys are copied into the map as UTF-32 and hashed over their code
+// points, so a compact string and a UTF-32 string with the same text are
+// the same key.
+
+namespace {
+
+struct MapEntry {
+    uint64_t hash;
+    int64_t key_bits;      // Integer value or float bits; unused for strings.
+    uint32_t* key_string;  // Owned copy of a string key, NUL terminated.
+    size_t key_length;
+    int64_t value;
+    int32_t key_type;      // ATOM_SENTINEL marks an empty slot.
+};
+
+const size_t kInitialCapacity = 16;
+
+uint64_t mix64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+uint64_t hash_string(const uint32_t* s, size_t length) {
+    uint64_t h = 0xcbf29ce484222325ULL ^ length;
+    size_t i = 0;
+    // Two code points per step keep the multiply chain half as long.
+    for (; i + 2 <= length; i += 2) {
+        uint64_t pair = (uint64_t)s[i] | ((uint64_t)s[i + 1] << 32);
+        h = (h ^ pair) * 0x100000001b3ULL;
+    }
+    if (i < length) h = (h ^ s[i]) * 0x100000001b3ULL;
+    return mix64(h ^ ATOM_STRING);
+}
+
+// hash_string over the code points of a compact (Latin-1) string.
+uint64_t hash_compact_string(const uint8_t* s, size_t length) {
+    uint64_t h = 0xcbf29ce484222325ULL ^ length;
+    size_t i = 0;
+    for (; i + 2 <= length; i += 2) {
+        uint64_t pair = (uint64_t)s[i] | ((uint64_t)s[i + 1] << 32);
+        h = (h ^ pair) * 0x100000001b3ULL;
+    }
+    if (i < length) h = (h ^ s[i]) * 0x100000001b3ULL;
+    return mix64(h ^ ATOM_STRING);
+}
+
+// Floats compare by value, so -0.0 and 0.0 are one key.
+int64_t normalize_key(int64_t key_bits, int64_t key_type) {
+    if (key_type == ATOM_FLOAT && (uint64_t)key_bits == 0x8000000000000000ULL) return 0;
+    return key_bits;
+}
+
+} // namespace
+
+struct BCPLMap {
+    MapEntry* slots;
+    size_t capacity;  // Always a power of two.
+    size_t size;
+};
+
+namespace {
+
+struct KeyRef {
+    int64_t type;
+    int64_t bits;
+    const uint32_t* string;
+    size_t length;
+    uint64_t hash;
+    bool compact;  // string points at Latin-1 bytes.
+};
+
+KeyRef make_key(int64_t key_bits, int64_t key_type) {
+    KeyRef key = {key_type, 0, nullptr, 0, 0, false};
+    if (key_type == ATOM_STRING) {
+        static const uint32_t empty = 0;
+        key.string = reinterpret_cast<const uint32_t*>(key_bits);
+        key.length = key.string ? (size_t)STRLEN(key.string) : 0;
+        if (!key.string) key.string = &empty;
+        key.compact = key.string != &empty && bcpl_string_is_compact(key.string);
+        key.hash = key.compact ? hash_compact_string(reinterpret_cast<const uint8_t*>(key.string), key.length)
+                               : hash_string(key.string, key.length);
+    } else {
+        key.bits = normalize_key(key_bits, key_type);
+        key.hash = mix64((uint64_t)key.bits ^ ((uint64_t)key_type << 56));
+    }
+    return key;
+}
+
+bool entry_matches(const MapEntry& entry, const KeyRef& key) {
+    if (entry.hash != key.hash || entry.key_type != key.type) return false;
+    if (key.type != ATOM_STRING) return entry.key_bits == key.bits;
+    if (entry.key_length != key.length) return false;
+    if (!key.compact) return std::memcmp(entry.key_string, key.string, key.length * sizeof(uint32_t)) == 0;
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(key.string);
+    for (size_t i = 0; i < key.length; ++i) {
+        if (entry.key_string[i] != bytes[i]) return false;
+    }
+    return true;
+}
+
+// Returns the slot holding key, or the empty slot where it would go.
+size_t find_slot(const BCPLMap* map, const KeyRef& key) {
+    size_t mask = map->capacity - 1;
+    size_t i = key.hash & mask;
+    while (map->slots[i].key_type != ATOM_SENTINEL && !entry_matches(map->slots[i], key)) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+void grow(BCPLMap* map) {
+    MapEntry* old_slots = map->slots;
+    size_t old_capacity = map->capacity;
+
+    map->capacity = old_capacity * 2;
+    map->slots = static_cast<MapEntry*>(std::calloc(map->capacity, sizeof(MapEntry)));
+    if (!map->slots) std::abort();
+
+    size_t mask = map->capacity - 1;
+    for (size_t i = 0; i < old_capacity; ++i) {
+        if (old_slots[i].key_type == ATOM_SENTINEL) continue;
+        size_t j = old_slots[i].hash & mask;
+        while (map->slots[j].key_type != ATOM_SENTINEL) j = (j + 1) & mask;
+        map->slots[j] = old_slots[i];
+    }
+    std::free(old_slots);
+}
+
+} // namespace
+
+extern "C" BCPLMap* BCPL_MAP_NEW(void) {
+    BCPLMap* map = static_cast<BCPLMap*>(std::malloc(sizeof(BCPLMap)));
+    if (!map) return nullptr;
+    map->slots = static_cast<MapEntry*>(std::calloc(kInitialCapacity, sizeof(MapEntry)));
+    if (!map->slots) {
+        std::free(map);
+        return nullptr;
+    }
+    map->capacity = kInitialCapacity;
+    map->size = 0;
+    return map;
+}
+
+extern "C" void BCPL_MAP_FREE(BCPLMap* map) {
+    if (!map) return;
+    for (size_t i = 0; i < map->capacity; ++i) {
+        std::free(map->slots[i].key_string);
+    }
+    std::free(map->slots);
+    std::free(map);
+}
+
+extern "C" void BCPL_MAP_PUT(BCPLMap* map, int64_t key_bits, int64_t key_type, int64_t value) {
+    if (!map) return;
+    KeyRef key = make_key(key_bits, key_type);
+    size_t i = find_slot(map, key);
+    if (map->slots[i].key_type != ATOM_SENTINEL) {
+        map->slots[i].value = value;
+        return;
+    }
+
+    if ((map->size + 1) * 4 > map->capacity * 3) {
+        grow(map);
+        i = find_slot(map, key);
+    }
+
+    MapEntry& entry = map->slots[i];
+    entry.hash = key.hash;
+    entry.key_bits = key.bits;
+    entry.key_string = nullptr;
+    entry.key_length = key.length;
+    entry.value = value;
+    entry.key_type = (int32_t)key.type;
+    if (key.type == ATOM_STRING) {
+        entry.key_string = static_cast<uint32_t*>(std::malloc((key.length + 1) * sizeof(uint32_t)));
+        if (!entry.key_string) std::abort();
+        if (key.compact) {
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(key.string);
+            for (size_t i = 0; i < key.length; ++i) entry.key_string[i] = bytes[i];
+        } else {
+            std::memcpy(entry.key_string, key.string, key.length * sizeof(uint32_t));
+        }
+        entry.key_string[key.length] = 0;
+    }
+    map->size++;
+}
+
+extern "C" int64_t BCPL_MAP_GET(BCPLMap* map, int64_t key_bits, int64_t key_type) {
+    if (!map) return 0;
+    size_t i = find_slot(map, make_key(key_bits, key_type));
+    return map->slots[i].key_type != ATOM_SENTINEL ? map->slots[i].value : 0;
+}
+
+extern "C" double BCPL_MAP_GET_FLOAT(BCPLMap* map, int64_t key_bits, int64_t key_type) {
+    int64_t bits = BCPL_MAP_GET(map, key_bits, key_type);
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+extern "C" int64_t BCPL_MAP_HAS(BCPLMap* map, int64_t key_bits, int64_t key_type) {
+    if (!map) return 0;
+    size_t i = find_slot(map, make_key(key_bits, key_type));
+    return map->slots[i].key_type != ATOM_SENTINEL ? 1 : 0;
+}
+
+extern "C" int64_t BCPL_MAP_DEL(BCPLMap* map, int64_t key_bits, int64_t key_type) {
+    if (!map) return 0;
+    size_t i = find_slot(map, make_key(key_bits, key_type));
+    if (map->slots[i].key_type == ATOM_SENTINEL) return 0;
+
+    std::free(map->slots[i].key_string);
+    map->size--;
+
+    // Shift later members of the cluster back into the hole, unless that
+    // would move one in front of its home slot.
+    size_t mask = map->capacity - 1;
+    size_t hole = i;
+    size_t j = i;
+    while (true) {
+        j = (j + 1) & mask;
+        if (map->slots[j].key_type == ATOM_SENTINEL) break;
+        size_t home = map->slots[j].hash & mask;
+        if (((j - home) & mask) >= ((j - hole) & mask)) {
+            map->slots[hole] = map->slots[j];
+            hole = j;
+        }
+    }
+    std::memset(&map->slots[hole], 0, sizeof(MapEntry));
+    return 1;
+}
+
+extern "C" int64_t BCPL_MAP_SIZE(BCPLMap* map) {
+    return map ? (int64_t)map->size : 0;
+}
+
+extern "C" ListHeader* BCPL_MAP_KEYS(BCPLMap* map) {
+    ListHeader* keys = BCPL_LIST_CREATE_EMPTY();
+    if (!map) return keys;
+
+    // String keys are copied as records into one block owned by the list,
+    // as SPLIT lays out its tokens, so bcpl_free_list releases them with it.
+    size_t storage_chars = 0;
+    for (size_t i = 0; i < map->capacity; ++i) {
+        if (map->slots[i].key_type == ATOM_STRING) {
+            storage_chars += bcpl_string_record_chars(map->slots[i].key_length);
+        }
+    }
+    uint32_t* record = nullptr;
+    if (storage_chars > 0) {
+        record = static_cast<uint32_t*>(bcpl_alloc_chars((int64_t)storage_chars));
+        if (!record) return keys;
+        keys->strings = record;
+    }
+
+    for (size_t i = 0; i < map->capacity; ++i) {
+        const MapEntry& entry = map->slots[i];
+        if (entry.key_type == ATOM_INT) {
+            BCPL_LIST_APPEND_INT(keys, entry.key_bits);
+        } else if (entry.key_type == ATOM_FLOAT) {
+            double key;
+            std::memcpy(&key, &entry.key_bits, sizeof(key));
+            BCPL_LIST_APPEND_FLOAT(keys, key);
+        } else if (entry.key_type == ATOM_STRING) {
+            uint64_t prefix = entry.key_length | BCPL_STRING_TRUSTED;
+            std::memcpy(record, &prefix, sizeof(prefix));
+            std::memcpy(record + 2, entry.key_string, (entry.key_length + 1) * sizeof(uint32_t));
+            // String atoms hold the record's base pointer, as SPLIT's do.
+            BCPL_LIST_APPEND_STRING(keys, record);
+            record += bcpl_string_record_chars(entry.key_length);
+        }
+    }
+    return keys;
+}
@@ -0,0 +1,112 @@
+#include "runtime.h"
+#include "heap_interface.h"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+// String builder behind STRBUILDER/SB_APPEND/TOSTRING.
+//
+// The builder writes straight into a string buffer from bcpl_alloc_chars and
+// at least doubles it when it runs out of room, so appends are amortized
+// O(1). TOSTRING fixes up the length prefix and terminator and returns that
+// buffer as the finished string, so the text is never copied a final time.
+// Growth goes through bcpl_resize_chars, which the HeapManager counts in its
+// string metrics.
+
+struct BCPLStringBuilder {
+    uint32_t* buffer;  // Payload of a bcpl_alloc_chars string.
+    size_t length;     // Characters written so far.
+    size_t capacity;   // Characters the buffer can hold before the terminator.
+};
+
+namespace {
+
+const size_t kInitialCapacity = 16;
+
+// Makes room for extra more characters. Returns false if the buffer could
+// not grow, leaving the builder as it was.
+bool reserve(BCPLStringBuilder* sb, size_t extra) {
+    size_t needed = sb->length + extra;
+    if (needed <= sb->capacity) return true;
+
+    size_t capacity = sb->capacity * 2;
+    if (capacity < needed) capacity = needed;
+    uint32_t* buffer = static_cast<uint32_t*>(bcpl_resize_chars(sb->buffer, (int64_t)capacity));
+    if (!buffer) return false;
+    sb->buffer = buffer;
+    sb->capacity = capacity;
+    return true;
+}
+
+} // namespace
+
+extern "C" BCPLStringBuilder* BCPL_SB_NEW(void) {
+    BCPLStringBuilder* sb = static_cast<BCPLStringBuilder*>(std::malloc(sizeof(BCPLStringBuilder)));
+    if (!sb) return nullptr;
+    sb->buffer = static_cast<uint32_t*>(bcpl_alloc_chars((int64_t)kInitialCapacity));
+    if (!sb->buffer) {
+        std::free(sb);
+        return nullptr;
+    }
+    sb->length = 0;
+    sb->capacity = kInitialCapacity;
+    return sb;
+}
+
+extern "C" void BCPL_SB_FREE(BCPLStringBuilder* sb) {
+    if (!sb) return;
+    bcpl_free(sb->buffer);
+    std::free(sb);
+}
+
+extern "C" void BCPL_SB_APPEND(BCPLStringBuilder* sb, uint32_t* str) {
+    if (!sb || !str) return;
+    size_t n = (size_t)STRLEN(str);
+    if (!reserve(sb, n)) return;
+    if (bcpl_string_is_compact(str)) {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(str);
+        uint32_t* out = sb->buffer + sb->length;
+        for (size_t i = 0; i < n; ++i) out[i] = bytes[i];
+    } else {
+        std::memcpy(sb->buffer + sb->length, str, n * sizeof(uint32_t));
+    }
+    sb->length += n;
+}
+
+extern "C" void BCPL_SB_APPEND_CHAR(BCPLStringBuilder* sb, int64_t ch) {
+    if (!sb || !reserve(sb, 1)) return;
+    sb->buffer[sb->length++] = (uint32_t)ch;
+}
+
+extern "C" void BCPL_SB_APPEND_INT(BCPLStringBuilder* sb, int64_t n) {
+    if (!sb) return;
+    // Format right-to-left without going through printf, as WRITEN does.
+    uint32_t digits[20];
+    uint32_t* end = digits + 20;
+    uint32_t* p = end;
+    uint64_t magnitude = n < 0 ? (uint64_t)0 - (uint64_t)n : (uint64_t)n;
+    do {
+        *--p = (uint32_t)('0' + (magnitude % 10));
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    size_t count = (size_t)(end - p);
+    if (!reserve(sb, count + (n < 0 ? 1 : 0))) return;
+    if (n < 0) sb->buffer[sb->length++] = '-';
+    std::memcpy(sb->buffer + sb->length, p, count * sizeof(uint32_t));
+    sb->length += count;
+}
+
+extern "C" int64_t BCPL_SB_LENGTH(BCPLStringBuilder* sb) {
+    return sb ? (int64_t)sb->length : 0;
+}
+
+extern "C" uint32_t* BCPL_SB_TOSTRING(BCPLStringBuilder* sb) {
+    if (!sb) return nullptr;
+    uint32_t* str = sb->buffer;
+    // The spare capacity stays with the block and is released with it.
+    reinterpret_cast<uint64_t*>(str)[-1] = sb->length | BCPL_STRING_TRUSTED;
+    str[sb->length] = 0;
+    std::free(sb);
+    return str;
+}
@@ -2,85 +2,185 @@
 #include "ListDataTypes.h"
 #include "heap_interface.h"
 #include <string>
-#include <vector>
 #include <cstring>
 #include <cstdint>
 
-// Helper to convert a BCPL string payload to a std::string
-static std::string bcpl_to_std_string(const uint32_t* payload) {
-    if (!payload) return "";
-    std::string result;
-    for (size_t i = 0; payload[i] != 0; ++i) {
-        result += static_cast<char>(payload[i]); // Assumes ASCII for simplicity
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Returns the index of the first code point equal to c in s[from, n), or n.
+static size_t find_code_point(const uint32_t* s, size_t from, size_t n, uint32_t c) {
+    size_t i = from;
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    const uint32x4_t target = vdupq_n_u32(c);
+    while (i + 4 <= n && vmaxvq_u32(vceqq_u32(vld1q_u32(s + i), target)) == 0) {
+        i += 4;
     }
-    return result;
+#elif defined(__SSE2__)
+    const __m128i target = _mm_set1_epi32((int)c);
+    while (i + 4 <= n) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(const void*)(s + i));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi32(v, target));
+        if (mask != 0) return i + (size_t)(__builtin_ctz((unsigned)mask) >> 2);
+        i += 4;
+    }
+#endif
+    while (i < n && s[i] != c) i++;
+    return i;
+}
+
+// Latin-1 counterpart for compact strings.
+static size_t find_code_point(const uint8_t* s, size_t from, size_t n, uint8_t c) {
+    if (from >= n) return n;
+    const void* hit = std::memchr(s + from, c, n - from);
+    return hit ? (size_t)(static_cast<const uint8_t*>(hit) - s) : n;
 }
 
-// Helper to allocate a BCPL string payload from a std::string
-static uint32_t* std_string_to_bcpl(const std::string& str) {
-    uint32_t* bcpl_str = (uint32_t*)bcpl_alloc_chars(str.length());
-    for (size_t i = 0; i < str.length(); ++i) {
-        bcpl_str[i] = static_cast<uint32_t>(str[i]);
+// Returns the start of the first occurrence of delim[0, m) in s[from, n),
+// or n. Candidates are found by scanning for the first delimiter character.
+template <typename Char>
+static size_t find_delimiter(const Char* s, size_t from, size_t n, const Char* delim, size_t m) {
+    if (m > n) return n;
+    size_t last_start = n - m;
+    for (size_t i = from; i <= last_start; ++i) {
+        i = find_code_point(s, i, last_start + 1, delim[0]);
+        if (i > last_start) break;
+        if (std::memcmp(s + i + 1, delim + 1, (m - 1) * sizeof(Char)) == 0) return i;
     }
-    bcpl_str[str.length()] = 0;
-    return bcpl_str;
+    return n;
+}
+
+// Calls fn(start, end) for each token of s[0, n) split on delim[0, m), in
+// order. An empty delimiter splits the source into single characters.
+template <typename Char, typename Fn>
+static void for_each_token(const Char* s, size_t n, const Char* delim, size_t m, Fn fn) {
+    if (m == 0) {
+        for (size_t i = 0; i < n; ++i) fn(i, i + 1);
+        return;
+    }
+    size_t start = 0;
+    while (true) {
+        size_t end = m == 1 ? find_code_point(s, start, n, delim[0]) : find_delimiter(s, start, n, delim, m);
+        fn(start, end);
+        if (end == n) return;
+        start = end + m;
+    }
+}
+
+// Bytes taken by one token record: a 64-bit length, the characters and a
+// terminator, rounded up to 8 bytes so the next record's length word is
+// aligned. Records are laid out from the 8-byte aligned start of the block.
+static size_t token_record_bytes(size_t length, size_t char_size) {
+    return (sizeof(uint64_t) + (length + 1) * char_size + 7) & ~(size_t)7;
+}
+
+// The same for a UTF-32 record, in code points of the storage block.
+// MAP_KEYS lays out its string keys this way too.
+extern "C" size_t bcpl_string_record_chars(size_t length) {
+    return token_record_bytes(length, sizeof(uint32_t)) / sizeof(uint32_t);
+}
+
+// Lays out the tokens of source as records in one storage block owned by
+// the list. tokens(fn) calls fn(start, end) for each token in order.
+template <typename Char, typename Tokens>
+static void split_into_records(struct ListHeader* result_list, const Char* source, Tokens tokens) {
+    const bool compact = sizeof(Char) == 1;
+    // Storage is counted in the block's 32-bit code points.
+    auto record_size = [&](size_t length) {
+        return token_record_bytes(length, sizeof(Char)) / sizeof(uint32_t);
+    };
+
+    size_t storage_chars = 0;
+    tokens([&](size_t start, size_t end) {
+        storage_chars += record_size(end - start);
+    });
+    if (storage_chars == 0) return;
+
+    uint32_t* storage = static_cast<uint32_t*>(bcpl_alloc_chars((int64_t)storage_chars));
+    if (!storage) return;
+    result_list->strings = storage;
+
+    uint32_t* record = storage;
+    tokens([&](size_t start, size_t end) {
+        uint64_t length = end - start;
+        uint64_t prefix = length | (compact ? BCPL_STRING_COMPACT : BCPL_STRING_TRUSTED);
+        std::memcpy(record, &prefix, sizeof(prefix));
+        Char* chars = reinterpret_cast<Char*>(record + 2);
+        std::memcpy(chars, source + start, length * sizeof(Char));
+        chars[length] = 0;
+        BCPL_LIST_APPEND_STRING(result_list, record);
+        record += record_size(length);
+    });
 }
 
-// SPLIT implementation: returns a ListHeader* of BCPL strings
+// SPLIT implementation: returns a ListHeader* of BCPL strings.
+//
+// The source is searched in its own form: as UTF-32, so any code point can
+// appear in the source or the delimiter, or as Latin-1 for a compact source,
+// whose tokens are then compact too. A first pass sizes the tokens; the
+// second lays them out as consecutive [length][characters][0] records in a
+// single heap block owned by the list, which bcpl_free_list releases in one
+// go. Each atom holds the base pointer of its record, as JOIN expects.
 extern "C" struct ListHeader* BCPL_SPLIT_STRING(uint32_t* source_payload, uint32_t* delimiter_payload) {
-    // 1. Create the list to hold the results.
     struct ListHeader* result_list = BCPL_LIST_CREATE_EMPTY();
 
-    // 2. Convert BCPL strings to std::string for easier processing.
-    std::string source = bcpl_to_std_string(source_payload);
-    std::string delimiter = bcpl_to_std_string(delimiter_payload);
-
-    // 3. Handle edge case of an empty delimiter.
-    if (delimiter.empty()) {
-        // Split into individual characters
-        for (char c : source) {
-            std::string char_str(1, c);
-            uint32_t* new_bcpl_str_payload = std_string_to_bcpl(char_str);
-            // Back up from the payload pointer to get the true base pointer
-            void* base_ptr = static_cast<uint64_t*>(static_cast<void*>(new_bcpl_str_payload)) - 1;
-            // Append the base pointer, making it consistent with LIST(...)
-            BCPL_LIST_APPEND_STRING(result_list, static_cast<uint32_t*>(base_ptr));
+    static const uint32_t empty = 0;
+    const uint32_t* source = source_payload ? source_payload : &empty;
+    const uint32_t* delimiter = delimiter_payload ? delimiter_payload : &empty;
+    size_t n = source_payload ? (size_t)STRLEN(source_payload) : 0;
+    size_t m = delimiter_payload ? (size_t)STRLEN(delimiter_payload) : 0;
+    bool source_compact = source_payload && bcpl_string_is_compact(source_payload);
+    bool delimiter_compact = delimiter_payload && bcpl_string_is_compact(delimiter_payload);
+
+    // The delimiter is converted to the source's form for the search.
+    auto split_on = [&](auto* chars, auto* delim) {
+        split_into_records(result_list, chars, [&](auto fn) { for_each_token(chars, n, delim, m, fn); });
+    };
+
+    if (!source_compact) {
+        if (delimiter_compact) {
+            const uint8_t* narrow = reinterpret_cast<const uint8_t*>(delimiter);
+            std::u32string wide(narrow, narrow + m);
+            split_on(source, reinterpret_cast<const uint32_t*>(wide.c_str()));
+        } else {
+            split_on(source, delimiter);
         }
         return result_list;
     }
 
-    // 4. Find and split substrings.
-    size_t start = 0;
-    size_t end = source.find(delimiter);
-    while (end != std::string::npos) {
-        std::string token = source.substr(start, end - start);
-        uint32_t* new_bcpl_str_payload = std_string_to_bcpl(token);
-        void* base_ptr = static_cast<uint64_t*>(static_cast<void*>(new_bcpl_str_payload)) - 1;
-        BCPL_LIST_APPEND_STRING(result_list, static_cast<uint32_t*>(base_ptr));
-
-        start = end + delimiter.length();
-        end = source.find(delimiter, start);
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(source);
+    if (delimiter_compact) {
+        split_on(bytes, reinterpret_cast<const uint8_t*>(delimiter));
+        return result_list;
     }
-
-    // 5. Add the final substring after the last delimiter.
-    std::string last_token = source.substr(start, std::string::npos);
-    uint32_t* new_bcpl_str_payload = std_string_to_bcpl(last_token);
-    void* base_ptr = static_cast<uint64_t*>(static_cast<void*>(new_bcpl_str_payload)) - 1;
-    BCPL_LIST_APPEND_STRING(result_list, static_cast<uint32_t*>(base_ptr));
-
+    std::string narrow(m, '\0');
+    for (size_t i = 0; i < m; ++i) {
+        if (delimiter[i] > 0xFF) {
+            // A delimiter outside Latin-1 never occurs in a compact source.
+            split_into_records(result_list, bytes, [&](auto fn) { fn(0, n); });
+            return result_list;
+        }
+        narrow[i] = static_cast<char>(delimiter[i]);
+    }
+    split_on(bytes, reinterpret_cast<const uint8_t*>(narrow.c_str()));
     return result_list;
 }
 
-// JOIN implementation: returns a BCPL string payload
+// JOIN implementation: returns a BCPL string payload. The result is compact
+// when every element and the delimiter are; otherwise it is UTF-32 and any
+// compact pieces are widened into it.
 extern "C" uint32_t* BCPL_JOIN_LIST(struct ListHeader* list_header, uint32_t* delimiter_payload) {
     if (!list_header || !list_header->head) {
         return (uint32_t*)bcpl_alloc_chars(0); // Return a new empty string
     }
 
-    std::string delimiter = bcpl_to_std_string(delimiter_payload);
-    size_t delimiter_len = delimiter.length();
+    size_t delimiter_len = delimiter_payload ? (size_t)STRLEN(delimiter_payload) : 0;
+    bool compact = !delimiter_payload || bcpl_string_is_compact(delimiter_payload);
 
-    // --- Pass 1: Calculate total size (Corrected) ---
+    // --- Pass 1: Calculate total size and the result form ---
     size_t total_len = 0;
     size_t element_count = 0;
     ListAtom* current = list_header->head;
@@ -88,12 +188,11 @@ extern "C" uint32_t* BCPL_JOIN_LIST(struct ListHeader* list_header, uint32_t* de
         if (current->type != ATOM_STRING) {
             return nullptr; // Error: non-string in list
         }
-        
-        // FIX: Treat ptr_value as the BASE pointer to the [length][payload] struct.
-        uint64_t* base_ptr = (uint64_t*)current->value.ptr_value;
-        size_t element_len = base_ptr[0]; // Length is at the start of the struct.
 
-        total_len += element_len;
+        // ptr_value is the BASE pointer to the [length][payload] struct.
+        uint64_t* base_ptr = (uint64_t*)current->value.ptr_value;
+        total_len += base_ptr[0] & BCPL_STRING_LENGTH_MASK;
+        compact = compact && bcpl_string_is_compact(base_ptr + 1);
         ++element_count;
         current = current->next;
     }
@@ -102,29 +201,42 @@ extern "C" uint32_t* BCPL_JOIN_LIST(struct ListHeader* list_header, uint32_t* de
         total_len += delimiter_len * (element_count - 1);
     }
 
-    // --- Pass 2: Allocate and build the new string (Corrected) ---
-    uint32_t* result_payload = (uint32_t*)bcpl_alloc_chars(total_len);
-    uint32_t* cursor = result_payload;
-
-    current = list_header->head;
-    while (current) {
-        // FIX: Recalculate pointers correctly based on the base pointer.
-        uint64_t* base_ptr = (uint64_t*)current->value.ptr_value;
-        size_t element_len = base_ptr[0];
-        uint32_t* element_payload = (uint32_t*)(base_ptr + 1); // Payload is after the length.
-
-        // Copy string element from the correct payload address.
-        std::memcpy(cursor, element_payload, element_len * sizeof(uint32_t));
-        cursor += element_len;
-
-        // Add delimiter if not last element.
-        if (current->next && delimiter_len > 0) {
-            for (size_t i = 0; i < delimiter_len; ++i) {
-                *cursor++ = static_cast<uint32_t>(delimiter[i]);
+    // --- Pass 2: Allocate and build the new string ---
+    if (compact) {
+        uint8_t* result_payload = (uint8_t*)bcpl_alloc_compact_chars(total_len);
+        if (!result_payload) return nullptr;
+        uint8_t* cursor = result_payload;
+        for (current = list_header->head; current; current = current->next) {
+            uint64_t* base_ptr = (uint64_t*)current->value.ptr_value;
+            size_t element_len = base_ptr[0] & BCPL_STRING_LENGTH_MASK;
+            std::memcpy(cursor, base_ptr + 1, element_len);
+            cursor += element_len;
+            if (current->next && delimiter_len > 0) {
+                std::memcpy(cursor, delimiter_payload, delimiter_len);
+                cursor += delimiter_len;
             }
         }
-        current = current->next;
+        *cursor = 0;
+        return (uint32_t*)result_payload;
     }
 
+    uint32_t* result_payload = (uint32_t*)bcpl_alloc_chars(total_len);
+    if (!result_payload) return nullptr;
+    uint32_t* cursor = result_payload;
+    auto append = [&](const uint32_t* payload, size_t length) {
+        if (bcpl_string_is_compact(payload)) {
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(payload);
+            for (size_t i = 0; i < length; ++i) cursor[i] = bytes[i];
+        } else {
+            std::memcpy(cursor, payload, length * sizeof(uint32_t));
+        }
+        cursor += length;
+    };
+    for (current = list_header->head; current; current = current->next) {
+        uint64_t* base_ptr = (uint64_t*)current->value.ptr_value;
+        append((uint32_t*)(base_ptr + 1), base_ptr[0] & BCPL_STRING_LENGTH_MASK);
+        if (current->next && delimiter_len > 0) append(delimiter_payload, delimiter_len);
+    }
+    *cursor = 0;
     return result_payload;
-}
\ No newline at end of file
+}
@@ -25,21 +25,25 @@ int main() {
     // Test WRITES
     printf("\nTesting WRITES: ");
     WRITES(hello_str);
+    bcpl_flush_output(); // WRITE* output is buffered; keep it ordered with printf
     printf("\n");
     
     // Test WRITEN
     printf("Testing WRITEN: ");
     WRITEN(12345);
+    bcpl_flush_output(); // WRITE* output is buffered; keep it ordered with printf
     printf("\n");
     
     // Test WRITEF
     printf("Testing WRITEF: ");
     WRITEF(3.14159);
+    bcpl_flush_output(); // WRITE* output is buffered; keep it ordered with printf
     printf("\n");
     
     // Test WRITEC
     printf("Testing WRITEC: ");
     WRITEC('A');
+    bcpl_flush_output(); // WRITE* output is buffered; keep it ordered with printf
     printf("\n");
     
     // Test string functions
@@ -66,6 +70,7 @@ int main() {
     STRCOPY(copy_str, hello_str);
     printf("STRCOPY result: ");
     WRITES(copy_str);
+    bcpl_flush_output(); // WRITE* output is buffered; keep it ordered with printf
     printf("\n");
     
     // Test PACKSTRING and UNPACKSTRING
@@ -81,6 +86,7 @@ int main() {
     
     printf("Original string (showing only ASCII): ");
     WRITES(unicode_str);
+    bcpl_flush_output(); // WRITE* output is buffered; keep it ordered with printf
     printf("\n");
     
     // Pack it to UTF-8
@@ -108,6 +114,7 @@ int main() {
     
     printf("Unpacked string (showing only ASCII): ");
     WRITES(unpacked);
+    bcpl_flush_output(); // WRITE* output is buffered; keep it ordered with printf
     printf("\n");
     
     // Verify the unpacked string matches the original
@@ -157,6 +164,7 @@ int main() {
     
     printf("Writing to file: ");
     WRITES(test_filename);
+    bcpl_flush_output(); // WRITE* output is buffered; keep it ordered with printf
     printf("\n");
     
     // Write to file
@@ -169,6 +177,7 @@ int main() {
     if (read_content) {
         printf("File content: ");
         WRITES(read_content);
+        bcpl_flush_output(); // WRITE* output is buffered; keep it ordered with printf
         printf("\n");
         bcpl_free(read_content);
     } else {
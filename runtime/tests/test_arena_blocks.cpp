@@ -0,0 +1,51 @@
+// test_arena_blocks.cpp
+// Blocks allocated inside an arena region: an individual free is a no-op,
+// and a resize moves the block to a tracked heap block outside the region
+// that survives ARENA_POP.
+
+#include "HeapManager.h"
+#include "heap_manager_defs.h"
+#include "test_support.h"
+#include <cstdint>
+
+static bool tracked(const void* payload) {
+    return heap_table_find(static_cast<const uint8_t*>(payload) - sizeof(uint64_t)) != nullptr;
+}
+
+int main() {
+    HeapManager& heap = HeapManager::getInstance();
+
+    heap.arenaPush();
+    uint64_t* vec = static_cast<uint64_t*>(heap.allocVec(4));
+    uint32_t* str = static_cast<uint32_t*>(heap.allocString(3));
+    CHECK(!tracked(vec));
+    CHECK(!tracked(str));
+    for (uint64_t i = 0; i < 4; i++) vec[i] = i + 10;
+    str[0] = 'a'; str[1] = 'b'; str[2] = 'c';
+
+    // Freeing a region block individually leaves it usable until the pop.
+    uint64_t* spare = static_cast<uint64_t*>(heap.allocVec(2));
+    spare[0] = 7;
+    heap.free(spare);
+    CHECK(spare[0] == 7);
+
+    uint64_t* grown_vec = static_cast<uint64_t*>(heap.resizeVec(vec, 1000));
+    uint32_t* grown_str = static_cast<uint32_t*>(heap.resizeString(str, 1000));
+    CHECK(tracked(grown_vec));
+    CHECK(tracked(grown_str));
+    heap.arenaPop();
+
+    // The moved blocks live outside the region and keep their contents.
+    CHECK(grown_vec[-1] == 1000);
+    for (uint64_t i = 0; i < 4; i++) CHECK(grown_vec[i] == i + 10);
+    CHECK(grown_str[0] == 'a' && grown_str[1] == 'b' && grown_str[2] == 'c');
+    CHECK(grown_str[1000] == 0);
+    grown_vec[999] = 1;
+
+    heap.free(grown_vec);
+    heap.free(grown_str);
+    CHECK(!tracked(grown_vec));
+    CHECK(!tracked(grown_str));
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,89 @@
+// test_arena_resize.cpp
+// Resizing while an arena region is active. A tracked block stays tracked
+// and a region block moves to a tracked block outside the region; neither
+// result may land in the region, so both survive ARENA_POP. Every resize
+// counts its old size as freed and its new size as allocated, so once all
+// blocks are freed the byte totals balance.
+
+#include "HeapManager.h"
+#include "heap_manager_defs.h"
+#include "test_support.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+
+static bool tracked(const void* payload) {
+    return heap_table_find(static_cast<const uint8_t*>(payload) - sizeof(uint64_t)) != nullptr;
+}
+
+// printMetrics writes to stderr; capture it and read one total back.
+static long long metric(HeapManager& heap, const char* name) {
+    std::FILE* capture = std::tmpfile();
+    int saved = dup(STDERR_FILENO);
+    dup2(fileno(capture), STDERR_FILENO);
+    heap.printMetrics();
+    dup2(saved, STDERR_FILENO);
+    close(saved);
+
+    std::string text;
+    char buf[256];
+    std::rewind(capture);
+    size_t n;
+    while ((n = std::fread(buf, 1, sizeof(buf), capture)) > 0) text.append(buf, n);
+    std::fclose(capture);
+
+    size_t at = text.find(std::string(name) + ": ");
+    if (at == std::string::npos) return -1;
+    return std::atoll(text.c_str() + at + std::strlen(name) + 2);
+}
+
+int main() {
+    HeapManager& heap = HeapManager::getInstance();
+
+    uint64_t* heap_vec = static_cast<uint64_t*>(heap.allocVec(4));
+    uint32_t* heap_str = static_cast<uint32_t*>(heap.allocString(3));
+    for (uint64_t i = 0; i < 4; i++) heap_vec[i] = i + 1;
+    heap_str[0] = 'x'; heap_str[1] = 'y'; heap_str[2] = 'z';
+
+    heap.arenaPush();
+    uint64_t* arena_vec = static_cast<uint64_t*>(heap.allocVec(4));
+    uint32_t* arena_str = static_cast<uint32_t*>(heap.allocString(3));
+    for (uint64_t i = 0; i < 4; i++) arena_vec[i] = i + 10;
+    arena_str[0] = 'a'; arena_str[1] = 'b'; arena_str[2] = 'c';
+
+    // Tracked blocks resized under the region.
+    heap_vec = static_cast<uint64_t*>(heap.resizeVec(heap_vec, 500));
+    heap_str = static_cast<uint32_t*>(heap.resizeString(heap_str, 500));
+    // Region blocks resized out of it, growing and shrinking.
+    arena_vec = static_cast<uint64_t*>(heap.resizeVec(arena_vec, 500));
+    arena_str = static_cast<uint32_t*>(heap.resizeString(arena_str, 2));
+    CHECK(tracked(heap_vec));
+    CHECK(tracked(heap_str));
+    CHECK(tracked(arena_vec));
+    CHECK(tracked(arena_str));
+    heap.arenaPop();
+
+    // All four live outside the popped region with their contents.
+    for (uint64_t i = 0; i < 4; i++) CHECK(heap_vec[i] == i + 1);
+    for (uint64_t i = 0; i < 4; i++) CHECK(arena_vec[i] == i + 10);
+    CHECK(heap_str[0] == 'x' && heap_str[1] == 'y' && heap_str[2] == 'z');
+    CHECK(arena_str[0] == 'a' && arena_str[1] == 'b' && arena_str[2] == 0);
+    CHECK(heap_vec[-1] == 500 && arena_vec[-1] == 500);
+
+    // Resizes on the way down as well.
+    heap_vec = static_cast<uint64_t*>(heap.resizeVec(heap_vec, 2));
+    CHECK(heap_vec[0] == 1 && heap_vec[1] == 2);
+
+    CHECK(metric(heap, "Total Bytes Freed") <= metric(heap, "Total Bytes Allocated"));
+    heap.free(heap_vec);
+    heap.free(heap_str);
+    heap.free(arena_vec);
+    heap.free(arena_str);
+    long long allocated = metric(heap, "Total Bytes Allocated");
+    CHECK(allocated > 0);
+    CHECK(metric(heap, "Total Bytes Freed") == allocated);
+
+    return TEST_RESULT();
+}
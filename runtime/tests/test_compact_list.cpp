@@ -0,0 +1,62 @@
+// test_compact_list.cpp
+// COMPACTLIST only takes a fresh chunk when the freelist has no run long
+// enough for the list: a list that is already one run is left in place,
+// and a short scattered list is copied into the run at the freelist head.
+
+#include "ListDataTypes.h"
+#include "heap_interface.h"
+#include "runtime.h"
+#include "test_support.h"
+#include <cstdint>
+
+extern "C" void BCPL_LIST_APPEND_INT(ListHeader* header, int64_t value);
+extern "C" void bcpl_free_list(ListHeader* header);
+
+static size_t chunk_count() {
+    size_t chunks, total_nodes, free_nodes, empty_chunks, chunks_released;
+    bcpl_list_freelist_stats(&chunks, &total_nodes, &free_nodes, &empty_chunks, &chunks_released);
+    return chunks;
+}
+
+static bool in_order(const ListHeader* header, int64_t first, int64_t step) {
+    int64_t expected = first;
+    for (const ListAtom* atom = header->head; atom; atom = atom->next) {
+        if (atom->value.int_value != expected) return false;
+        expected += step;
+    }
+    return true;
+}
+
+int main() {
+    // A list appended in one go is already one run.
+    ListHeader* single = BCPL_LIST_CREATE_EMPTY();
+    for (int64_t i = 0; i < 3; i++) BCPL_LIST_APPEND_INT(single, i);
+    size_t chunks = chunk_count();
+    ListAtom* head = single->head;
+    COMPACTLIST(single);
+    CHECK(chunk_count() == chunks);
+    CHECK(single->head == head);
+    CHECK(single->length == 3);
+    CHECK(in_order(single, 0, 1));
+
+    // Two short lists built in alternation are scattered; compacting one
+    // reuses the freelist instead of growing the heap.
+    ListHeader* a = BCPL_LIST_CREATE_EMPTY();
+    ListHeader* b = BCPL_LIST_CREATE_EMPTY();
+    for (int64_t i = 0; i < 5; i++) {
+        BCPL_LIST_APPEND_INT(a, i);
+        BCPL_LIST_APPEND_INT(b, -i);
+    }
+    chunks = chunk_count();
+    COMPACTLIST(a);
+    CHECK(chunk_count() == chunks);
+    CHECK(a->length == 5);
+    CHECK(a->runs == 1);
+    CHECK(in_order(a, 0, 1));
+    CHECK(in_order(b, 0, -1));
+
+    bcpl_free_list(single);
+    bcpl_free_list(a);
+    bcpl_free_list(b);
+    return TEST_RESULT();
+}
@@ -0,0 +1,61 @@
+// test_compact_strings.cpp
+// A string is compact only when the upper half of its length word is the
+// runtime's compact tag, so a value a program stored in front of a pointer
+// into a vector is never read as a compact length. STRCOPY refuses to put
+// a character above 0xFF into a compact string instead of truncating it.
+
+#include "runtime.h"
+#include "test_support.h"
+#include <cstdint>
+#include <cstring>
+
+static uint32_t* make_string(const uint32_t* chars, int64_t n) {
+    uint32_t* s = (uint32_t*)bcpl_alloc_chars(n);
+    for (int64_t i = 0; i < n; i++) s[i] = chars[i];
+    return s;
+}
+
+int main() {
+    // The old compact flag (bit 63 alone) with a huge length in front of
+    // "hi" in a vector: neither compact nor trusted.
+    uint64_t* v = (uint64_t*)bcpl_alloc_words(4, "main", "v");
+    v[0] = ((uint64_t)1 << 63) | 3000000000u;
+    v[1] = 'h' | ((uint64_t)'i' << 32);
+    v[2] = 0;
+    uint32_t* inner = (uint32_t*)(v + 1);
+    CHECK(!bcpl_string_is_compact(inner));
+    CHECK(STRLEN(inner) == 2);
+
+    // The test reads an unaligned word without faulting.
+    uint8_t bytes[32] = {0};
+    CHECK(!bcpl_string_is_compact(bytes + 9));
+
+    uint8_t* compact = (uint8_t*)bcpl_alloc_compact_chars(5);
+    std::memcpy(compact, "hello", 5);
+    CHECK(bcpl_string_is_compact(compact));
+    CHECK(STRLEN((uint32_t*)compact) == 5);
+
+    // Latin-1 characters copy in as bytes.
+    const uint32_t latin1[] = {'c', 0xE9, 'l', 'a'};
+    uint32_t* wide = make_string(latin1, 4);
+    CHECK(STRCOPY((uint32_t*)compact, wide) == (uint32_t*)compact);
+    CHECK(STRLEN((uint32_t*)compact) == 4);
+    CHECK(compact[1] == 0xE9 && compact[4] == 0);
+
+    // A wider character is an error and leaves the destination alone.
+    const uint32_t snowman[] = {'s', 'n', 0x2603};
+    uint32_t* wider = make_string(snowman, 3);
+    CHECK(STRCOPY((uint32_t*)compact, wider) == nullptr);
+    CHECK(STRLEN((uint32_t*)compact) == 4);
+    CHECK(compact[0] == 'c' && compact[1] == 0xE9);
+
+    // UTF-32 destinations take any character.
+    CHECK(STRCOPY(wide, wider) == wide);
+    CHECK(STRLEN(wide) == 3 && wide[2] == 0x2603);
+
+    bcpl_free(v);
+    bcpl_free(compact);
+    bcpl_free(wide);
+    bcpl_free(wider);
+    return TEST_RESULT();
+}
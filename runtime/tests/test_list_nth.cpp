@@ -0,0 +1,63 @@
+// test_list_nth.cpp
+// GET_NTH on runtime lists and on read-only list literals. Only runtime
+// headers carry a checkpoint index; a literal's 32-byte header is followed
+// by whatever the compiler emitted next, so GET_NTH must walk it without
+// touching anything past the header. The literal here sits in a read-only
+// page right before an inaccessible one.
+
+#include "ListDataTypes.h"
+#include "heap_interface.h"
+#include "test_support.h"
+#include <cstdint>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <vector>
+
+extern "C" void BCPL_LIST_APPEND_INT(ListHeader* header, int64_t value);
+extern "C" void* BCPL_LIST_GET_NTH(void* header_ptr, int64_t n);
+extern "C" void bcpl_free_list(ListHeader* header);
+
+static const int64_t kCount = 1001;
+
+static bool nth_is(void* header, int64_t n, int64_t value) {
+    ListAtom* atom = (ListAtom*)BCPL_LIST_GET_NTH(header, n);
+    return atom && atom->type == ATOM_INT && atom->value.int_value == value;
+}
+
+int main() {
+    ListHeader* list = BCPL_LIST_CREATE_EMPTY();
+    for (int64_t i = 0; i < kCount; i++) BCPL_LIST_APPEND_INT(list, i * 10);
+    CHECK(list->flags & LIST_FLAG_RUNTIME);
+    for (int64_t n : {0, 7, 8, 1000, 500, 9}) CHECK(nth_is(list, n, n * 10));
+    CHECK(BCPL_LIST_GET_NTH(list, kCount) == nullptr);
+    CHECK(list->index != nullptr);
+    bcpl_free_list(list);
+
+    // A literal laid out as the compiler emits it, with the header in the
+    // last 32 bytes of a read-only page.
+    std::vector<ListAtom> atoms(kCount);
+    for (int64_t i = 0; i < kCount; i++) {
+        atoms[i].type = ATOM_INT;
+        atoms[i].pad = 0;
+        atoms[i].value.int_value = i * 10;
+        atoms[i].next = i + 1 < kCount ? &atoms[i + 1] : nullptr;
+    }
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    uint8_t* pages = (uint8_t*)mmap(nullptr, page * 2, PROT_READ | PROT_WRITE,
+                                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pages == MAP_FAILED) return 1;
+    ListLiteralHeader* literal = (ListLiteralHeader*)(pages + page - sizeof(ListLiteralHeader));
+    literal->type = ATOM_SENTINEL;
+    literal->pad = 0;
+    literal->tail = &atoms[kCount - 1];
+    literal->head = &atoms[0];
+    literal->length = kCount;
+    mprotect(pages, page, PROT_READ);
+    mprotect(pages + page, page, PROT_NONE);
+
+    for (int64_t n : {0, 7, 8, 1000, 500, 9}) CHECK(nth_is(literal, n, n * 10));
+    CHECK(BCPL_LIST_GET_NTH(literal, kCount) == nullptr);
+
+    munmap(pages, page * 2);
+    return TEST_RESULT();
+}
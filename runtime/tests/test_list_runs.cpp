@@ -0,0 +1,128 @@
+// test_list_runs.cpp
+// LIST_FLAG_CONTIGUOUS and the run lengths FOREACH steps by. Every builder
+// must leave each run's first atom holding how many atoms follow it at the
+// next addresses, and a FOREACH-style walk must visit the list in order.
+
+#include "ListDataTypes.h"
+#include "heap_interface.h"
+#include "test_support.h"
+#include <cstdint>
+#include <vector>
+
+extern "C" void BCPL_LIST_APPEND_INT(ListHeader* header, int64_t value);
+extern "C" void returnNodeToFreelist_runtime(ListAtom* node, ListHeader* header);
+extern "C" void bcpl_free_list(ListHeader* header);
+
+// Each atom's run length must match the chain it claims to cover.
+static bool runs_valid(const ListHeader* header) {
+    for (const ListAtom* atom = header->head; atom; atom = atom->next) {
+        const ListAtom* probe = atom;
+        for (int32_t i = 0; i < atom->pad; i++) {
+            if (probe->next != probe + 1) return false;
+            probe = probe->next;
+        }
+    }
+    return true;
+}
+
+// Walks the list the way the FOREACH lowering does.
+static std::vector<int64_t> foreach_values(const ListHeader* header) {
+    std::vector<int64_t> values;
+    int64_t contig = header->flags & LIST_FLAG_CONTIGUOUS;
+    for (const ListAtom* cursor = header->head; cursor; cursor = cursor->next) {
+        int64_t left = cursor->pad * contig;
+        values.push_back(cursor->value.int_value);
+        while (left-- > 0) {
+            cursor++;
+            values.push_back(cursor->value.int_value);
+        }
+    }
+    return values;
+}
+
+static std::vector<int64_t> chain_values(const ListHeader* header) {
+    std::vector<int64_t> values;
+    for (const ListAtom* atom = header->head; atom; atom = atom->next) {
+        values.push_back(atom->value.int_value);
+    }
+    return values;
+}
+
+static bool flag_matches_runs(const ListHeader* header) {
+    bool expected = header->runs * LIST_CONTIGUOUS_MIN_RUN <= header->length;
+    return ((header->flags & LIST_FLAG_CONTIGUOUS) != 0) == expected;
+}
+
+// Pops the head the way the inline destructive TL does.
+static void pop_head(ListHeader* header) {
+    ListAtom* old_head = header->head;
+    header->head = old_head->next;
+    returnNodeToFreelist_runtime(old_head, header);
+    header->length--;
+}
+
+int main() {
+    const int64_t n = 300;
+
+    // A literal copied in one go is one run, with the length counted as
+    // atoms are linked rather than taken from the literal.
+    std::vector<ListAtom> literal_atoms(n);
+    for (int64_t i = 0; i < n; i++) {
+        literal_atoms[i].type = ATOM_INT;
+        literal_atoms[i].pad = 0;
+        literal_atoms[i].value.int_value = i;
+        literal_atoms[i].next = i + 1 < n ? &literal_atoms[i + 1] : nullptr;
+    }
+    ListLiteralHeader literal = {ATOM_SENTINEL, 0, &literal_atoms[n - 1], &literal_atoms[0], n};
+    ListHeader* copy = (ListHeader*)BCPL_DEEP_COPY_LITERAL_LIST(&literal);
+    CHECK(copy->length == n);
+    CHECK(flag_matches_runs(copy));
+    CHECK(copy->flags & LIST_FLAG_CONTIGUOUS);
+    CHECK(runs_valid(copy));
+    CHECK(foreach_values(copy) == chain_values(copy));
+
+    // Two lists built in alternation never have adjacent atoms.
+    ListHeader* a = BCPL_LIST_CREATE_EMPTY();
+    ListHeader* b = BCPL_LIST_CREATE_EMPTY();
+    for (int64_t i = 0; i < n; i++) {
+        BCPL_LIST_APPEND_INT(a, i);
+        BCPL_LIST_APPEND_INT(b, -i);
+    }
+    CHECK(!(a->flags & LIST_FLAG_CONTIGUOUS));
+    CHECK(runs_valid(a));
+    CHECK(foreach_values(a) == chain_values(a));
+
+    // COMPACTLIST lays them out in one run and counts them again.
+    std::vector<int64_t> before = chain_values(a);
+    COMPACTLIST(a);
+    CHECK(a->length == n);
+    CHECK(flag_matches_runs(a));
+    CHECK(a->flags & LIST_FLAG_CONTIGUOUS);
+    CHECK(runs_valid(a));
+    CHECK(chain_values(a) == before);
+    CHECK(foreach_values(a) == before);
+
+    // Popping the head hands the rest of its run to the next atom, and
+    // appends after that keep extending the right run.
+    pop_head(a);
+    pop_head(a);
+    for (int64_t i = 0; i < 10; i++) BCPL_LIST_APPEND_INT(a, 1000 + i);
+    CHECK(runs_valid(a));
+    CHECK(a->head->value.int_value == 2);
+    CHECK(foreach_values(a) == chain_values(a));
+
+    // Pop a list down to nothing and build it up again.
+    ListHeader* c = BCPL_LIST_CREATE_EMPTY();
+    for (int64_t i = 0; i < 3; i++) BCPL_LIST_APPEND_INT(c, i);
+    while (c->head) pop_head(c);
+    for (int64_t i = 0; i < 3; i++) BCPL_LIST_APPEND_INT(c, 10 + i);
+    CHECK(runs_valid(c));
+    CHECK(foreach_values(c) == chain_values(c));
+    CHECK(chain_values(c) == std::vector<int64_t>({10, 11, 12}));
+
+    bcpl_free_list(copy);
+    bcpl_free_list(a);
+    bcpl_free_list(b);
+    bcpl_free_list(c);
+    return TEST_RESULT();
+}
@@ -0,0 +1,70 @@
+// test_map_keys.cpp
+// MAP_KEYS returns string keys as records in a block owned by the list, so
+// FREELIST on the keys releases them without freeing record base pointers
+// one at a time (which are not allocations).
+
+#include "ListDataTypes.h"
+#include "heap_interface.h"
+#include "runtime.h"
+#include "test_support.h"
+#include <cstdint>
+#include <set>
+#include <string>
+
+extern "C" void bcpl_free_list(ListHeader* header);
+
+static uint32_t* make_string(const char* text) {
+    int64_t n = 0;
+    while (text[n]) n++;
+    uint32_t* s = (uint32_t*)bcpl_alloc_chars(n);
+    for (int64_t i = 0; i < n; i++) s[i] = (uint32_t)text[i];
+    return s;
+}
+
+int main() {
+    const char* names[] = {"alpha", "beta", "", "a somewhat longer key"};
+    BCPLMap* map = BCPL_MAP_NEW();
+    for (int64_t i = 0; i < 4; i++) {
+        uint32_t* key = make_string(names[i]);
+        BCPL_MAP_PUT(map, (int64_t)key, ATOM_STRING, i);
+        bcpl_free(key);
+    }
+    BCPL_MAP_PUT(map, 7, ATOM_INT, 70);
+
+    ListHeader* keys = BCPL_MAP_KEYS(map);
+    CHECK(keys->length == 5);
+    CHECK(keys->strings != nullptr);
+
+    std::set<std::string> expected(names, names + 4);
+    std::set<std::string> seen;
+    int ints = 0;
+    for (ListAtom* atom = keys->head; atom; atom = atom->next) {
+        if (atom->type == ATOM_INT) {
+            CHECK(atom->value.int_value == 7);
+            ints++;
+            continue;
+        }
+        CHECK(atom->type == ATOM_STRING);
+        // Atoms hold the record's base pointer; the characters follow the length word.
+        uint32_t* chars = (uint32_t*)((uint64_t*)atom->value.ptr_value + 1);
+        std::string text;
+        for (int64_t i = 0; i < STRLEN(chars); i++) text += (char)chars[i];
+        seen.insert(text);
+    }
+    CHECK(ints == 1);
+    CHECK(seen == expected);
+
+    // Keys outlive the map and are released with their list.
+    BCPL_MAP_FREE(map);
+    bcpl_free_list(keys);
+
+    // A map without string keys needs no block.
+    BCPLMap* numbers = BCPL_MAP_NEW();
+    BCPL_MAP_PUT(numbers, 1, ATOM_INT, 1);
+    ListHeader* number_keys = BCPL_MAP_KEYS(numbers);
+    CHECK(number_keys->strings == nullptr);
+    bcpl_free_list(number_keys);
+    BCPL_MAP_FREE(numbers);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,183 @@
+// test_map_ops.cpp
+// MAP_PUT/GET/HAS/DEL against std::unordered_map over a random sequence,
+// growth past three quarters full, backward-shift deletion in a cluster
+// that wraps past the end of the table, and key identity: compact and
+// UTF-32 strings with the same text are one key, 1 and 1.0 are two.
+
+#include "ListDataTypes.h"
+#include "heap_interface.h"
+#include "runtime.h"
+#include "test_support.h"
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+static int64_t float_bits(double d) {
+    int64_t bits;
+    std::memcpy(&bits, &d, sizeof(bits));
+    return bits;
+}
+
+// The home slot of an integer key in a 16-slot table, as runtime_map.cpp
+// computes it. Only used to pick keys that form a wrapping cluster.
+static size_t home_slot(int64_t key) {
+    uint64_t x = (uint64_t)key ^ ((uint64_t)ATOM_INT << 56);
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x & 15;
+}
+
+static int64_t key_with_home(size_t home, int64_t& next) {
+    while (home_slot(next) != home) next++;
+    return next++;
+}
+
+static void random_ops() {
+    // Keys from a small range so that deleting and reinserting the same
+    // keys is common and clusters form and break up.
+    std::mt19937_64 rng(12345);
+    BCPLMap* map = BCPL_MAP_NEW();
+    std::unordered_map<int64_t, int64_t> expected;
+    for (int op = 0; op < 200000; op++) {
+        int64_t key = (int64_t)(rng() % 600) - 300;
+        switch (rng() % 4) {
+            case 0:
+            case 1: {
+                int64_t value = (int64_t)rng();
+                BCPL_MAP_PUT(map, key, ATOM_INT, value);
+                expected[key] = value;
+                break;
+            }
+            case 2:
+                CHECK(BCPL_MAP_DEL(map, key, ATOM_INT) == (int64_t)expected.erase(key));
+                break;
+            default: {
+                auto it = expected.find(key);
+                CHECK(BCPL_MAP_HAS(map, key, ATOM_INT) == (it != expected.end()));
+                CHECK(BCPL_MAP_GET(map, key, ATOM_INT) == (it != expected.end() ? it->second : 0));
+                break;
+            }
+        }
+        CHECK(BCPL_MAP_SIZE(map) == (int64_t)expected.size());
+        if (op % 20000 == 0) {
+            for (int64_t k = -300; k < 300; k++) {
+                auto it = expected.find(k);
+                CHECK(BCPL_MAP_GET(map, k, ATOM_INT) == (it != expected.end() ? it->second : 0));
+            }
+        }
+    }
+    BCPL_MAP_FREE(map);
+}
+
+static void growth() {
+    // 16 slots hold 12 keys; the 13th and every later doubling rehash.
+    BCPLMap* map = BCPL_MAP_NEW();
+    for (int64_t k = 0; k < 5000; k++) {
+        BCPL_MAP_PUT(map, k * 7919, ATOM_INT, k);
+        if (k == 12 || k == 24 || k == 48 || k == 4999) {
+            for (int64_t j = 0; j <= k; j++) CHECK(BCPL_MAP_GET(map, j * 7919, ATOM_INT) == j);
+        }
+    }
+    CHECK(BCPL_MAP_SIZE(map) == 5000);
+    for (int64_t k = 0; k < 5000; k += 2) CHECK(BCPL_MAP_DEL(map, k * 7919, ATOM_INT) == 1);
+    for (int64_t k = 0; k < 5000; k++) {
+        CHECK(BCPL_MAP_HAS(map, k * 7919, ATOM_INT) == (k % 2));
+    }
+    CHECK(BCPL_MAP_SIZE(map) == 2500);
+    BCPL_MAP_FREE(map);
+}
+
+static void wrapped_cluster() {
+    // a, b and d hash to the last slot and c to the first, so they occupy
+    // slots 15, 0, 1 and 2. Deleting a must shift b, c and d back across
+    // the end of the table; deleting c afterwards must leave d reachable.
+    int64_t next = 1;
+    int64_t a = key_with_home(15, next);
+    int64_t b = key_with_home(15, next);
+    int64_t c = key_with_home(0, next);
+    int64_t d = key_with_home(15, next);
+    int64_t e = key_with_home(14, next);
+
+    BCPLMap* map = BCPL_MAP_NEW();
+    BCPL_MAP_PUT(map, e, ATOM_INT, 5);
+    BCPL_MAP_PUT(map, a, ATOM_INT, 1);
+    BCPL_MAP_PUT(map, b, ATOM_INT, 2);
+    BCPL_MAP_PUT(map, c, ATOM_INT, 3);
+    BCPL_MAP_PUT(map, d, ATOM_INT, 4);
+
+    CHECK(BCPL_MAP_DEL(map, a, ATOM_INT) == 1);
+    CHECK(!BCPL_MAP_HAS(map, a, ATOM_INT));
+    CHECK(BCPL_MAP_GET(map, b, ATOM_INT) == 2);
+    CHECK(BCPL_MAP_GET(map, c, ATOM_INT) == 3);
+    CHECK(BCPL_MAP_GET(map, d, ATOM_INT) == 4);
+    CHECK(BCPL_MAP_GET(map, e, ATOM_INT) == 5);
+
+    CHECK(BCPL_MAP_DEL(map, c, ATOM_INT) == 1);
+    CHECK(BCPL_MAP_GET(map, b, ATOM_INT) == 2);
+    CHECK(BCPL_MAP_GET(map, d, ATOM_INT) == 4);
+    CHECK(BCPL_MAP_DEL(map, e, ATOM_INT) == 1);
+    CHECK(BCPL_MAP_GET(map, b, ATOM_INT) == 2);
+    CHECK(BCPL_MAP_GET(map, d, ATOM_INT) == 4);
+    CHECK(BCPL_MAP_DEL(map, c, ATOM_INT) == 0);
+    CHECK(BCPL_MAP_SIZE(map) == 2);
+
+    // The cluster re-forms after its keys come back.
+    BCPL_MAP_PUT(map, a, ATOM_INT, 10);
+    BCPL_MAP_PUT(map, c, ATOM_INT, 30);
+    CHECK(BCPL_MAP_GET(map, a, ATOM_INT) == 10);
+    CHECK(BCPL_MAP_GET(map, c, ATOM_INT) == 30);
+    CHECK(BCPL_MAP_SIZE(map) == 4);
+    BCPL_MAP_FREE(map);
+}
+
+static void key_identity() {
+    BCPLMap* map = BCPL_MAP_NEW();
+
+    // "café" as a compact string and as a UTF-32 string.
+    const uint8_t text[] = {'c', 'a', 'f', 0xE9};
+    uint8_t* compact = (uint8_t*)bcpl_alloc_compact_chars(4);
+    uint32_t* wide = (uint32_t*)bcpl_alloc_chars(4);
+    for (int i = 0; i < 4; i++) {
+        compact[i] = text[i];
+        wide[i] = text[i];
+    }
+    BCPL_MAP_PUT(map, (int64_t)compact, ATOM_STRING, 1);
+    CHECK(BCPL_MAP_GET(map, (int64_t)wide, ATOM_STRING) == 1);
+    BCPL_MAP_PUT(map, (int64_t)wide, ATOM_STRING, 2);
+    CHECK(BCPL_MAP_SIZE(map) == 1);
+    CHECK(BCPL_MAP_GET(map, (int64_t)compact, ATOM_STRING) == 2);
+    CHECK(BCPL_MAP_DEL(map, (int64_t)compact, ATOM_STRING) == 1);
+    CHECK(!BCPL_MAP_HAS(map, (int64_t)wide, ATOM_STRING));
+
+    // The integer 1 and the float 1.0 are different keys; 0.0 and -0.0
+    // are the same one.
+    BCPL_MAP_PUT(map, 1, ATOM_INT, 10);
+    BCPL_MAP_PUT(map, float_bits(1.0), ATOM_FLOAT, 20);
+    CHECK(BCPL_MAP_SIZE(map) == 2);
+    CHECK(BCPL_MAP_GET(map, 1, ATOM_INT) == 10);
+    CHECK(BCPL_MAP_GET(map, float_bits(1.0), ATOM_FLOAT) == 20);
+    CHECK(!BCPL_MAP_HAS(map, float_bits(1.0), ATOM_INT));
+    CHECK(!BCPL_MAP_HAS(map, 1, ATOM_FLOAT));
+    BCPL_MAP_PUT(map, float_bits(-0.0), ATOM_FLOAT, 30);
+    CHECK(BCPL_MAP_GET(map, float_bits(0.0), ATOM_FLOAT) == 30);
+    CHECK(BCPL_MAP_DEL(map, 1, ATOM_INT) == 1);
+    CHECK(BCPL_MAP_GET(map, float_bits(1.0), ATOM_FLOAT) == 20);
+    CHECK(BCPL_MAP_SIZE(map) == 2);
+
+    BCPL_MAP_FREE(map);
+    bcpl_free(compact);
+    bcpl_free(wide);
+}
+
+int main() {
+    random_ops();
+    growth();
+    wrapped_cluster();
+    key_identity();
+    return TEST_RESULT();
+}
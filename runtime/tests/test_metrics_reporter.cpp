@@ -0,0 +1,26 @@
+// test_metrics_reporter.cpp
+// print_runtime_metrics calls whatever reporter the runtime registered,
+// so the heap manager does not need to know about the list runtime.
+
+#include "heap_manager_defs.h"
+#include "test_support.h"
+
+static int g_reports = 0;
+
+static void count_report(void) {
+    g_reports++;
+}
+
+int main() {
+    print_runtime_metrics();
+    CHECK(g_reports == 0);
+
+    register_runtime_metrics_reporter(count_report);
+    print_runtime_metrics();
+    CHECK(g_reports == 1);
+
+    register_runtime_metrics_reporter(nullptr);
+    print_runtime_metrics();
+    CHECK(g_reports == 1);
+    return TEST_RESULT();
+}
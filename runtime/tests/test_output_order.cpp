@@ -0,0 +1,58 @@
+// test_output_order.cpp
+// WRITE* output goes through the runtime's own buffer while C callers use
+// stdio. Interleaved output from both paths must appear in call order, and
+// write_formatted output longer than its stack buffer arrives whole.
+
+#include "runtime.h"
+#include "test_support.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+
+namespace runtime {
+void write_formatted(const char* format, ...);
+}
+
+static uint32_t* make_string(const char* text) {
+    size_t n = std::strlen(text);
+    uint32_t* s = static_cast<uint32_t*>(bcpl_alloc_chars(n));
+    for (size_t i = 0; i < n; i++) s[i] = static_cast<unsigned char>(text[i]);
+    return s;
+}
+
+int main() {
+    char path[] = "/tmp/bcpl_output_order_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) return 1;
+    fflush(stdout);
+    int saved_stdout = dup(STDOUT_FILENO);
+    dup2(fd, STDOUT_FILENO);
+
+    printf("1 printf\n");
+    WRITES(make_string("2 WRITES\n"));
+    printf("3 printf\n");
+    WRITEN(4);
+    WRITEC('\n');
+    printf("5 printf\n");
+    bcpl_flush_output();
+    WRITES(make_string("6 WRITES\n"));
+    std::string long_line(3000, 'x');
+    runtime::write_formatted("7 %s\n", long_line.c_str());
+    bcpl_flush_output();
+
+    dup2(saved_stdout, STDOUT_FILENO);
+    close(saved_stdout);
+
+    char text[4096] = {0};
+    ssize_t got = pread(fd, text, sizeof(text) - 1, 0);
+    close(fd);
+    unlink(path);
+
+    CHECK(got > 0);
+    std::string expected = "1 printf\n2 WRITES\n3 printf\n4\n5 printf\n6 WRITES\n7 " + long_line + "\n";
+    CHECK(expected == text);
+    if (g_test_failures) fprintf(stderr, "output was:\n%s", text);
+    return TEST_RESULT();
+}
@@ -0,0 +1,101 @@
+// test_pass_timer.cpp
+// The --time-passes report from PassTimer: phases in the order they ran, a
+// repeated phase folded into one row, nothing recorded while disabled, and
+// allocation figures only in builds with BCPL_COUNT_ALLOCATIONS (built both
+// ways). The JSON form escapes pass names.
+
+#include "PassTimer.h"
+#include "test_support.h"
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static void allocate(int count) {
+    for (int i = 0; i < count; i++) {
+        std::unique_ptr<std::vector<int>> v(new std::vector<int>(1000));
+        (*v)[0] = i;
+    }
+}
+
+static bool contains(const std::string& text, const std::string& part) {
+    return text.find(part) != std::string::npos;
+}
+
+int main() {
+    PassTimer& timer = PassTimer::instance();
+#ifdef BCPL_COUNT_ALLOCATIONS
+    CHECK(PassTimer::counts_allocations());
+#else
+    CHECK(!PassTimer::counts_allocations());
+    CHECK(PassTimer::allocation_count() == 0);
+#endif
+
+    // Disabled: nothing is recorded.
+    {
+        auto timing = timer.time("Ignored");
+        allocate(5);
+    }
+    CHECK(timer.phases().empty());
+
+    timer.set_enabled(true);
+    {
+        auto timing = timer.time("Parse");
+        allocate(10);
+    }
+    for (int i = 0; i < 2; i++) {
+        auto timing = timer.time("Say \"hi\"");
+        allocate(3);
+    }
+    auto stopped = timer.time("Stopped");
+    stopped.stop();
+    allocate(4); // After stop(): not counted against the phase.
+    stopped.stop();
+
+    const std::vector<PassTimer::Phase>& phases = timer.phases();
+    CHECK(phases.size() == 3);
+    CHECK(phases[0].name == "Parse");
+    CHECK(phases[1].name == "Say \"hi\"");
+    CHECK(phases[2].name == "Stopped");
+    for (const PassTimer::Phase& phase : phases) {
+        CHECK(phase.wall_ms >= 0);
+        CHECK(phase.peak_rss_kb > 0);
+    }
+#ifdef BCPL_COUNT_ALLOCATIONS
+    // Two allocations per vector: the object and its elements.
+    CHECK(phases[0].allocations == 20);
+    CHECK(phases[0].allocated_bytes >= 10 * 1000 * sizeof(int));
+    CHECK(phases[1].allocations == 12); // Both runs
+    CHECK(phases[2].allocations == 0);
+#else
+    for (const PassTimer::Phase& phase : phases) CHECK(phase.allocations == 0);
+#endif
+
+    std::ostringstream report;
+    timer.print_report(report);
+    std::string text = report.str();
+    CHECK(contains(text, "Pass execution timing report"));
+    CHECK(text.find("  Parse\n") < text.find("  Say \"hi\"\n"));
+    CHECK(text.find("  Say \"hi\"\n") < text.find("  Stopped\n"));
+    CHECK(text.find("  Stopped\n") < text.find("  Total\n"));
+#ifdef BCPL_COUNT_ALLOCATIONS
+    CHECK(contains(text, "          20"));
+    CHECK(!contains(text, "           -"));
+#else
+    CHECK(contains(text, "           -             -"));
+#endif
+
+    std::ostringstream json;
+    timer.write_json(json);
+    text = json.str();
+    CHECK(contains(text, "{\"name\": \"Parse\""));
+    CHECK(contains(text, "{\"name\": \"Say \\\"hi\\\"\""));
+    CHECK(contains(text, "\"total\": {"));
+#ifdef BCPL_COUNT_ALLOCATIONS
+    CHECK(contains(text, "\"allocations\": 20, "));
+#else
+    CHECK(contains(text, "\"allocations\": null, \"allocated_bytes\": null"));
+    CHECK(!contains(text, "\"allocations\": 0"));
+#endif
+    return TEST_RESULT();
+}
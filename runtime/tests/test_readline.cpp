@@ -0,0 +1,132 @@
+// test_readline.cpp
+// FOPEN/READLINE/FCLOSE on files with lines longer than the read buffer,
+// "\r\n" endings (including one split across two reads) and no final
+// newline. Buffers passed back are reused when they have room, counted in
+// bytes so either string form fits in either kind of buffer; a too-small
+// buffer READLINE handed out is freed and replaced, a caller's is not.
+
+#include "heap_manager_defs.h"
+#include "runtime.h"
+#include "test_support.h"
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+
+static bool tracked(const void* payload) {
+    return heap_table_find(static_cast<const uint8_t*>(payload) - sizeof(uint64_t)) != nullptr;
+}
+
+static uint32_t* make_string(const char* text) {
+    int64_t n = (int64_t)std::strlen(text);
+    uint32_t* s = (uint32_t*)bcpl_alloc_chars(n);
+    for (int64_t i = 0; i < n; i++) s[i] = (uint32_t)(uint8_t)text[i];
+    return s;
+}
+
+// Writes the bytes to a temporary file and returns its name as a BCPL string.
+static uint32_t* write_file(char* path, const std::string& bytes) {
+    int fd = mkstemp(path);
+    if (fd < 0) return nullptr;
+    CHECK(write(fd, bytes.data(), bytes.size()) == (ssize_t)bytes.size());
+    close(fd);
+    return make_string(path);
+}
+
+static bool has_text(uint32_t* s, const std::u32string& expected) {
+    if (!s || STRLEN(s) != (int64_t)expected.size()) return false;
+    bool compact = bcpl_string_is_compact(s);
+    for (size_t i = 0; i < expected.size(); i++) {
+        uint32_t c = compact ? ((uint8_t*)s)[i] : s[i];
+        if (c != (uint32_t)expected[i]) return false;
+    }
+    return true;
+}
+
+int main() {
+    // The first line's "\r" is the last byte of the first 64 KB read and its
+    // "\n" the first byte of the next, so the buffer grows mid-line.
+    std::string first(65535, 'b');
+    std::string longest(200000, 'a');
+    std::string bytes = first + "\r\n" + "short\r\n" + longest + "\n" + "\n" +
+                        "caf\xC3\xA9\n" + "end";
+    char path[] = "/tmp/bcpl_readline_XXXXXX";
+    uint32_t* name = write_file(path, bytes);
+
+    int64_t reader = FOPEN(name);
+    CHECK(reader != 0);
+    uint32_t* line = READLINE(reader, nullptr);
+    CHECK(has_text(line, std::u32string(first.begin(), first.end())));
+    uint32_t* big = line;
+    line = READLINE(reader, line);
+    CHECK(line == big); // A short line reuses the larger buffer
+    CHECK(has_text(line, U"short"));
+    line = READLINE(reader, line);
+    CHECK(has_text(line, std::u32string(longest.begin(), longest.end())));
+    line = READLINE(reader, line);
+    CHECK(has_text(line, U""));
+    line = READLINE(reader, line);
+    CHECK(has_text(line, U"café"));
+    line = READLINE(reader, line);
+    CHECK(has_text(line, U"end")); // No final newline
+    CHECK(READLINE(reader, line) == nullptr);
+    CHECK(READLINE(reader, line) == nullptr);
+    FCLOSE(reader);
+    bcpl_free(line);
+    unlink(path);
+
+    // With compact strings, Latin-1 lines come back compact.
+    bcpl_set_compact_strings(1);
+    std::string mixed = std::string("0123456789\n") + "x\xE2\x98\x83y\n" + "ab\xE2\x98\x83" "d\n" +
+                        "a compact line longer than the thirty-two bytes\n" + "tail";
+    char mixed_path[] = "/tmp/bcpl_readline_XXXXXX";
+    uint32_t* mixed_name = write_file(mixed_path, mixed);
+    reader = FOPEN(mixed_name);
+    CHECK(reader != 0);
+
+    // A UTF-32 buffer with room for 3 characters holds 16 bytes: enough for
+    // 10 compact characters and the terminator.
+    uint32_t* wide_buffer = (uint32_t*)bcpl_alloc_chars(3);
+    line = READLINE(reader, wide_buffer);
+    CHECK(line == wide_buffer);
+    CHECK(bcpl_string_is_compact(line));
+    CHECK(has_text(line, U"0123456789"));
+
+    // A compact buffer with room for 15 characters holds 3 UTF-32 ones.
+    uint32_t* compact_buffer = (uint32_t*)bcpl_alloc_compact_chars(15);
+    line = READLINE(reader, compact_buffer);
+    CHECK(line == compact_buffer);
+    CHECK(!bcpl_string_is_compact(line));
+    CHECK(has_text(line, U"x☃y"));
+
+    // 4 UTF-32 characters do not fit in a caller's 8 bytes; the caller's
+    // buffer is left alone.
+    uint32_t* small_buffer = (uint32_t*)bcpl_alloc_chars(1);
+    line = READLINE(reader, small_buffer);
+    CHECK(line != small_buffer);
+    CHECK(tracked(small_buffer));
+    CHECK(has_text(line, U"ab☃d"));
+
+    // READLINE's own buffer is too small for the next line: it is freed and
+    // replaced.
+    uint32_t* replaced = line;
+    line = READLINE(reader, line);
+    CHECK(line != replaced);
+    CHECK(!tracked(replaced));
+    CHECK(tracked(line));
+    CHECK(has_text(line, U"a compact line longer than the thirty-two bytes"));
+    line = READLINE(reader, line);
+    CHECK(has_text(line, U"tail"));
+    CHECK(READLINE(reader, line) == nullptr);
+    FCLOSE(reader);
+    bcpl_set_compact_strings(0);
+    unlink(mixed_path);
+
+    bcpl_free(line);
+    bcpl_free(wide_buffer);
+    bcpl_free(compact_buffer);
+    bcpl_free(small_buffer);
+    bcpl_free(name);
+    bcpl_free(mixed_name);
+    return TEST_RESULT();
+}
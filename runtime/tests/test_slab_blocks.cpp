@@ -0,0 +1,55 @@
+// test_slab_blocks.cpp
+// Slab-backed block storage: a freed block is reused by the next request
+// of its class, blocks stay aligned, large blocks bypass the slabs, and a
+// thread's free lists are taken over by another thread once it exits
+// instead of leaking with it.
+
+#include "heap_manager_defs.h"
+#include "test_support.h"
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <vector>
+
+int main() {
+    // Every class, and sizes just past each class boundary.
+    const size_t sizes[] = {8, 32, 33, 48, 64, 65, 200, 384, 1000, 1024};
+    for (size_t size : sizes) {
+        void* block = heap_block_alloc(size);
+        CHECK(block != nullptr);
+        CHECK((uintptr_t)block % ALIGNMENT == 0);
+        heap_block_release(block, size);
+        CHECK(heap_block_alloc(size) == block);
+        heap_block_release(block, size);
+    }
+
+    size_t large_before = heap_large_alloc_count();
+    void* large = heap_block_alloc(4096);
+    CHECK(large != nullptr);
+    CHECK(heap_large_alloc_count() == large_before + 1);
+    heap_block_release(large, 4096);
+
+    // A worker allocates and frees one slab's worth of 768-byte blocks; the
+    // main thread has not used that class yet.
+    const size_t kSize = 768;
+    std::vector<void*> worker_blocks;
+    std::thread worker([&] {
+        for (int i = 0; i < 85; i++) worker_blocks.push_back(heap_block_alloc(kSize));
+        for (void* block : worker_blocks) heap_block_release(block, kSize);
+    });
+    worker.join();
+
+    // After the worker exits its blocks serve the main thread without a new slab.
+    size_t reserved = heap_slab_bytes_reserved();
+    std::set<void*> freed(worker_blocks.begin(), worker_blocks.end());
+    std::vector<void*> reused;
+    for (size_t i = 0; i < worker_blocks.size(); i++) {
+        void* block = heap_block_alloc(kSize);
+        CHECK(freed.count(block) == 1);
+        reused.push_back(block);
+    }
+    CHECK(heap_slab_bytes_reserved() == reserved);
+    for (void* block : reused) heap_block_release(block, kSize);
+
+    return TEST_RESULT();
+}
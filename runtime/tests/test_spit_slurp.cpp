@@ -0,0 +1,128 @@
+// test_spit_slurp.cpp
+// SPIT encodes a string to UTF-8 a chunk at a time; SLURP decodes it back.
+// Strings several chunks long, with one- to four-byte characters landing on
+// every chunk boundary, must round-trip exactly in both string forms.
+
+#include "runtime.h"
+#include "test_support.h"
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+static uint32_t* make_string(const char* text) {
+    int64_t n = (int64_t)std::strlen(text);
+    uint32_t* s = (uint32_t*)bcpl_alloc_chars(n);
+    for (int64_t i = 0; i < n; i++) s[i] = (uint32_t)(uint8_t)text[i];
+    return s;
+}
+
+static void append_utf8(std::string& out, uint32_t c) {
+    if (c < 0x80) {
+        out += (char)c;
+    } else if (c < 0x800) {
+        out += (char)(0xC0 | (c >> 6));
+        out += (char)(0x80 | (c & 0x3F));
+    } else if (c < 0x10000) {
+        out += (char)(0xE0 | (c >> 12));
+        out += (char)(0x80 | ((c >> 6) & 0x3F));
+        out += (char)(0x80 | (c & 0x3F));
+    } else {
+        out += (char)(0xF0 | (c >> 18));
+        out += (char)(0x80 | ((c >> 12) & 0x3F));
+        out += (char)(0x80 | ((c >> 6) & 0x3F));
+        out += (char)(0x80 | (c & 0x3F));
+    }
+}
+
+// Adds a character to both the expected characters and their UTF-8.
+static void push(std::vector<uint32_t>& chars, std::string& utf8, uint32_t c) {
+    chars.push_back(c);
+    append_utf8(utf8, c);
+}
+
+static std::string read_file(const char* path) {
+    std::string bytes;
+    FILE* f = std::fopen(path, "rb");
+    if (!f) return bytes;
+    char buf[4096];
+    size_t n;
+    while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0) bytes.append(buf, n);
+    std::fclose(f);
+    return bytes;
+}
+
+static bool same_chars(uint32_t* s, const std::vector<uint32_t>& expected) {
+    if (!s || STRLEN(s) != (int64_t)expected.size()) return false;
+    bool compact = bcpl_string_is_compact(s);
+    for (size_t i = 0; i < expected.size(); i++) {
+        uint32_t c = compact ? ((uint8_t*)s)[i] : s[i];
+        if (c != expected[i]) return false;
+    }
+    return true;
+}
+
+int main() {
+    char path[] = "/tmp/bcpl_spit_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) return 1;
+    close(fd);
+    uint32_t* name = make_string(path);
+
+    // About 300 KB of UTF-8. ASCII runs of varying length put each width of
+    // character at every offset within a 64 KB chunk.
+    const uint32_t wide[] = {0xE9, 0x2603, 0x1F600};
+    std::vector<uint32_t> chars;
+    std::string utf8;
+    for (uint32_t i = 0; utf8.size() < 300000; i++) {
+        for (uint32_t j = 0; j < i % 7; j++) push(chars, utf8, 'a' + j);
+        push(chars, utf8, wide[i % 3]);
+    }
+    uint32_t* text = (uint32_t*)bcpl_alloc_chars((int64_t)chars.size());
+    for (size_t i = 0; i < chars.size(); i++) text[i] = chars[i];
+
+    SPIT(text, name);
+    CHECK(read_file(path) == utf8);
+    uint32_t* back = SLURP(name);
+    CHECK(!bcpl_string_is_compact(back));
+    CHECK(same_chars(back, chars));
+    bcpl_free(back);
+
+    // A compact Latin-1 string of about 200 KB of UTF-8.
+    std::vector<uint32_t> latin1;
+    std::string latin1_utf8;
+    for (uint32_t i = 0; latin1_utf8.size() < 200000; i++) {
+        for (uint32_t j = 0; j < i % 5; j++) push(latin1, latin1_utf8, 'a' + j);
+        push(latin1, latin1_utf8, 0x80 + i % 0x80);
+    }
+    uint8_t* compact = (uint8_t*)bcpl_alloc_compact_chars((int64_t)latin1.size());
+    for (size_t i = 0; i < latin1.size(); i++) compact[i] = (uint8_t)latin1[i];
+
+    SPIT((uint32_t*)compact, name);
+    CHECK(read_file(path) == latin1_utf8);
+    back = SLURP(name);
+    CHECK(same_chars(back, latin1));
+    bcpl_free(back);
+    bcpl_set_compact_strings(1);
+    back = SLURP(name);
+    CHECK(bcpl_string_is_compact(back));
+    CHECK(same_chars(back, latin1));
+    bcpl_free(back);
+    bcpl_set_compact_strings(0);
+
+    // The empty string writes an empty file.
+    uint32_t* empty = make_string("");
+    SPIT(empty, name);
+    CHECK(read_file(path).empty());
+    back = SLURP(name);
+    CHECK(same_chars(back, {}));
+    bcpl_free(back);
+
+    unlink(path);
+    bcpl_free(text);
+    bcpl_free(compact);
+    bcpl_free(empty);
+    bcpl_free(name);
+    return TEST_RESULT();
+}
@@ -0,0 +1,71 @@
+// test_split_free.cpp
+// SPLIT lays its tokens out as records in one block owned by the list.
+// Every record must start on an 8-byte boundary, whatever the token
+// lengths, and freeing the list must release the block without freeing the
+// records one by one.
+
+#include "ListDataTypes.h"
+#include "heap_interface.h"
+#include "runtime.h"
+#include "test_support.h"
+#include <cstdint>
+#include <cstring>
+
+extern "C" void bcpl_free_list(ListHeader* header);
+
+static uint32_t* make_string(const char* text) {
+    int64_t n = (int64_t)std::strlen(text);
+    uint32_t* s = (uint32_t*)bcpl_alloc_chars(n);
+    for (int64_t i = 0; i < n; i++) s[i] = (uint32_t)text[i];
+    return s;
+}
+
+static uint8_t* make_compact_string(const char* text) {
+    int64_t n = (int64_t)std::strlen(text);
+    uint8_t* s = (uint8_t*)bcpl_alloc_compact_chars(n);
+    std::memcpy(s, text, (size_t)n);
+    return s;
+}
+
+// Checks each record's alignment and contents against the tokens of text.
+static void check_records(ListHeader* list, const char* text, char delimiter, bool compact) {
+    const char* token = text;
+    for (ListAtom* atom = list->head; atom; atom = atom->next) {
+        const char* end = std::strchr(token, delimiter);
+        size_t length = end ? (size_t)(end - token) : std::strlen(token);
+        CHECK(atom->type == ATOM_STRING);
+        CHECK((uintptr_t)atom->value.ptr_value % 8 == 0);
+        uint32_t* chars = (uint32_t*)((uint64_t*)atom->value.ptr_value + 1);
+        CHECK(bcpl_string_is_compact(chars) == (compact ? 1 : 0));
+        CHECK(STRLEN(chars) == (int64_t)length);
+        for (size_t i = 0; i < length; i++) {
+            uint32_t c = compact ? ((uint8_t*)chars)[i] : chars[i];
+            CHECK(c == (uint32_t)(uint8_t)token[i]);
+        }
+        token = end ? end + 1 : token + length;
+    }
+}
+
+int main() {
+    // Token lengths 0 to 9 cover every padding remainder in both forms.
+    const char* text = ",a,bb,ccc,dddd,eeeee,ffffff,ggggggg,hhhhhhhh,iiiiiiiii";
+    uint32_t* comma = make_string(",");
+
+    uint32_t* source = make_string(text);
+    ListHeader* tokens = BCPL_SPLIT_STRING(source, comma);
+    CHECK(tokens->length == 10);
+    CHECK(tokens->strings != nullptr);
+    check_records(tokens, text, ',', false);
+    bcpl_free_list(tokens);
+
+    uint8_t* compact_source = make_compact_string(text);
+    ListHeader* compact_tokens = BCPL_SPLIT_STRING((uint32_t*)compact_source, comma);
+    CHECK(compact_tokens->length == 10);
+    check_records(compact_tokens, text, ',', true);
+    bcpl_free_list(compact_tokens);
+
+    bcpl_free(source);
+    bcpl_free(compact_source);
+    bcpl_free(comma);
+    return TEST_RESULT();
+}
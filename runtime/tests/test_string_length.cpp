@@ -0,0 +1,51 @@
+// test_string_length.cpp
+// STRLEN and STRCMP only read the length word in front of a string when the
+// runtime wrote it. A pointer into a vector has whatever the program stored
+// in the element before it, and must be measured by scanning.
+
+#include "runtime.h"
+#include "test_support.h"
+#include <cstdint>
+
+static uint32_t* make_string(const char* text) {
+    int64_t n = 0;
+    while (text[n]) n++;
+    uint32_t* s = (uint32_t*)bcpl_alloc_chars(n);
+    for (int64_t i = 0; i < n; i++) s[i] = (uint32_t)text[i];
+    return s;
+}
+
+int main() {
+    // "hi" in a vector, after an element that looks like a huge length.
+    uint64_t* v = (uint64_t*)bcpl_alloc_words(4, "main", "v");
+    v[0] = 3000000000u;
+    v[1] = 'h' | ((uint64_t)'i' << 32);
+    v[2] = 0;
+    uint32_t* inner = (uint32_t*)(v + 1);
+    CHECK(STRLEN(inner) == 2);
+
+    uint32_t* hi = make_string("hi");
+    CHECK(STRLEN(hi) == 2);
+    CHECK(STRCMP(inner, hi) == 0);
+    CHECK(STRCMP(hi, inner) == 0);
+
+    // Negative numbers and plain small values are not lengths either.
+    v[0] = (uint64_t)-1;
+    CHECK(STRLEN(inner) == 2);
+    v[0] = 1;
+    CHECK(STRLEN(inner) == 2);
+
+    // A runtime string's own length is used, and STRCOPY of a shorter
+    // string into it still gives the new length.
+    uint32_t* hello = make_string("hello");
+    CHECK(STRLEN(hello) == 5);
+    CHECK(STRCMP(hello, inner) < 0);
+    STRCOPY(hello, inner);
+    CHECK(STRLEN(hello) == 2);
+    CHECK(STRCMP(hello, hi) == 0);
+
+    bcpl_free(v);
+    bcpl_free(hi);
+    bcpl_free(hello);
+    return TEST_RESULT();
+}
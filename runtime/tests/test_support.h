@@ -0,0 +1,22 @@
+// test_support.h
+// Minimal check helpers shared by the runtime regression tests.
+
+#ifndef BCPL_RUNTIME_TEST_SUPPORT_H
+#define BCPL_RUNTIME_TEST_SUPPORT_H
+
+#include <cstdio>
+
+static int g_test_failures = 0;
+
+// Records a failure without stopping, so one run reports every broken check.
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            g_test_failures++; \
+        } \
+    } while (0)
+
+#define TEST_RESULT() (g_test_failures == 0 ? 0 : 1)
+
+#endif // BCPL_RUNTIME_TEST_SUPPORT_H
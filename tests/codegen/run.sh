@@ -0,0 +1,35 @@
+#!/bin/bash
+
+# Code generation regression tests. Each tests/codegen/<name>.bcl is run
+# with the JIT and the last lines of its output are compared with
+# <name>.expected. Compiler options for a test go in <name>.flags.
+# Needs an ARM64 build of the compiler (./build.sh).
+# Usage: tests/codegen/run.sh [path/to/NewBCPL]
+
+cd "$(dirname "$0")"
+
+COMPILER="${1:-../../build/bin/NewBCPL}"
+if [ ! -x "${COMPILER}" ]; then
+    echo "Compiler not found at ${COMPILER}; build it with ./build.sh first." >&2
+    exit 2
+fi
+
+failures=0
+for source in *.bcl; do
+    name="${source%.bcl}"
+    expected_lines=$(wc -l < "${name}.expected")
+    flags=""
+    if [ -f "${name}.flags" ]; then
+        flags=$(cat "${name}.flags")
+    fi
+    actual=$("${COMPILER}" ${flags} --run "${source}" 2>&1 | tail -n "${expected_lines}")
+    if [ "${actual}" == "$(cat "${name}.expected")" ]; then
+        echo "PASS ${name}"
+    else
+        echo "FAIL ${name}"
+        diff <(echo "${actual}") "${name}.expected"
+        failures=$((failures + 1))
+    fi
+done
+
+exit $(( failures > 0 ))